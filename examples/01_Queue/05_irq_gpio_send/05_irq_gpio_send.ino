@@ -34,6 +34,9 @@ void setup()
   // en: Pull-up the button input and trigger ISR on falling edge
   // ja: ボタン入力をプルアップし、FALLING で割り込み送信
   pinMode(BUTTON_PIN, INPUT_PULLUP);
+  // en: The queue is created on first use, which an ISR cannot do: create it before attaching
+  // ja: キューは初回使用時に生成されるが ISR では生成できないため、割り込み登録の前に生成する
+  q.begin();
   attachInterrupt(digitalPinToInterrupt(BUTTON_PIN), onButton, FALLING);
 }
 
@@ -3,6 +3,8 @@
 
 // en: Mailbox-style queue (depth=1) using overwrite to keep the latest value only
 // ja: 深さ1のキューを overwrite で最新値だけ保持するメールボックス例
+// en: For shared "latest state" read by several tasks without consuming it, see examples/11_Latest (Latest<T>)
+// ja: 複数タスクが消費せずに読む「最新状態」には examples/11_Latest（Latest<T>）を参照
 
 ESP32SyncKit::Queue<int> mailbox(1); // depth 1 -> mailbox semantics
 ESP32TaskKit::Task producer;
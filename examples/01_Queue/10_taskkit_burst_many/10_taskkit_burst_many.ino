@@ -0,0 +1,66 @@
+#include <ESP32TaskKit.h>
+#include <ESP32SyncKit.h>
+
+// en: Burst transfer with sendMany/receiveMany: the consumer wakes once per burst instead of once per sample
+// ja: sendMany/receiveMany によるバースト転送。受信側はサンプルごとではなくバーストごとに1回だけ起床する
+
+constexpr uint32_t kBurst = 16;
+constexpr uint32_t kQueueDepth = 64;
+
+ESP32SyncKit::Queue<int16_t> q(kQueueDepth);
+ESP32TaskKit::Task producer;
+ESP32TaskKit::Task consumer;
+
+void setup()
+{
+  Serial.begin(115200);
+
+  // en: Producer (priority 2): pushes a burst of 16 samples every 100 ms
+  // ja: 送信タスク（優先度2）: 100 ms ごとに16サンプルをまとめて送信
+  producer.startLoop(
+      []
+      {
+        static int16_t base = 0;
+        int16_t samples[kBurst];
+        for (uint32_t i = 0; i < kBurst; ++i)
+        {
+          samples[i] = base++;
+        }
+        // en: Blocks until the first sample fits, then sends the rest non-blocking; returns how many went in
+        // ja: 最初の1件が入るまでブロックし、残りはノンブロック送信。送れた件数を返す
+        uint32_t sent = q.sendMany(samples, kBurst, 1000);
+        if (sent < kBurst)
+        {
+          Serial.printf("[Queue/many] only %lu of %lu sent\n",
+                        static_cast<unsigned long>(sent),
+                        static_cast<unsigned long>(kBurst));
+        }
+        return true;
+      },
+      ESP32TaskKit::TaskConfig{.name = "burst-producer", .priority = 2},
+      100);
+
+  // en: Consumer (priority 2): blocks for the first sample, then drains whatever is queued in one call
+  // ja: 受信タスク（優先度2）: 最初の1件までブロックし、溜まっている分を1回の呼び出しで取り出す
+  consumer.startLoop(
+      []
+      {
+        int16_t buf[32];
+        uint32_t n = q.receiveMany(buf, 32);
+        if (n > 0)
+        {
+          Serial.printf("[Queue/many] core=%d, got %lu samples (%d..%d)\n",
+                        xPortGetCoreID(),
+                        static_cast<unsigned long>(n),
+                        buf[0],
+                        buf[n - 1]);
+        }
+        return true;
+      },
+      ESP32TaskKit::TaskConfig{.name = "burst-consumer", .priority = 2});
+}
+
+void loop()
+{
+  delay(1);
+}
@@ -0,0 +1,68 @@
+#include <ESP32TaskKit.h>
+#include <ESP32SyncKit.h>
+#include <memory>
+#include <string>
+
+// en: ObjectQueue passes move-only / non-trivial types (std::unique_ptr, std::string) with real move semantics
+// ja: ObjectQueue でムーブ専用/非トリビアルな型（std::unique_ptr、std::string）を本物のムーブで受け渡す例
+
+struct Command
+{
+  std::string name;
+  std::unique_ptr<int[]> args;
+  size_t argc;
+};
+
+// en: Queue<Command> would not compile (Command is not trivially copyable); ObjectQueue moves it instead
+// ja: Queue<Command> はコンパイルエラー（トリビアルコピー不可）。ObjectQueue ならムーブで運べる
+ESP32SyncKit::ObjectQueue<Command> commands(4);
+ESP32TaskKit::Task producer;
+ESP32TaskKit::Task consumer;
+
+void setup()
+{
+  Serial.begin(115200);
+
+  // en: Producer (priority 2): builds a command every 300 ms and moves it into the queue
+  // ja: 送信タスク（優先度2）: 300 ms ごとにコマンドを作り、キューへムーブ
+  producer.startLoop(
+      []
+      {
+        static uint32_t seq = 0;
+        Command cmd;
+        cmd.name = "set-led-" + std::to_string(seq++);
+        cmd.argc = 3;
+        cmd.args.reset(new int[cmd.argc]{1, 2, 3});
+        if (!commands.send(std::move(cmd), 1000))
+        {
+          Serial.println("[ObjectQueue] send failed");
+        }
+
+        // en: emplace constructs directly inside the queue slot (no temporary)
+        // ja: emplace はキューのスロット内で直接構築する（一時オブジェクトなし）
+        (void)commands.tryEmplace(Command{"ping", nullptr, 0});
+        return true;
+      },
+      ESP32TaskKit::TaskConfig{.name = "cmd-producer", .priority = 2},
+      300);
+
+  // en: Consumer (priority 2): receives by move; the unique_ptr ownership comes along
+  // ja: 受信タスク（優先度2）: ムーブで受信し、unique_ptr の所有権も一緒に移る
+  consumer.startLoop(
+      []
+      {
+        Command cmd;
+        if (commands.receive(cmd))
+        {
+          Serial.printf("[ObjectQueue] core=%d, %s argc=%u\n",
+                        xPortGetCoreID(), cmd.name.c_str(), static_cast<unsigned>(cmd.argc));
+        }
+        return true;
+      },
+      ESP32TaskKit::TaskConfig{.name = "cmd-consumer", .priority = 2});
+}
+
+void loop()
+{
+  delay(1);
+}
@@ -0,0 +1,61 @@
+#include <ESP32TaskKit.h>
+#include <ESP32SyncKit.h>
+
+// en: Opt-in statistics: Queue<T, WithStats> counts sends/receives/timeouts and tracks peak depth and blocked time
+// ja: オプトインの統計: Queue<T, WithStats> は送受信/タイムアウト回数、最大滞留数、ブロック時間を記録する
+
+constexpr uint32_t kQueueDepth = 8;
+
+ESP32SyncKit::Queue<int, ESP32SyncKit::WithStats> q(kQueueDepth);
+ESP32TaskKit::Task producer;
+ESP32TaskKit::Task consumer;
+
+void setup()
+{
+  Serial.begin(115200);
+
+  // en: Producer (priority 2): bursts of 5 items every 100 ms
+  // ja: 送信タスク（優先度2）: 100 ms ごとに5件まとめて送信
+  producer.startLoop(
+      []
+      {
+        static int value = 0;
+        for (int i = 0; i < 5; ++i)
+        {
+          q.send(value++, 10);
+        }
+        return true;
+      },
+      ESP32TaskKit::TaskConfig{.name = "stats-producer", .priority = 2},
+      100);
+
+  // en: Slow consumer (priority 2): one item every 30 ms, so the queue fills up and sends start timing out
+  // ja: 遅い受信タスク（優先度2）: 30 ms ごとに1件だけ取り出すため、キューが埋まり送信がタイムアウトし始める
+  consumer.startLoop(
+      []
+      {
+        int v = 0;
+        q.receive(v, 50);
+        return true;
+      },
+      ESP32TaskKit::TaskConfig{.name = "stats-consumer", .priority = 2},
+      30);
+}
+
+void loop()
+{
+  // en: Print and reset the snapshot every 2 s
+  // ja: 2 秒ごとにスナップショットを表示してリセット
+  ESP32SyncKit::StatsSnapshot s = q.stats();
+  q.resetStats();
+  Serial.printf("[Queue/stats] sends=%lu receives=%lu failures=%lu timeouts=%lu peak=%lu/%lu blocked total=%llu us max=%lu us\n",
+                static_cast<unsigned long>(s.sends),
+                static_cast<unsigned long>(s.receives),
+                static_cast<unsigned long>(s.failures),
+                static_cast<unsigned long>(s.timeouts),
+                static_cast<unsigned long>(s.peakCount),
+                static_cast<unsigned long>(kQueueDepth),
+                static_cast<unsigned long long>(s.blockedUsTotal),
+                static_cast<unsigned long>(s.blockedUsMax));
+  delay(2000);
+}
@@ -0,0 +1,61 @@
+#include <ESP32SyncKit.h>
+
+// en: Diagnostics policy: poll receive(out, 1) without flooding the UART. Timeouts are counted (WithStats)
+// en: instead of printed, other warnings are rate-limited, and ISR failures are deferred and flushed from loop().
+// ja: 診断ポリシー: receive(out, 1) でポーリングしても UART をあふれさせない。タイムアウトは出力せず
+// ja: WithStats で数え、その他の警告はレート制限し、ISR での失敗は退避して loop() から出力する
+
+#ifndef BUTTON_PIN
+#define BUTTON_PIN 0 // en: change for your board / ja: ボードに合わせて変更
+#endif
+
+// en: Small depth so fast button presses overflow it from the ISR
+// ja: ボタン連打で ISR 側があふれるよう深さを小さくする
+constexpr uint32_t kQueueDepth = 2;
+constexpr uint32_t kReportIntervalMs = 5000;
+
+ESP32SyncKit::Queue<int, ESP32SyncKit::WithStats, ESP32SyncKit::LogRateLimited<2000>> q(kQueueDepth);
+
+void IRAM_ATTR onButton()
+{
+  static int counter = 0;
+  // en: A failure here is queued to the deferred ring, not printed from the ISR
+  // ja: ここでの失敗は ISR から出力されず、退避リングに積まれる
+  (void)q.trySend(counter++);
+}
+
+void setup()
+{
+  Serial.begin(115200);
+
+  pinMode(BUTTON_PIN, INPUT_PULLUP);
+  q.begin(); // en: create before the ISR can use it / ja: ISR が使う前に生成
+  attachInterrupt(digitalPinToInterrupt(BUTTON_PIN), onButton, FALLING);
+}
+
+void loop()
+{
+  static uint32_t lastReportMs = 0;
+
+  int v = 0;
+  // en: 1 ms polling: an empty queue is a normal timeout and prints nothing
+  // ja: 1 ms ポーリング: 空のキューは通常のタイムアウトで、何も出力しない
+  if (q.receive(v, 1))
+  {
+    Serial.printf("[Queue/loop] got %d\n", v);
+  }
+
+  // en: Print ISR messages deferred since the last call
+  // ja: 前回以降に退避された ISR メッセージを出力
+  ESP32SyncKit::flushDeferredLogs();
+
+  if (millis() - lastReportMs >= kReportIntervalMs)
+  {
+    lastReportMs = millis();
+    ESP32SyncKit::StatsSnapshot s = q.stats();
+    Serial.printf("[Queue/stats] receives=%lu timeouts=%lu ISR failures=%lu\n",
+                  static_cast<unsigned long>(s.receives),
+                  static_cast<unsigned long>(s.timeouts),
+                  static_cast<unsigned long>(s.failures));
+  }
+}
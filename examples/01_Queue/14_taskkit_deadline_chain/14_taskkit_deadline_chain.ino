@@ -0,0 +1,84 @@
+#include <ESP32TaskKit.h>
+#include <ESP32SyncKit.h>
+
+// en: Deadline / std::chrono: one 20 ms budget flows through lock -> send -> receive without manual bookkeeping
+// ja: Deadline / std::chrono: 20 ms の予算1つを lock → send → receive に通し、残り時間を手で計算しない
+
+using namespace std::chrono_literals;
+
+struct Request
+{
+  uint32_t id;
+};
+
+struct Reply
+{
+  uint32_t id;
+  uint32_t value;
+};
+
+ESP32SyncKit::Mutex bus;
+ESP32SyncKit::Queue<Request> requests(4);
+ESP32SyncKit::Queue<Reply> replies(4);
+ESP32TaskKit::Task server;
+ESP32TaskKit::Task client;
+
+void setup()
+{
+  Serial.begin(115200);
+
+  // en: Server (priority 2): answers each request after a variable delay (0-24 ms)
+  // ja: サーバ（優先度2）: 各リクエストに 0〜24 ms の可変遅延の後で応答する
+  server.startLoop(
+      []
+      {
+        Request req{};
+        if (requests.receive(req, 1s)) // en: std::chrono duration instead of milliseconds / ja: ミリ秒の代わりに std::chrono の時間
+        {
+          delay(req.id % 25);
+          replies.send(Reply{req.id, req.id * 10}, 10ms);
+        }
+        return true;
+      },
+      ESP32TaskKit::TaskConfig{.name = "server", .priority = 2},
+      0);
+
+  // en: Client (priority 2): the whole transaction must finish within 20 ms
+  // ja: クライアント（優先度2）: トランザクション全体を 20 ms 以内に終える
+  client.startLoop(
+      []
+      {
+        static uint32_t id = 0;
+        const ESP32SyncKit::Deadline deadline(20ms); // en: absolute: every call below waits only for what is left / ja: 絶対期限: 以下の各呼び出しは残り時間だけ待つ
+
+        ESP32SyncKit::Mutex::LockGuard guard(bus, deadline);
+        if (!guard.locked() || !requests.send(Request{++id}, deadline))
+        {
+          Serial.println("[Deadline] could not start the transaction");
+          return true;
+        }
+
+        Reply rep{};
+        if (replies.receive(rep, deadline) && rep.id == id)
+        {
+          Serial.printf("[Deadline] id=%lu value=%lu, %lld us left\n", static_cast<unsigned long>(rep.id),
+                        static_cast<unsigned long>(rep.value), static_cast<long long>(deadline.remainingUs()));
+        }
+        else
+        {
+          Serial.printf("[Deadline] id=%lu missed the 20 ms budget\n", static_cast<unsigned long>(id));
+          Reply late{};
+          while (replies.tryReceive(late)) // en: drop late replies so the next round starts clean / ja: 次の周回のため遅れた応答を捨てる
+          {
+          }
+        }
+        return true;
+      },
+      ESP32TaskKit::TaskConfig{.name = "client", .priority = 2},
+      100);
+}
+
+void loop()
+{
+  delay(1000);
+}
@@ -0,0 +1,65 @@
+#include <ESP32TaskKit.h>
+#include <ESP32SyncKit.h>
+
+// en: Coalesced receive: the consumer sleeps until kMinItems are queued or kMaxLatencyMs has passed since
+// en: the first item, instead of waking for every item. batches/batchItems/batchMax in stats show the result.
+// ja: まとめ受信: 消費タスクは1件ごとに起きず、kMinItems 件溜まるか最初の1件から kMaxLatencyMs 経過するまで眠る。
+// ja: 統計の batches/batchItems/batchMax で結果を確認できる
+
+constexpr uint32_t kQueueDepth = 32;
+constexpr uint32_t kMaxBatch = 16;
+constexpr uint32_t kMinItems = 8;
+constexpr uint32_t kMaxLatencyMs = 20;
+
+// en: receiveBatch() needs the WithBatch policy; the consumer sleeps on notification slot 0 (reserved on that task)
+// ja: receiveBatch() には WithBatch ポリシーが必要。受信タスクは通知スロット0で眠る（そのタスクでは専有）
+ESP32SyncKit::Queue<uint32_t, ESP32SyncKit::WithStats, ESP32SyncKit::LogAll, ESP32SyncKit::WithBatch<>> samples(kQueueDepth);
+ESP32TaskKit::Task producer;
+ESP32TaskKit::Task consumer;
+
+void setup()
+{
+  Serial.begin(115200);
+
+  // en: Producer (priority 2): one sample per ms
+  // ja: 送信タスク（優先度2）: 1 ms ごとに1件
+  producer.startLoop(
+      []
+      {
+        static uint32_t value = 0;
+        samples.send(value++, 10);
+        return true;
+      },
+      ESP32TaskKit::TaskConfig{.name = "batch-producer", .priority = 2},
+      1);
+
+  // en: Consumer (priority 3): wakes about once per kMinItems samples; kMaxLatencyMs caps the delay when traffic is slow
+  // ja: 受信タスク（優先度3）: 約 kMinItems 件ごとに1回起きる。流量が少ないときの遅延は kMaxLatencyMs が上限
+  consumer.startLoop(
+      []
+      {
+        uint32_t batch[kMaxBatch];
+        const uint32_t n = samples.receiveBatch(batch, kMaxBatch, kMinItems, kMaxLatencyMs, 1000);
+        if (n == 0)
+        {
+          Serial.println("[Queue/batch] no samples for 1 s");
+        }
+        return true;
+      },
+      ESP32TaskKit::TaskConfig{.name = "batch-consumer", .priority = 3},
+      0);
+}
+
+void loop()
+{
+  // en: Average batch = batchItems / batches; raise kMinItems for throughput, lower kMaxLatencyMs for latency
+  // ja: 平均バッチ = batchItems / batches。スループット重視なら kMinItems を上げ、遅延重視なら kMaxLatencyMs を下げる
+  ESP32SyncKit::StatsSnapshot s = samples.stats();
+  samples.resetStats();
+  Serial.printf("[Queue/batch] items=%lu batches=%lu avg=%.1f max=%lu\n",
+                static_cast<unsigned long>(s.batchItems),
+                static_cast<unsigned long>(s.batches),
+                s.batches ? static_cast<double>(s.batchItems) / s.batches : 0.0,
+                static_cast<unsigned long>(s.batchMax));
+  delay(2000);
+}
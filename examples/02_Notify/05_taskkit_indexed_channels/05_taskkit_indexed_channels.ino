@@ -0,0 +1,85 @@
+#include <ESP32TaskKit.h>
+#include <ESP32SyncKit.h>
+
+// en: Two independent notification channels on the loop task: slot 0 counts ticks, slot 1 carries event bits.
+// en: Needs CONFIG_FREERTOS_TASK_NOTIFICATION_ARRAY_ENTRIES >= 2 (the stock Arduino core uses 1).
+// ja: loop タスク上の独立した2つの通知チャネル: スロット0でティックを数え、スロット1でイベントビットを受ける。
+// ja: CONFIG_FREERTOS_TASK_NOTIFICATION_ARRAY_ENTRIES >= 2 が必要（標準の Arduino コアは 1）
+
+#if configTASK_NOTIFICATION_ARRAY_ENTRIES >= 2
+
+constexpr uint32_t kEventRx = 1u << 0;
+constexpr uint32_t kEventTx = 1u << 1;
+
+ESP32SyncKit::Notify ticks;                 // en: slot 0, counter mode / ja: スロット0、カウンタモード
+ESP32SyncKit::IndexedNotify<1> events;      // en: slot 1, bits mode / ja: スロット1、ビットモード
+ESP32TaskKit::Task ticker;
+ESP32TaskKit::Task radio;
+
+void setup()
+{
+  Serial.begin(115200);
+
+  // en: setup() runs on the loop task, so bind both channels to it before the producers start
+  // ja: setup() は loop タスク上で動くため、送信タスク開始前に両チャネルをバインドしておく
+  ticks.bindToSelf();
+  events.bindToSelf();
+
+  // en: Ticker (priority 2): one counter notification every 100 ms
+  // ja: ティッカー（優先度2）: 100 ms ごとにカウンタ通知を1件
+  ticker.startLoop(
+      []
+      {
+        ticks.notify();
+        return true;
+      },
+      ESP32TaskKit::TaskConfig{.name = "ticker", .priority = 2},
+      100);
+
+  // en: Radio (priority 2): alternates RX / TX event bits every 700 ms without touching slot 0
+  // ja: 無線（優先度2）: 700 ms ごとに RX / TX ビットを交互にセット。スロット0には触れない
+  radio.startLoop(
+      []
+      {
+        static bool rx = true;
+        events.setBits(rx ? kEventRx : kEventTx);
+        rx = !rx;
+        return true;
+      },
+      ESP32TaskKit::TaskConfig{.name = "radio", .priority = 2},
+      700);
+}
+
+void loop()
+{
+  // en: Block on slot 0 for up to 500 ms, then poll slot 1; neither channel consumes the other's notifications
+  // ja: スロット0で最大 500 ms 待ち、その後スロット1をポーリング。互いの通知を消費しない
+  uint32_t got = ticks.takeAll(500);
+  if (got > 0)
+  {
+    Serial.printf("[Notify/indexed] slot0 ticks=%lu\n", static_cast<unsigned long>(got));
+  }
+  if (events.tryWaitBits(kEventRx))
+  {
+    Serial.println("[Notify/indexed] slot1 RX");
+  }
+  if (events.tryWaitBits(kEventTx))
+  {
+    Serial.println("[Notify/indexed] slot1 TX");
+  }
+}
+
+#else
+
+void setup()
+{
+  Serial.begin(115200);
+}
+
+void loop()
+{
+  Serial.println("[Notify/indexed] rebuild with CONFIG_FREERTOS_TASK_NOTIFICATION_ARRAY_ENTRIES >= 2");
+  delay(5000);
+}
+
+#endif
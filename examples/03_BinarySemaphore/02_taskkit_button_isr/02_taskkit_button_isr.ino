@@ -24,6 +24,7 @@ void setup()
 {
   Serial.begin(115200);
   pinMode(kButtonPin, INPUT_PULLUP);
+  buttonSem.begin(); // en: create before the ISR can give / ja: ISR が give する前に生成
   attachInterrupt(digitalPinToInterrupt(kButtonPin), onButton, FALLING);
 
   // en: TaskKit handler (priority 2), default 1 ms tick to poll semaphore
@@ -0,0 +1,57 @@
+#include <ESP32TaskKit.h>
+#include <ESP32SyncKit.h>
+
+// en: Find who holds a shared bus too long: BasicMutex<WithProfile> records wait/hold histograms,
+// en: the longest hold with its task name, contention and priority-inheritance events
+// ja: 共有バスを長く握っているタスクを特定する: BasicMutex<WithProfile> は待ち/保持ヒストグラム、
+// ja: 最長保持とそのタスク名、競合回数、優先度継承の発生回数を記録する
+ESP32SyncKit::BasicMutex<ESP32SyncKit::WithProfile> busMutex;
+ESP32TaskKit::Task sensorTask;
+ESP32TaskKit::Task loggerTask;
+constexpr uint32_t kSensorIntervalMs = 20;
+constexpr uint32_t kLoggerIntervalMs = 200;
+constexpr uint32_t kReportIntervalMs = 5000;
+
+void setup()
+{
+  Serial.begin(115200);
+
+  // en: High-priority sensor task (priority 3): short 1 ms transactions every 20 ms
+  // ja: 高優先度センサタスク（優先度3）: 20 ms ごとに 1 ms の短いトランザクション
+  sensorTask.startLoop(
+      []
+      {
+        ESP32SyncKit::BasicMutex<ESP32SyncKit::WithProfile>::LockGuard guard(busMutex, 100);
+        if (guard.locked())
+        {
+          delay(1); // en: simulated bus transfer / ja: 擬似バス転送
+        }
+        return true;
+      },
+      ESP32TaskKit::TaskConfig{.name = "sensor", .priority = 3},
+      kSensorIntervalMs);
+
+  // en: Low-priority logger task (priority 1): holds the bus for 15 ms, stalling the sensor
+  // ja: 低優先度ロガータスク（優先度1）: バスを 15 ms 握り、センサを待たせる
+  loggerTask.startLoop(
+      []
+      {
+        ESP32SyncKit::BasicMutex<ESP32SyncKit::WithProfile>::LockGuard guard(busMutex, 100);
+        if (guard.locked())
+        {
+          delay(15); // en: long flash write on the same bus / ja: 同じバス上の長いフラッシュ書き込み
+        }
+        return true;
+      },
+      ESP32TaskKit::TaskConfig{.name = "logger", .priority = 1},
+      kLoggerIntervalMs);
+}
+
+void loop()
+{
+  // en: Dump and reset the report periodically; the longest holder should be "logger"
+  // ja: 定期的にレポートを出力してリセット。最長保持者は "logger" になるはず
+  delay(kReportIntervalMs);
+  busMutex.printProfile(Serial, "bus");
+  busMutex.resetProfile();
+}
@@ -0,0 +1,67 @@
+#include <Arduino.h>
+#include <ESP32SyncKit.h>
+
+// en: Lock-free SPSC ring (capacity 64) from a fast sampler task on core0 to a consumer on core1
+// ja: コア0の高速サンプリングタスクからコア1の受信タスクへ、ロックフリー SPSC リング（容量64）で受け渡す例
+
+struct Sample
+{
+  uint32_t seq;
+  int16_t value;
+};
+
+// en: Capacity must be a power of two; storage lives inside the object (no heap)
+// ja: 容量は2のべき乗。バッファはオブジェクト内に確保（ヒープ不使用）
+ESP32SyncKit::SpscQueue<Sample, 64> ring;
+
+void sampler(void * /*pv*/)
+{
+  uint32_t seq = 0;
+  for (;;)
+  {
+    // en: Only one task may send. Blocks (via task notification) only while the ring is full.
+    // ja: 送信は1タスクのみ。リングが満杯の間だけ（タスク通知で）ブロックする
+    Sample s{seq++, static_cast<int16_t>(seq & 0x3ff)};
+    if (!ring.send(s, 100))
+    {
+      Serial.println("[SpscQueue/raw] send failed");
+    }
+    delay(1);
+  }
+}
+
+void consumer(void * /*pv*/)
+{
+  Sample s{};
+  uint32_t received = 0;
+  for (;;)
+  {
+    // en: Only one task may receive. Sleeps only while the ring is empty.
+    // ja: 受信も1タスクのみ。リングが空の間だけ眠る
+    if (ring.receive(s))
+    {
+      if (++received % 500 == 0)
+      {
+        Serial.printf("[SpscQueue/raw] core=%d, seq=%lu, value=%d, backlog=%lu\n",
+                      xPortGetCoreID(),
+                      static_cast<unsigned long>(s.seq),
+                      s.value,
+                      static_cast<unsigned long>(ring.count()));
+      }
+    }
+  }
+}
+
+void setup()
+{
+  Serial.begin(115200);
+  // en: Producer pinned to core0, consumer pinned to core1 (priority 2, 4096 words stack)
+  // ja: 送信側をコア0、受信側をコア1に固定（優先度2、スタック4096ワード）
+  xTaskCreatePinnedToCore(sampler, "sampler", 4096, nullptr, 2, nullptr, 0);
+  xTaskCreatePinnedToCore(consumer, "consumer", 4096, nullptr, 2, nullptr, 1);
+}
+
+void loop()
+{
+  delay(1);
+}
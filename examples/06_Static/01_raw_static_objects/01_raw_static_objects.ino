@@ -0,0 +1,69 @@
+#include <Arduino.h>
+#include <ESP32SyncKit.h>
+
+// en: Static-allocation variants: storage is embedded in the objects, so nothing is taken from the heap
+// ja: 静的確保版の例。領域はオブジェクトに埋め込まれ、ヒープを一切使わない
+
+struct Reading
+{
+  uint32_t seq;
+  float celsius;
+};
+
+ESP32SyncKit::StaticQueue<Reading, 8> readings;    // en: depth fixed at compile time / ja: 深さはコンパイル時に固定
+ESP32SyncKit::StaticBinarySemaphore startSignal;   // en: same API as BinarySemaphore / ja: BinarySemaphore と同じ API
+ESP32SyncKit::StaticMutex serialLock;              // en: same API as Mutex, LockGuard works / ja: Mutex と同じ API、LockGuard も利用可
+
+void sensor(void * /*pv*/)
+{
+  // en: Wait until setup() says go
+  // ja: setup() からの開始合図を待つ
+  startSignal.take();
+
+  uint32_t seq = 0;
+  for (;;)
+  {
+    Reading r{seq++, 20.0f + (seq % 10) * 0.1f};
+    if (!readings.send(r, 1000))
+    {
+      ESP32SyncKit::Mutex::LockGuard g(serialLock);
+      Serial.println("[Static/raw] send failed");
+    }
+    delay(250);
+  }
+}
+
+void printer(void * /*pv*/)
+{
+  Reading r{};
+  for (;;)
+  {
+    if (readings.receive(r))
+    {
+      ESP32SyncKit::Mutex::LockGuard g(serialLock);
+      Serial.printf("[Static/raw] core=%d, seq=%lu, %.1f C\n",
+                    xPortGetCoreID(), static_cast<unsigned long>(r.seq), r.celsius);
+    }
+  }
+}
+
+void setup()
+{
+  Serial.begin(115200);
+
+  // en: sizeof() reports the exact RAM footprint of each object
+  // ja: sizeof() で各オブジェクトの正確な RAM 使用量が分かる
+  Serial.printf("[Static/raw] sizeof StaticQueue<Reading, 8>=%u, StaticBinarySemaphore=%u, StaticMutex=%u\n",
+                static_cast<unsigned>(sizeof(readings)),
+                static_cast<unsigned>(sizeof(startSignal)),
+                static_cast<unsigned>(sizeof(serialLock)));
+
+  xTaskCreatePinnedToCore(sensor, "sensor", 4096, nullptr, 2, nullptr, 0);
+  xTaskCreatePinnedToCore(printer, "printer", 4096, nullptr, 2, nullptr, 1);
+  startSignal.give();
+}
+
+void loop()
+{
+  delay(1);
+}
@@ -0,0 +1,74 @@
+#include <ESP32TaskKit.h>
+#include <ESP32SyncKit.h>
+
+// en: Zero-copy 1 KB frames: buffers come from a BufferPool and only a pointer-sized token goes through the queue
+// ja: 1 KB フレームをゼロコピーで受け渡す例。バッファは BufferPool から借り、キューにはポインタ1個分のトークンだけを流す
+
+struct Frame
+{
+  uint32_t seq;
+  uint8_t data[1024];
+};
+
+constexpr uint32_t kFrames = 4;
+
+ESP32SyncKit::BufferPool<Frame, kFrames> pool;                 // en: 4 frames, no heap / ja: 4 フレーム、ヒープ不使用
+ESP32SyncKit::Queue<ESP32SyncKit::Loan<Frame>::Raw> frames(kFrames); // en: carries tokens only / ja: トークンだけを運ぶ
+ESP32TaskKit::Task producer;
+ESP32TaskKit::Task consumer;
+
+void setup()
+{
+  Serial.begin(115200);
+
+  // en: Producer (priority 2): borrow a frame, fill it, hand it over every 50 ms
+  // ja: 送信タスク（優先度2）: 50 ms ごとにフレームを借りて埋め、受信側へ渡す
+  producer.startLoop(
+      []
+      {
+        static uint32_t seq = 0;
+        // en: Blocks like Queue::send while all frames are lent out
+        // ja: 全フレーム貸出中は Queue::send と同様にブロック
+        ESP32SyncKit::Loan<Frame> frame = pool.acquire(500);
+        if (!frame)
+        {
+          Serial.println("[BufferPool] acquire timeout (consumer too slow)");
+          return true;
+        }
+        frame->seq = seq++;
+        memset(frame->data, static_cast<int>(frame->seq & 0xff), sizeof(frame->data));
+
+        // en: On success ownership moves into the queue; on failure the loan returns the frame when it goes out of scope
+        // ja: 成功時は所有権がキューへ移る。失敗時はスコープを抜けると自動でプールへ戻る
+        if (!frame.sendTo(frames, 500))
+        {
+          Serial.println("[BufferPool] sendTo failed");
+        }
+        return true;
+      },
+      ESP32TaskKit::TaskConfig{.name = "frame-producer", .priority = 2},
+      50);
+
+  // en: Consumer (priority 2): take a frame, use it, and let the loan return it automatically
+  // ja: 受信タスク（優先度2）: フレームを受け取り、使い終わったら Loan が自動で返却
+  consumer.startLoop(
+      []
+      {
+        ESP32SyncKit::Loan<Frame> frame = ESP32SyncKit::Loan<Frame>::receiveFrom(frames);
+        if (frame)
+        {
+          Serial.printf("[BufferPool] core=%d, seq=%lu, first=%u, free=%lu\n",
+                        xPortGetCoreID(),
+                        static_cast<unsigned long>(frame->seq),
+                        frame->data[0],
+                        static_cast<unsigned long>(pool.available()));
+        }
+        return true; // en: frame goes back to the pool here / ja: ここでフレームがプールへ戻る
+      },
+      ESP32TaskKit::TaskConfig{.name = "frame-consumer", .priority = 2});
+}
+
+void loop()
+{
+  delay(1);
+}
@@ -0,0 +1,66 @@
+#include <ESP32TaskKit.h>
+#include <ESP32SyncKit.h>
+
+// en: EventFlags: one "config ready" broadcast wakes workers on both cores, then sync() lines them up every frame
+// ja: EventFlags: 1回の「設定完了」ブロードキャストで両コアのワーカーを起こし、sync() で毎フレーム足並みをそろえる
+
+constexpr EventBits_t kConfigReady = 1u << 0;
+constexpr EventBits_t kWorkerA = 1u << 1;
+constexpr EventBits_t kWorkerB = 1u << 2;
+constexpr EventBits_t kWorkerC = 1u << 3;
+constexpr EventBits_t kAllWorkers = kWorkerA | kWorkerB | kWorkerC;
+constexpr uint32_t kBarrierTimeoutMs = 1000;
+
+ESP32SyncKit::EventFlags flags;
+ESP32TaskKit::Task workerA;
+ESP32TaskKit::Task workerB;
+ESP32TaskKit::Task workerC;
+
+// en: One frame: wait for the broadcast (bit stays set for everyone), work, then meet at the barrier
+// ja: 1フレーム: ブロードキャストを待ち（ビットは全員のために残る）、処理し、バリアで合流
+bool runFrame(const char *name, EventBits_t myBit, uint32_t workMs)
+{
+  if (!flags.wait(kConfigReady))
+  {
+    return true;
+  }
+  delay(workMs); // en: simulated per-frame work / ja: フレームごとの擬似処理
+  if (flags.sync(myBit, kAllWorkers, kBarrierTimeoutMs))
+  {
+    Serial.printf("[EventFlags] %s passed barrier on core %d @ %lu ms\n",
+                  name, xPortGetCoreID(), static_cast<unsigned long>(millis()));
+  }
+  else
+  {
+    Serial.printf("[EventFlags] %s barrier timeout\n", name);
+  }
+  return true;
+}
+
+void setup()
+{
+  Serial.begin(115200);
+
+  // en: Three workers with different work lengths; the barrier releases them together
+  // ja: 処理時間の異なる3つのワーカー。バリアで同時に解放される
+  workerA.startLoop([] { return runFrame("A", kWorkerA, 10); },
+                    ESP32TaskKit::TaskConfig{.name = "worker-a", .priority = 2, .core = 0}, 500);
+  workerB.startLoop([] { return runFrame("B", kWorkerB, 50); },
+                    ESP32TaskKit::TaskConfig{.name = "worker-b", .priority = 2, .core = 1}, 500);
+  workerC.startLoop([] { return runFrame("C", kWorkerC, 120); },
+                    ESP32TaskKit::TaskConfig{.name = "worker-c", .priority = 2, .core = tskNO_AFFINITY}, 500);
+}
+
+void loop()
+{
+  static bool configured = false;
+  if (!configured && millis() > 2000)
+  {
+    // en: A single set() wakes all three waiting workers
+    // ja: set() 1回で待機中の3ワーカーすべてが起きる
+    Serial.println("[EventFlags] config ready");
+    flags.set(kConfigReady);
+    configured = true;
+  }
+  delay(10);
+}
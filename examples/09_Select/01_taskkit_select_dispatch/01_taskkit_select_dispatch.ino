@@ -0,0 +1,82 @@
+#include <ESP32TaskKit.h>
+#include <ESP32SyncKit.h>
+
+// en: Select: loop() blocks once on two queues and a button semaphore instead of polling each with delay()
+// ja: Select: loop() は各オブジェクトを delay() でポーリングせず、2つのキューとボタン用セマフォを1回で待つ
+
+#ifndef BUTTON_PIN
+#define BUTTON_PIN 0 // en: change for your board / ja: ボードに合わせて変更
+#endif
+
+struct Command
+{
+  uint8_t id;
+  int16_t arg;
+};
+
+ESP32SyncKit::Queue<int> readings(8);
+ESP32SyncKit::Queue<Command> commands(4);
+ESP32SyncKit::BinarySemaphore button;
+ESP32SyncKit::Select<3> sel;
+ESP32TaskKit::Task sensor;
+ESP32TaskKit::Task remote;
+
+void IRAM_ATTR onButton()
+{
+  button.give();
+}
+
+void setup()
+{
+  Serial.begin(115200);
+
+  // en: Register a typed handler per source, then attach them before any producer runs (members must be empty)
+  // ja: ソースごとに型付きハンドラを登録し、生産者が動く前にセットへ接続する（メンバーは空である必要がある）
+  sel.add(readings, [](const int &v)
+          { Serial.printf("[Select] reading %d\n", v); });
+  sel.add(commands, [](const Command &c)
+          { Serial.printf("[Select] command id=%u arg=%d\n", c.id, c.arg); });
+  sel.add(button, []
+          { Serial.println("[Select] button pressed"); });
+  if (!sel.begin())
+  {
+    Serial.println("[Select] begin failed");
+  }
+
+  pinMode(BUTTON_PIN, INPUT_PULLUP);
+  attachInterrupt(digitalPinToInterrupt(BUTTON_PIN), onButton, FALLING);
+
+  // en: Sensor (priority 2): a reading every 250 ms
+  // ja: センサ（優先度2）: 250 ms ごとに計測値を送信
+  sensor.startLoop(
+      []
+      {
+        static int value = 0;
+        readings.send(value++, 10);
+        return true;
+      },
+      ESP32TaskKit::TaskConfig{.name = "sensor", .priority = 2},
+      250);
+
+  // en: Remote (priority 2): a command every 1 s
+  // ja: リモート（優先度2）: 1 秒ごとにコマンドを送信
+  remote.startLoop(
+      []
+      {
+        static uint8_t id = 0;
+        commands.send(Command{id++, -1}, 10);
+        return true;
+      },
+      ESP32TaskKit::TaskConfig{.name = "remote", .priority = 2},
+      1000);
+}
+
+void loop()
+{
+  // en: One blocking wait; the returned index tells which source was served (-1 = timeout)
+  // ja: 1回のブロック待ち。戻り値はどのソースを処理したかの番号（-1 = タイムアウト）
+  if (sel.dispatch(2000) < 0)
+  {
+    Serial.println("[Select] idle");
+  }
+}
@@ -0,0 +1,81 @@
+#include <ESP32TaskKit.h>
+#include <ESP32SyncKit.h>
+
+// en: StreamBuffer / MessageBuffer: a byte stream read in blocks of 16 (trigger level) and variable-length text messages
+// ja: StreamBuffer / MessageBuffer: 16 バイト単位（トリガレベル）で読むバイトストリームと、可変長テキストメッセージ
+
+// en: Reader wakes only once 16 bytes are buffered (or the timeout expires)
+// ja: 16 バイト溜まるまで（またはタイムアウトまで）読み手は起きない
+ESP32SyncKit::StaticStreamBuffer<128> samples(16);
+ESP32SyncKit::MessageBuffer lines(256);
+ESP32TaskKit::Task producer;
+ESP32TaskKit::Task streamReader;
+ESP32TaskKit::Task lineReader;
+
+void setup()
+{
+  Serial.begin(115200);
+
+  // en: Producer (priority 2): 4 sample bytes every 50 ms, and a status line of varying length every 500 ms
+  // ja: 生産者（優先度2）: 50 ms ごとに4バイトのサンプル、500 ms ごとに長さの変わるステータス行を書き込む
+  producer.startLoop(
+      []
+      {
+        static uint8_t counter = 0;
+        static uint32_t ticks = 0;
+        const uint8_t chunk[4] = {counter, static_cast<uint8_t>(counter + 1), static_cast<uint8_t>(counter + 2), static_cast<uint8_t>(counter + 3)};
+        counter += 4;
+        samples.send(chunk, sizeof(chunk), 10);
+
+        if (++ticks % 10 == 0)
+        {
+          char line[48];
+          const int len = snprintf(line, sizeof(line), "status #%lu uptime=%lu ms", static_cast<unsigned long>(ticks / 10), static_cast<unsigned long>(millis()));
+          lines.send(line, static_cast<size_t>(len), 10); // en: one whole message / ja: メッセージ1件を丸ごと
+        }
+        return true;
+      },
+      ESP32TaskKit::TaskConfig{.name = "producer", .priority = 2},
+      50);
+
+  // en: Stream reader (priority 3): reads straight into its own buffer; typically 16 bytes per wakeup
+  // ja: ストリーム読み手（優先度3）: 自前のバッファへ直接読む。通常は1回の起床で16バイト
+  streamReader.startLoop(
+      []
+      {
+        uint8_t block[32];
+        const size_t n = samples.receive(block, sizeof(block), 1000);
+        if (n == 0)
+        {
+          Serial.println("[Stream] timeout");
+          return true;
+        }
+        Serial.printf("[Stream] %u bytes, first=%u last=%u\n", static_cast<unsigned>(n), block[0], block[n - 1]);
+        return true;
+      },
+      ESP32TaskKit::TaskConfig{.name = "stream", .priority = 3},
+      0);
+
+  // en: Line reader (priority 1): each receive returns exactly one message and its length
+  // ja: 行の読み手（優先度1）: receive 1回でちょうど1件のメッセージとその長さを返す
+  lineReader.startLoop(
+      []
+      {
+        char text[64];
+        const size_t len = lines.receive(text, sizeof(text) - 1, 2000);
+        if (len == 0)
+        {
+          return true;
+        }
+        text[len] = '\0';
+        Serial.printf("[Message] (%u) %s\n", static_cast<unsigned>(len), text);
+        return true;
+      },
+      ESP32TaskKit::TaskConfig{.name = "lines", .priority = 1},
+      0);
+}
+
+void loop()
+{
+  delay(1000);
+}
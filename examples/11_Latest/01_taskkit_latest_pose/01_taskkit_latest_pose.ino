@@ -0,0 +1,87 @@
+#include <ESP32TaskKit.h>
+#include <ESP32SyncKit.h>
+
+// en: Latest<T>: a 200 Hz pose publisher and readers on both cores, without a depth-1 overwrite queue
+// ja: Latest<T>: 200 Hz で姿勢を公開し、両コアの読み手が参照する（深さ1の overwrite キューを使わない）
+
+struct Pose
+{
+  float roll;
+  float pitch;
+  float yaw;
+  uint32_t sampleUs;
+};
+
+// en: WakeOnUpdate lets one task block in waitNewer(); others just read() whenever they like
+// ja: WakeOnUpdate にすると1つのタスクが waitNewer() でブロックできる。他のタスクは好きなときに read() するだけ
+ESP32SyncKit::Latest<Pose, ESP32SyncKit::WakeOnUpdate> pose;
+ESP32TaskKit::Task imu;
+ESP32TaskKit::Task controller;
+ESP32TaskKit::Task telemetry;
+
+void setup()
+{
+  Serial.begin(115200);
+
+  // en: IMU (core 1, priority 4): publishes every 5 ms; write() never blocks
+  // ja: IMU（コア1、優先度4）: 5 ms ごとに公開。write() はブロックしない
+  imu.startLoop(
+      []
+      {
+        static float angle = 0.0f;
+        angle += 0.5f;
+        pose.write(Pose{angle, angle * 0.5f, angle * 0.25f, static_cast<uint32_t>(micros())});
+        return true;
+      },
+      ESP32TaskKit::TaskConfig{.name = "imu", .priority = 4, .core = 1},
+      5);
+
+  // en: Controller (core 1, priority 3): wakes on every update; skipped versions show how many it missed
+  // ja: 制御（コア1、優先度3）: 更新ごとに起きる。バージョンの飛びは取りこぼした数を示す
+  controller.startLoop(
+      []
+      {
+        static uint32_t seen = 0;
+        static uint32_t handled = 0;
+        Pose p{};
+        const uint32_t before = seen;
+        if (!pose.waitNewer(p, seen, 100))
+        {
+          Serial.println("[Latest] controller: no update");
+          return true;
+        }
+        if (before != 0 && seen - before > 1)
+        {
+          Serial.printf("[Latest] controller skipped %lu updates\n", static_cast<unsigned long>(seen - before - 1));
+        }
+        if (++handled % 200 == 0)
+        {
+          Serial.printf("[Latest] controller yaw=%.1f\n", p.yaw);
+        }
+        return true;
+      },
+      ESP32TaskKit::TaskConfig{.name = "ctrl", .priority = 3, .core = 1},
+      0);
+
+  // en: Telemetry (core 0, priority 1): peeks at 2 Hz; reading does not consume the value
+  // ja: テレメトリ（コア0、優先度1）: 2 Hz で覗くだけ。読んでも値は消費されない
+  telemetry.startLoop(
+      []
+      {
+        Pose p{};
+        if (pose.read(p))
+        {
+          Serial.printf("[Latest] v=%lu roll=%.1f pitch=%.1f yaw=%.1f age=%lu us\n",
+                        static_cast<unsigned long>(pose.version()), p.roll, p.pitch, p.yaw,
+                        static_cast<unsigned long>(micros() - p.sampleUs));
+        }
+        return true;
+      },
+      ESP32TaskKit::TaskConfig{.name = "telemetry", .priority = 1, .core = 0},
+      500);
+}
+
+void loop()
+{
+  delay(1000);
+}
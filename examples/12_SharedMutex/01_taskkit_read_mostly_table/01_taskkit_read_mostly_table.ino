@@ -0,0 +1,81 @@
+#include <ESP32TaskKit.h>
+#include <ESP32SyncKit.h>
+
+// en: SharedMutex: six readers on both cores look up a calibration table in parallel; one writer replaces it every 10 s
+// ja: SharedMutex: 両コアの6つの読み手が校正テーブルを並行して参照し、1つの書き手が 10 秒ごとに差し替える
+
+constexpr size_t kTableSize = 64;
+constexpr size_t kReaders = 6;
+
+float calibration[kTableSize];
+uint32_t generation = 0;
+
+ESP32SyncKit::SharedMutex tableLock;
+ESP32TaskKit::Task readers[kReaders];
+ESP32TaskKit::Task writer;
+
+void setup()
+{
+  Serial.begin(115200);
+  for (size_t i = 0; i < kTableSize; ++i)
+  {
+    calibration[i] = 1.0f;
+  }
+
+  // en: Readers (priority 2, alternating cores): hold the lock shared, so they never wait for each other
+  // ja: 読み手（優先度2、コアを交互に割り当て）: 共有で保持するので互いを待たない
+  static const char *names[kReaders] = {"reader0", "reader1", "reader2", "reader3", "reader4", "reader5"};
+  for (size_t r = 0; r < kReaders; ++r)
+  {
+    readers[r].startLoop(
+        [r]
+        {
+          ESP32SyncKit::SharedMutex::SharedLockGuard guard(tableLock, 50);
+          if (!guard.locked())
+          {
+            Serial.printf("[SharedMutex] reader%u timeout\n", static_cast<unsigned>(r));
+            return true;
+          }
+          static uint32_t lookups = 0;
+          const float value = calibration[(r * 7) % kTableSize];
+          if (r == 0 && ++lookups % 20 == 0) // en: report every 2 s / ja: 2 秒ごとに表示
+          {
+            Serial.printf("[SharedMutex] gen=%lu value=%.2f readers=%lu\n",
+                          static_cast<unsigned long>(generation), value,
+                          static_cast<unsigned long>(tableLock.readers()));
+          }
+          return true;
+        },
+        ESP32TaskKit::TaskConfig{.name = names[r], .priority = 2, .core = static_cast<BaseType_t>(r % 2)},
+        100);
+  }
+
+  // en: Writer (priority 1): exclusive lock. PreferWriters (default) stops new readers while it waits, so it cannot starve;
+  // en: readers queued behind it boost its priority through the internal mutex.
+  // ja: 書き手（優先度1）: 排他ロック。既定の PreferWriters では待機中に新しい読み手を止めるので飢餓にならない。
+  // ja: 後ろに並んだ読み手は内部ミューテックス経由で書き手の優先度を引き上げる
+  writer.startLoop(
+      []
+      {
+        ESP32SyncKit::SharedMutex::LockGuard guard(tableLock, 1000);
+        if (!guard.locked())
+        {
+          Serial.println("[SharedMutex] writer timeout");
+          return true;
+        }
+        ++generation;
+        for (size_t i = 0; i < kTableSize; ++i)
+        {
+          calibration[i] = 1.0f + 0.01f * static_cast<float>(generation);
+        }
+        Serial.printf("[SharedMutex] table replaced (gen=%lu)\n", static_cast<unsigned long>(generation));
+        return true;
+      },
+      ESP32TaskKit::TaskConfig{.name = "writer", .priority = 1},
+      10000);
+}
+
+void loop()
+{
+  delay(1000);
+}
@@ -0,0 +1,94 @@
+#include <Arduino.h>
+#include <ESP32SyncKit.h>
+
+// en: Two ISRs on different cores feed one MpscQueue: a button interrupt attached on core 1 (setup)
+// en: and a 1 kHz hardware timer attached from a task on core 0. loop() drains each burst in one call.
+// ja: 別々のコアの2つの ISR が1つの MpscQueue に送る: コア1（setup）で登録したボタン割り込みと、
+// ja: コア0のタスクから登録した 1 kHz のハードウェアタイマー。loop() はバーストを1回の呼び出しで取り出す
+
+#ifndef BUTTON_PIN
+#define BUTTON_PIN 0 // en: change for your board / ja: ボードに合わせて変更
+#endif
+
+constexpr uint32_t kTimerHz = 1000000;
+constexpr uint32_t kTimerPeriodUs = 1000;
+constexpr uint32_t kReportIntervalMs = 1000;
+
+struct Event
+{
+  uint8_t source; // en: 0 = timer, 1 = button / ja: 0 = タイマー、1 = ボタン
+  uint8_t core;
+  uint32_t micros;
+};
+
+// en: Constant-initialized and needs no begin(); ISRs may use it right away
+// ja: 定数初期化され begin() も不要。ISR からすぐに使える
+ESP32SyncKit::MpscQueue<Event, 64> events;
+
+void IRAM_ATTR onTimer()
+{
+  // en: Never blocks; a full queue is counted in dropped()
+  // ja: ブロックしない。満杯は dropped() に計上される
+  (void)events.trySend(Event{0, static_cast<uint8_t>(xPortGetCoreID()), static_cast<uint32_t>(micros())});
+}
+
+void IRAM_ATTR onButton()
+{
+  (void)events.trySend(Event{1, static_cast<uint8_t>(xPortGetCoreID()), static_cast<uint32_t>(micros())});
+}
+
+void timerOnCore0(void * /*pv*/)
+{
+  // en: The timer interrupt is allocated on the core that attaches it
+  // ja: タイマー割り込みは登録したコアに割り当てられる
+  hw_timer_t *timer = timerBegin(kTimerHz);
+  timerAttachInterrupt(timer, &onTimer);
+  timerAlarm(timer, kTimerPeriodUs, true, 0);
+  vTaskDelete(nullptr);
+}
+
+void setup()
+{
+  Serial.begin(115200);
+
+  pinMode(BUTTON_PIN, INPUT_PULLUP);
+  attachInterrupt(digitalPinToInterrupt(BUTTON_PIN), onButton, FALLING);
+  xTaskCreatePinnedToCore(timerOnCore0, "timer0", 4096, nullptr, 2, nullptr, 0);
+}
+
+void loop()
+{
+  static uint32_t ticks = 0;
+  static uint32_t bursts = 0;
+  static uint32_t lastReportMs = 0;
+
+  Event batch[16];
+  // en: Sleeps until an ISR wakes it; one notification covers every item queued meanwhile
+  // ja: ISR に起こされるまで眠る。その間に積まれた全件を1回の通知でまとめて受け取る
+  const uint32_t n = events.receiveMany(batch, 16, 100);
+  if (n != 0)
+  {
+    ++bursts;
+  }
+  for (uint32_t i = 0; i < n; ++i)
+  {
+    if (batch[i].source == 0)
+    {
+      ++ticks;
+    }
+    else
+    {
+      Serial.printf("[MpscQueue/loop] button on core %u at %lu us\n", batch[i].core, static_cast<unsigned long>(batch[i].micros));
+    }
+  }
+
+  const uint32_t now = millis();
+  if (now - lastReportMs >= kReportIntervalMs)
+  {
+    lastReportMs = now;
+    Serial.printf("[MpscQueue/loop] ticks=%lu bursts=%lu dropped=%lu\n",
+                  static_cast<unsigned long>(ticks),
+                  static_cast<unsigned long>(bursts),
+                  static_cast<unsigned long>(events.dropped()));
+  }
+}
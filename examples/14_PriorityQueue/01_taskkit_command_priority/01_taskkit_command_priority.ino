@@ -0,0 +1,96 @@
+#include <ESP32TaskKit.h>
+#include <ESP32SyncKit.h>
+
+// en: Command dispatcher with three priority levels. A TaskKit producer floods the queue with Low/Normal
+// en: commands, a button ISR injects an Urgent stop, and the worker always takes the most urgent command
+// en: first; commands of the same priority stay in send order.
+// ja: 3段階の優先度を持つコマンドディスパッチャ。TaskKit の送信タスクが Low/Normal のコマンドを大量に積み、
+// ja: ボタン ISR が Urgent の停止を割り込ませる。処理タスクは常に最も緊急なコマンドから取り出し、
+// ja: 同じ優先度のコマンドは送信順のまま
+
+#ifndef BUTTON_PIN
+#define BUTTON_PIN 0 // en: change for your board / ja: ボードに合わせて変更
+#endif
+
+enum class Priority : uint8_t
+{
+  Low,
+  Normal,
+  Urgent,
+};
+
+struct Command
+{
+  Priority priority;
+  uint16_t id;
+};
+
+// en: Higher Priority leaves first (std::less semantics on the priority field)
+// ja: Priority が高いものから出る（priority フィールドに std::less の意味で比較）
+struct ByPriority
+{
+  bool operator()(const Command &a, const Command &b) const { return a.priority < b.priority; }
+};
+
+ESP32SyncKit::PriorityQueue<Command, 32, ByPriority> commands;
+ESP32TaskKit::Task producer;
+ESP32TaskKit::Task worker;
+
+void IRAM_ATTR onButton()
+{
+  // en: Never blocks in an ISR; fails only if all 32 slots are taken
+  // ja: ISR ではブロックしない。32 スロットすべて埋まっているときだけ失敗する
+  (void)commands.send(Command{Priority::Urgent, 0});
+}
+
+void setup()
+{
+  Serial.begin(115200);
+  pinMode(BUTTON_PIN, INPUT_PULLUP);
+  attachInterrupt(digitalPinToInterrupt(BUTTON_PIN), onButton, FALLING);
+
+  // en: Producer (priority 2): a burst of 8 commands every 100 ms, every fourth one Normal
+  // ja: 送信タスク（優先度2）: 100 ms ごとに8件のバースト。4件に1件は Normal
+  producer.startLoop(
+      []
+      {
+        static uint16_t id = 1;
+        for (int i = 0; i < 8; ++i, ++id)
+        {
+          const Priority p = (id % 4 == 0) ? Priority::Normal : Priority::Low;
+          if (!commands.send(Command{p, id}, 50))
+          {
+            Serial.println("[PriorityQueue/producer] full");
+          }
+        }
+        return true;
+      },
+      ESP32TaskKit::TaskConfig{.name = "cmd-producer", .priority = 2},
+      100);
+
+  // en: Worker (priority 1): each burst queues up behind it, so the Normal commands overtake the Low ones
+  // ja: 処理タスク（優先度1）: バーストごとに滞留ができるため、Normal のコマンドが Low を追い越す
+  worker.startLoop(
+      []
+      {
+        Command cmd;
+        if (!commands.receive(cmd, 1000))
+        {
+          return true;
+        }
+        static const char *const kNames[] = {"low", "normal", "URGENT"};
+        Serial.printf("[PriorityQueue/worker] %s id=%u backlog=%lu\n",
+                      kNames[static_cast<uint8_t>(cmd.priority)],
+                      cmd.id,
+                      static_cast<unsigned long>(commands.count()));
+        delay(10); // en: simulated work / ja: 処理の代わり
+        return true;
+      },
+      ESP32TaskKit::TaskConfig{.name = "cmd-worker", .priority = 1},
+      0);
+}
+
+void loop()
+{
+  delay(1000);
+}
@@ -0,0 +1,85 @@
+#include <Arduino.h>
+#include <ESP32SyncKit.h>
+
+// en: Two interrupt sources, no dispatch task of their own: the button ISR and a 100 Hz timer ISR post
+// en: small lambdas to one DeferredExecutor, whose two workers (one per core) run them in task context.
+// en: loop() prints the backlog and execution times.
+// ja: 2つの割り込み源が専用のディスパッチタスクを持たない: ボタン ISR と 100 Hz のタイマー ISR が小さなラムダを
+// ja: 1つの DeferredExecutor に post し、そのワーカ2つ（コアごとに1つ）がタスク文脈で実行する。
+// ja: loop() は滞留数と実行時間を表示する
+
+#ifndef BUTTON_PIN
+#define BUTTON_PIN 0 // en: change for your board / ja: ボードに合わせて変更
+#endif
+
+constexpr uint32_t kTimerHz = 1000000;
+constexpr uint32_t kTimerPeriodUs = 10000;
+
+// en: 16 jobs of up to 24 bytes of captures each, all inside the job queue (no heap per post)
+// ja: キャプチャ最大 24 バイトのジョブを 16 件。すべてジョブキューの中に入る（post ごとのヒープ確保なし）
+ESP32SyncKit::DeferredExecutor<> executor(16);
+
+// en: Two workers may run jobs at the same time, so shared state still needs a lock
+// ja: 2つのワーカが同時にジョブを実行し得るため、共有状態にはやはりロックが要る
+uint32_t samples = 0;
+ESP32SyncKit::Mutex sampleLock;
+
+void IRAM_ATTR onButton()
+{
+  const uint32_t at = micros();
+  // en: The lambda runs later on a worker, where Serial and blocking calls are fine
+  // ja: ラムダは後でワーカ上で実行されるため、Serial もブロッキング呼び出しも使える
+  (void)executor.post([at]
+                      { Serial.printf("[DeferredExecutor] button at %lu us, run on core %d\n",
+                                      static_cast<unsigned long>(at), xPortGetCoreID()); });
+}
+
+void IRAM_ATTR onTimer()
+{
+  const uint16_t raw = static_cast<uint16_t>(micros() & 0x0fff); // en: stand-in for an ADC read / ja: ADC 読み取りの代わり
+  (void)executor.post([raw]
+                      {
+                        ESP32SyncKit::Mutex::LockGuard guard(sampleLock);
+                        samples += raw ? 1 : 0;
+                      });
+}
+
+void setup()
+{
+  Serial.begin(115200);
+
+  // en: Start the workers before any ISR can post (the job queue must exist first)
+  // ja: ISR が post する前にワーカを起動する（ジョブキューが先に必要）
+  ESP32SyncKit::ExecutorConfig config;
+  config.name = "deferred";
+  config.workers = 2;
+  config.pinPerCore = true;
+  config.stackSize = 3072;
+  executor.begin(config);
+
+  pinMode(BUTTON_PIN, INPUT_PULLUP);
+  attachInterrupt(digitalPinToInterrupt(BUTTON_PIN), onButton, FALLING);
+
+  hw_timer_t *timer = timerBegin(kTimerHz);
+  timerAttachInterrupt(timer, &onTimer);
+  timerAlarm(timer, kTimerPeriodUs, true, 0);
+}
+
+void loop()
+{
+  delay(2000);
+  const ESP32SyncKit::ExecutorStats s = executor.stats();
+  executor.resetStats();
+  uint32_t sampleCount = 0;
+  {
+    ESP32SyncKit::Mutex::LockGuard guard(sampleLock);
+    sampleCount = samples;
+  }
+  Serial.printf("[DeferredExecutor] samples=%lu executed=%lu rejected=%lu peakPending=%lu avg=%.1f us max=%lu us\n",
+                static_cast<unsigned long>(sampleCount),
+                static_cast<unsigned long>(s.executed),
+                static_cast<unsigned long>(s.rejected),
+                static_cast<unsigned long>(s.peakPending),
+                s.executed ? static_cast<double>(s.execUsTotal) / s.executed : 0.0,
+                static_cast<unsigned long>(s.execUsMax));
+}
@@ -0,0 +1,110 @@
+#include <Arduino.h>
+#include <ESP32SyncKit.h>
+
+// en: A 3x3 box blur over a synthetic 160x120 image, split into rows across both cores with
+// en: WorkPool::parallelFor. Rows near the top are made heavier (extra passes) so the work is uneven;
+// en: stealing keeps both cores busy. A checksum job then runs asynchronously while loop() waits on a Completion.
+// ja: 160x120 の合成画像に 3x3 のぼかしを掛け、WorkPool::parallelFor で行ごとに両コアへ分配する。
+// ja: 上のほうの行は処理を重くして（追加パス）負荷を偏らせるが、ワークスティーリングで両コアとも働き続ける。
+// ja: その後チェックサムのジョブを非同期に実行し、loop() は Completion で完了を待つ
+
+constexpr uint32_t kWidth = 160;
+constexpr uint32_t kHeight = 120;
+constexpr uint32_t kRowsPerChunk = 4;
+
+uint8_t source[kHeight][kWidth];
+uint8_t blurred[kHeight][kWidth];
+uint32_t checksum = 0;
+
+// en: Inbox of 4 for jobs submitted from loop(); the per-worker deques live inside the object
+// ja: loop() から投入するジョブ用に受付キュー 4 件。ワーカごとの deque はオブジェクト内に持つ
+ESP32SyncKit::WorkPool<> pool(4);
+
+void blurRows(uint32_t begin, uint32_t end)
+{
+  for (uint32_t y = begin; y < end; ++y)
+  {
+    const uint32_t passes = (y < kHeight / 4) ? 6 : 1; // en: uneven cost / ja: 偏ったコスト
+    for (uint32_t p = 0; p < passes; ++p)
+    {
+      for (uint32_t x = 0; x < kWidth; ++x)
+      {
+        uint32_t sum = 0;
+        uint32_t n = 0;
+        for (int dy = -1; dy <= 1; ++dy)
+        {
+          for (int dx = -1; dx <= 1; ++dx)
+          {
+            const int yy = static_cast<int>(y) + dy;
+            const int xx = static_cast<int>(x) + dx;
+            if (yy >= 0 && yy < static_cast<int>(kHeight) && xx >= 0 && xx < static_cast<int>(kWidth))
+            {
+              sum += source[yy][xx];
+              ++n;
+            }
+          }
+        }
+        blurred[y][x] = static_cast<uint8_t>(sum / n);
+      }
+    }
+  }
+}
+
+void setup()
+{
+  Serial.begin(115200);
+  for (uint32_t y = 0; y < kHeight; ++y)
+  {
+    for (uint32_t x = 0; x < kWidth; ++x)
+    {
+      source[y][x] = static_cast<uint8_t>((x * 7) ^ (y * 13));
+    }
+  }
+
+  // en: One worker pinned to each core
+  // ja: 各コアに1つずつワーカを固定
+  pool.begin();
+}
+
+void loop()
+{
+  pool.resetStats();
+  const uint32_t start = micros();
+
+  // en: Blocks until every row is done; the callable is copied into each job, so capture by value only
+  // ja: 全行が終わるまでブロックする。関数は各ジョブにコピーされるため、値キャプチャのみ
+  pool.parallelFor(0, kHeight, kRowsPerChunk, [](uint32_t begin, uint32_t end) { blurRows(begin, end); });
+  const uint32_t blurUs = micros() - start;
+
+  // en: Fire-and-wait: submit() returns at once, done.wait() sleeps on this task's notification
+  // ja: 投入して待つ: submit() はすぐ戻り、done.wait() はこのタスクの通知で眠る
+  ESP32SyncKit::Completion done;
+  pool.submit(done, []
+              {
+                uint32_t sum = 0;
+                for (uint32_t y = 0; y < kHeight; ++y)
+                {
+                  for (uint32_t x = 0; x < kWidth; ++x)
+                  {
+                    sum = sum * 31 + blurred[y][x];
+                  }
+                }
+                checksum = sum;
+              });
+  if (!done.wait(1000))
+  {
+    Serial.println("[WorkPool] checksum timeout");
+    return;
+  }
+
+  const ESP32SyncKit::WorkerStats w0 = pool.workerStats(0);
+  const ESP32SyncKit::WorkerStats w1 = pool.workerStats(1);
+  Serial.printf("[WorkPool] blur %lu us, checksum %08lx, core0 jobs=%lu steals=%lu, core1 jobs=%lu steals=%lu\n",
+                static_cast<unsigned long>(blurUs),
+                static_cast<unsigned long>(checksum),
+                static_cast<unsigned long>(w0.jobs),
+                static_cast<unsigned long>(w0.steals),
+                static_cast<unsigned long>(w1.jobs),
+                static_cast<unsigned long>(w1.steals));
+  delay(2000);
+}
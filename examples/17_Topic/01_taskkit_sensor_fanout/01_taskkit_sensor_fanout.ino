@@ -0,0 +1,117 @@
+#include <ESP32TaskKit.h>
+#include <ESP32SyncKit.h>
+
+// en: One sensor stream, three readers. A TaskKit publisher writes a sample every 10 ms into one Topic;
+// en: the control task (Block policy) must see every sample, the slow display task (Drop policy) only wants
+// en: the latest ones, and loop() just prints the counters. Publishing costs one copy however many readers there are.
+// ja: 1つのセンサー値を3つの読み手へ。TaskKit の発行タスクが 10 ms ごとにサンプルを1つの Topic に書く。
+// ja: 制御タスク（Block ポリシー）は全サンプルを受け取る必要があり、遅い表示タスク（Drop ポリシー）は
+// ja: 新しい値だけが欲しく、loop() はカウンタを表示するだけ。読み手が何人でも発行のコストはコピー1回
+
+struct Sample
+{
+  uint32_t seq;
+  uint32_t atMs;
+  int16_t value;
+};
+
+// en: 16-slot ring shared by every subscriber (Capacity must be a power of two)
+// ja: 全購読者で共有する 16 スロットのリング（Capacity は2の累乗）
+ESP32SyncKit::Topic<Sample, 16> samples;
+
+// en: Subscribers attach in their constructor and start at the next published sample
+// ja: 購読者はコンストラクタで登録され、次に発行されたサンプルから読む
+ESP32SyncKit::Topic<Sample, 16>::Subscriber control(samples, ESP32SyncKit::TopicPolicy::Block);
+ESP32SyncKit::Topic<Sample, 16>::Subscriber display(samples, ESP32SyncKit::TopicPolicy::Drop);
+ESP32SyncKit::Topic<Sample, 16>::Subscriber monitor(samples);
+
+ESP32TaskKit::Task publisher;
+ESP32TaskKit::Task controlTask;
+ESP32TaskKit::Task displayTask;
+
+uint32_t controlCount = 0;
+uint32_t controlGaps = 0;
+
+void setup()
+{
+  Serial.begin(115200);
+
+  // en: Publisher (priority 3): waits at most 20 ms if the control task is a full ring behind
+  // ja: 発行タスク（優先度3）: 制御タスクが1周分遅れていれば最大 20 ms 待つ
+  publisher.startLoop(
+      []
+      {
+        static uint32_t seq = 0;
+        const Sample s{seq++, millis(), static_cast<int16_t>(micros() & 0x0fff)}; // en: stand-in for an ADC read / ja: ADC 読み取りの代わり
+        if (!samples.publish(s, 20))
+        {
+          Serial.println("[Topic/publisher] control task stalled");
+        }
+        return true;
+      },
+      ESP32TaskKit::TaskConfig{.name = "sensor", .priority = 3},
+      10);
+
+  // en: Control (priority 2): sleeps in receive() until the publisher notifies it; never misses a sample
+  // ja: 制御（優先度2）: 発行側に通知されるまで receive() で眠る。サンプルを取りこぼさない
+  controlTask.startLoop(
+      []
+      {
+        static uint32_t expected = 0;
+        Sample s;
+        if (!control.receive(s, 1000))
+        {
+          return true;
+        }
+        if (s.seq != expected)
+        {
+          ++controlGaps; // en: stays 0 with the Block policy / ja: Block ポリシーなら 0 のまま
+        }
+        expected = s.seq + 1;
+        ++controlCount;
+        return true;
+      },
+      ESP32TaskKit::TaskConfig{.name = "control", .priority = 2},
+      0);
+
+  // en: Display (priority 1): drains whatever is there every 250 ms; older samples are overwritten and counted
+  // ja: 表示（優先度1）: 250 ms ごとに溜まった分を読む。古いサンプルは上書きされ、数として残る
+  displayTask.startLoop(
+      []
+      {
+        Sample s;
+        Sample latest{};
+        uint32_t read = 0;
+        while (display.tryReceive(s))
+        {
+          latest = s;
+          ++read;
+        }
+        if (read != 0)
+        {
+          Serial.printf("[Topic/display] seq=%lu value=%d (read %lu, missed so far %lu)\n",
+                        static_cast<unsigned long>(latest.seq),
+                        latest.value,
+                        static_cast<unsigned long>(read),
+                        static_cast<unsigned long>(display.missed()));
+        }
+        return true;
+      },
+      ESP32TaskKit::TaskConfig{.name = "display", .priority = 1},
+      250);
+}
+
+void loop()
+{
+  delay(2000);
+  Sample s;
+  while (monitor.tryReceive(s))
+  {
+  }
+  Serial.printf("[Topic] subscribers=%lu control=%lu gaps=%lu monitor missed=%lu rejected=%lu\n",
+                static_cast<unsigned long>(samples.subscribers()),
+                static_cast<unsigned long>(controlCount),
+                static_cast<unsigned long>(controlGaps),
+                static_cast<unsigned long>(monitor.missed()),
+                static_cast<unsigned long>(samples.rejected()));
+}
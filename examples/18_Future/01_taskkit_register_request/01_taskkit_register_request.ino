@@ -0,0 +1,93 @@
+#include <ESP32TaskKit.h>
+#include <ESP32SyncKit.h>
+
+// en: Request/response without a reply queue per client. Two client tasks ask a bus task to "read a register";
+// en: each request carries a Promise, and the client waits on a Future on its own stack. Every fifth read is
+// en: slow, so the client gives up after 30 ms; the late set() then returns false instead of writing into a
+// en: Future that no longer exists.
+// ja: クライアントごとの返信キューなしの要求/応答。2つのクライアントタスクがバスタスクに「レジスタ読み取り」を
+// ja: 依頼する。各要求は Promise を運び、クライアントは自分のスタック上の Future で待つ。5回に1回は読み取りが
+// ja: 遅く、クライアントは 30 ms で諦める。その後の遅れた set() は、もう存在しない Future に書かずに false を返す
+
+struct ReadRequest
+{
+  uint8_t reg;
+  ESP32SyncKit::Promise<uint16_t> reply; // en: small handle, copied through the Queue / ja: Queue でコピーされる小さなハンドル
+};
+
+ESP32SyncKit::Queue<ReadRequest> requests(8);
+
+ESP32TaskKit::Task bus;
+ESP32TaskKit::Task clientA;
+ESP32TaskKit::Task clientB;
+
+uint32_t lateReplies = 0;
+
+bool readRegister(uint8_t reg, const char *who)
+{
+  ESP32SyncKit::Future<uint16_t> result;
+  if (!requests.send(ReadRequest{reg, result.promise()}, 10))
+  {
+    return false;
+  }
+  uint16_t value = 0;
+  if (!result.get(value, 30))
+  {
+    Serial.printf("[Future/%s] reg 0x%02x timed out\n", who, reg);
+    return false; // en: result is destroyed here; the bus task's reply is discarded / ja: ここで result は破棄され、バスタスクの応答は捨てられる
+  }
+  Serial.printf("[Future/%s] reg 0x%02x = 0x%04x\n", who, reg, value);
+  return true;
+}
+
+void setup()
+{
+  Serial.begin(115200);
+
+  // en: Bus task (priority 3): serves requests in order; set() wakes the waiting client directly
+  // ja: バスタスク（優先度3）: 要求を順に処理する。set() が待っているクライアントを直接起こす
+  bus.startLoop(
+      []
+      {
+        static uint32_t served = 0;
+        ReadRequest req;
+        if (!requests.receive(req, 1000))
+        {
+          return true;
+        }
+        delay((++served % 5 == 0) ? 50 : 2); // en: simulated bus transfer / ja: バス転送の代わり
+        const uint16_t value = static_cast<uint16_t>((req.reg << 8) | (served & 0xff));
+        if (!req.reply.set(value))
+        {
+          ++lateReplies;
+        }
+        return true;
+      },
+      ESP32TaskKit::TaskConfig{.name = "bus", .priority = 3},
+      0);
+
+  clientA.startLoop(
+      []
+      {
+        static uint8_t reg = 0x10;
+        (void)readRegister(reg++, "A");
+        return true;
+      },
+      ESP32TaskKit::TaskConfig{.name = "client-a", .priority = 2},
+      200);
+
+  clientB.startLoop(
+      []
+      {
+        (void)readRegister(0x7f, "B");
+        return true;
+      },
+      ESP32TaskKit::TaskConfig{.name = "client-b", .priority = 2},
+      300);
+}
+
+void loop()
+{
+  delay(3000);
+  Serial.printf("[Future] late replies discarded: %lu\n", static_cast<unsigned long>(lateReplies));
+}
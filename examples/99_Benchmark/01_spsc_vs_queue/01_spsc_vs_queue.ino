@@ -0,0 +1,80 @@
+#include <Arduino.h>
+#include <ESP32SyncKit.h>
+#include <esp_timer.h>
+
+// en: Throughput comparison: Queue<T> (xQueueSend/xQueueReceive) vs SpscQueue<T, N> (lock-free ring)
+// en: Producer on core0, consumer on core1. Results are printed as one JSON object per line.
+// ja: スループット比較: Queue<T>（xQueueSend/xQueueReceive）と SpscQueue<T, N>（ロックフリーリング）
+// ja: 送信側コア0、受信側コア1。結果は1行1オブジェクトの JSON で出力する
+
+constexpr uint32_t kItems = 200000;
+constexpr uint32_t kDepth = 64;
+
+ESP32SyncKit::Queue<uint32_t> queue(kDepth);
+ESP32SyncKit::SpscQueue<uint32_t, kDepth> spsc;
+ESP32SyncKit::BinarySemaphore done;
+
+template <class Q>
+void producerTask(void *pv)
+{
+  Q *q = static_cast<Q *>(pv);
+  for (uint32_t i = 0; i < kItems; ++i)
+  {
+    q->send(i);
+  }
+  vTaskDelete(nullptr);
+}
+
+template <class Q>
+void consumerTask(void *pv)
+{
+  Q *q = static_cast<Q *>(pv);
+  uint32_t v = 0;
+  uint32_t errors = 0;
+  for (uint32_t i = 0; i < kItems; ++i)
+  {
+    q->receive(v);
+    if (v != i)
+    {
+      ++errors; // en: order check / ja: 順序チェック
+    }
+  }
+  if (errors)
+  {
+    Serial.printf("[Bench] order errors=%lu\n", static_cast<unsigned long>(errors));
+  }
+  done.give();
+  vTaskDelete(nullptr);
+}
+
+template <class Q>
+void run(const char *name, Q &q)
+{
+  const int64_t start = esp_timer_get_time();
+  xTaskCreatePinnedToCore(consumerTask<Q>, "bench-rx", 4096, &q, 5, nullptr, 1);
+  xTaskCreatePinnedToCore(producerTask<Q>, "bench-tx", 4096, &q, 5, nullptr, 0);
+  done.take();
+  const int64_t elapsedUs = esp_timer_get_time() - start;
+  const double itemsPerSec = (elapsedUs > 0) ? (kItems * 1e6 / elapsedUs) : 0.0;
+  Serial.printf("{\"bench\":\"spsc_vs_queue\",\"impl\":\"%s\",\"items\":%lu,\"depth\":%lu,\"us\":%lld,\"items_per_sec\":%.0f}\n",
+                name,
+                static_cast<unsigned long>(kItems),
+                static_cast<unsigned long>(kDepth),
+                static_cast<long long>(elapsedUs),
+                itemsPerSec);
+}
+
+void setup()
+{
+  Serial.begin(115200);
+  delay(1000);
+
+  run("Queue", queue);
+  run("SpscQueue", spsc);
+  Serial.println("{\"bench\":\"done\"}");
+}
+
+void loop()
+{
+  delay(1000);
+}
@@ -0,0 +1,266 @@
+#include <Arduino.h>
+#include <ESP32SyncKit.h>
+#include <esp_timer.h>
+
+// en: Benchmark suite for the core primitives. Each result is one JSON object per line, e.g.
+// en:   {"bench":"queue_throughput","payload":32,"depth":8,"ops":20000,"us":123456,"ns_per_op":6172.8}
+// en: Capture the serial output and diff it between library versions to catch regressions.
+// ja: 基本プリミティブのベンチマーク集。結果は1行1オブジェクトの JSON で出力する（例は上記）
+// ja: シリアル出力を保存し、ライブラリ更新前後で比較すれば性能劣化を検出できる
+
+constexpr uint32_t kRounds = 10000;
+constexpr BaseType_t kBenchCore = 0;  // en: measuring task / ja: 計測タスク
+constexpr BaseType_t kHelperCore = 1; // en: echo / consumer / contender tasks / ja: 相手役タスク
+constexpr UBaseType_t kPriority = 5;
+
+template <size_t Size>
+struct Payload
+{
+  uint8_t bytes[Size];
+};
+
+ESP32SyncKit::BinarySemaphore helperDone;
+
+void report(const char *bench, const char *params, uint32_t ops, int64_t us)
+{
+  const double nsPerOp = ops ? (us * 1000.0 / ops) : 0.0;
+  Serial.printf("{\"bench\":\"%s\"%s%s,\"ops\":%lu,\"us\":%lld,\"ns_per_op\":%.1f}\n",
+                bench,
+                params[0] ? "," : "",
+                params,
+                static_cast<unsigned long>(ops),
+                static_cast<long long>(us),
+                nsPerOp);
+}
+
+void spawnHelper(TaskFunction_t fn, void *ctx)
+{
+  xTaskCreatePinnedToCore(fn, "bench-helper", 4096, ctx, kPriority, nullptr, kHelperCore);
+}
+
+// en: Queue ping-pong: round-trip latency between two tasks on different cores
+// ja: Queue ピンポン: 別コアの2タスク間の往復レイテンシ
+struct PingPongCtx
+{
+  ESP32SyncKit::Queue<uint32_t> ping{1};
+  ESP32SyncKit::Queue<uint32_t> pong{1};
+};
+
+void benchQueuePingPong()
+{
+  PingPongCtx ctx;
+  spawnHelper(
+      [](void *pv)
+      {
+        PingPongCtx *c = static_cast<PingPongCtx *>(pv);
+        uint32_t v = 0;
+        for (uint32_t i = 0; i < kRounds; ++i)
+        {
+          c->ping.receive(v);
+          c->pong.send(v);
+        }
+        helperDone.give();
+        vTaskDelete(nullptr);
+      },
+      &ctx);
+
+  uint32_t v = 0;
+  const int64_t start = esp_timer_get_time();
+  for (uint32_t i = 0; i < kRounds; ++i)
+  {
+    ctx.ping.send(i);
+    ctx.pong.receive(v);
+  }
+  const int64_t us = esp_timer_get_time() - start;
+  helperDone.take();
+  report("queue_pingpong", "", kRounds, us);
+}
+
+// en: Queue throughput by payload size and depth (producer core0 -> consumer core1)
+// ja: ペイロードサイズと深さごとの Queue スループット（送信コア0 → 受信コア1）
+template <size_t Size>
+void benchQueueThroughput(uint32_t depth)
+{
+  ESP32SyncKit::Queue<Payload<Size>> q(depth);
+  spawnHelper(
+      [](void *pv)
+      {
+        auto *queue = static_cast<ESP32SyncKit::Queue<Payload<Size>> *>(pv);
+        Payload<Size> item;
+        for (uint32_t i = 0; i < kRounds; ++i)
+        {
+          queue->receive(item);
+        }
+        helperDone.give();
+        vTaskDelete(nullptr);
+      },
+      &q);
+
+  Payload<Size> item{};
+  const int64_t start = esp_timer_get_time();
+  for (uint32_t i = 0; i < kRounds; ++i)
+  {
+    q.send(item);
+  }
+  helperDone.take();
+  const int64_t us = esp_timer_get_time() - start;
+
+  char params[48];
+  snprintf(params, sizeof(params), "\"payload\":%u,\"depth\":%lu",
+           static_cast<unsigned>(Size), static_cast<unsigned long>(depth));
+  report("queue_throughput", params, kRounds, us);
+}
+
+// en: Mutex lock+unlock without contention
+// ja: 競合なしの Mutex lock+unlock
+void benchMutexUncontended()
+{
+  ESP32SyncKit::Mutex m;
+  const int64_t start = esp_timer_get_time();
+  for (uint32_t i = 0; i < kRounds; ++i)
+  {
+    m.lock();
+    m.unlock();
+  }
+  const int64_t us = esp_timer_get_time() - start;
+  report("mutex_uncontended", "", kRounds, us);
+}
+
+// en: Mutex lock+unlock with one contender on the other core
+// ja: 別コアに競合タスクが1つある状態の Mutex lock+unlock
+void benchMutexContended()
+{
+  ESP32SyncKit::Mutex m;
+  spawnHelper(
+      [](void *pv)
+      {
+        ESP32SyncKit::Mutex *mutex = static_cast<ESP32SyncKit::Mutex *>(pv);
+        for (uint32_t i = 0; i < kRounds; ++i)
+        {
+          mutex->lock();
+          mutex->unlock();
+        }
+        helperDone.give();
+        vTaskDelete(nullptr);
+      },
+      &m);
+
+  const int64_t start = esp_timer_get_time();
+  for (uint32_t i = 0; i < kRounds; ++i)
+  {
+    m.lock();
+    m.unlock();
+  }
+  helperDone.take();
+  const int64_t us = esp_timer_get_time() - start;
+  report("mutex_contended", "\"tasks\":2", kRounds * 2, us);
+}
+
+// en: Notify counter round trip (notify -> take -> notify back -> take)
+// ja: Notify カウンタ往復（notify → take → 返信 notify → take）
+struct NotifyCtx
+{
+  ESP32SyncKit::Notify toHelper{ESP32SyncKit::Notify::Mode::Counter};
+  ESP32SyncKit::Notify toBench{ESP32SyncKit::Notify::Mode::Counter};
+  ESP32SyncKit::Notify bitsToHelper{ESP32SyncKit::Notify::Mode::Bits};
+  ESP32SyncKit::Notify bitsToBench{ESP32SyncKit::Notify::Mode::Bits};
+};
+
+void benchNotifyRoundTrip()
+{
+  NotifyCtx ctx;
+  ctx.toBench.bindToSelf();
+  spawnHelper(
+      [](void *pv)
+      {
+        NotifyCtx *c = static_cast<NotifyCtx *>(pv);
+        c->toHelper.bindToSelf();
+        helperDone.give(); // en: ready / ja: 準備完了
+        for (uint32_t i = 0; i < kRounds; ++i)
+        {
+          c->toHelper.take();
+          c->toBench.notify();
+        }
+        helperDone.give();
+        vTaskDelete(nullptr);
+      },
+      &ctx);
+  helperDone.take();
+
+  const int64_t start = esp_timer_get_time();
+  for (uint32_t i = 0; i < kRounds; ++i)
+  {
+    ctx.toHelper.notify();
+    ctx.toBench.take();
+  }
+  const int64_t us = esp_timer_get_time() - start;
+  helperDone.take();
+  report("notify_roundtrip", "\"mode\":\"counter\"", kRounds, us);
+}
+
+// en: Notify bits round trip (setBits -> waitBits -> setBits back -> waitBits)
+// ja: Notify ビット往復（setBits → waitBits → 返信 setBits → waitBits）
+void benchNotifyWaitBits()
+{
+  constexpr uint32_t kBit = 1 << 0;
+  NotifyCtx ctx;
+  ctx.bitsToBench.bindToSelf();
+  spawnHelper(
+      [](void *pv)
+      {
+        NotifyCtx *c = static_cast<NotifyCtx *>(pv);
+        c->bitsToHelper.bindToSelf();
+        helperDone.give(); // en: ready / ja: 準備完了
+        for (uint32_t i = 0; i < kRounds; ++i)
+        {
+          c->bitsToHelper.waitBits(kBit);
+          c->bitsToBench.setBits(kBit);
+        }
+        helperDone.give();
+        vTaskDelete(nullptr);
+      },
+      &ctx);
+  helperDone.take();
+
+  const int64_t start = esp_timer_get_time();
+  for (uint32_t i = 0; i < kRounds; ++i)
+  {
+    ctx.bitsToHelper.setBits(kBit);
+    ctx.bitsToBench.waitBits(kBit);
+  }
+  const int64_t us = esp_timer_get_time() - start;
+  helperDone.take();
+  report("notify_roundtrip", "\"mode\":\"bits\"", kRounds, us);
+}
+
+void benchTask(void * /*pv*/)
+{
+  benchQueuePingPong();
+
+  for (uint32_t depth : {1u, 8u, 64u})
+  {
+    benchQueueThroughput<4>(depth);
+    benchQueueThroughput<32>(depth);
+    benchQueueThroughput<128>(depth);
+  }
+
+  benchMutexUncontended();
+  benchMutexContended();
+  benchNotifyRoundTrip();
+  benchNotifyWaitBits();
+
+  Serial.println("{\"bench\":\"done\"}");
+  vTaskDelete(nullptr);
+}
+
+void setup()
+{
+  Serial.begin(115200);
+  delay(1000);
+  xTaskCreatePinnedToCore(benchTask, "bench", 8192, nullptr, kPriority, nullptr, kBenchCore);
+}
+
+void loop()
+{
+  delay(1000);
+}
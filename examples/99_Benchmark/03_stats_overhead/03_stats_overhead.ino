@@ -0,0 +1,80 @@
+#include <Arduino.h>
+#include <ESP32SyncKit.h>
+#include <esp_timer.h>
+
+// en: Cost of the stats policy. NoStats (default) must match the plain handle size and timing;
+// en: WithStats shows the price of the counters. One JSON object per line.
+// ja: 統計ポリシーのコスト計測。NoStats（既定）はハンドルと同じサイズ・同じ速度になるはずで、
+// ja: WithStats はカウンタ分のコストを示す。結果は1行1オブジェクトの JSON
+
+using namespace ESP32SyncKit;
+
+constexpr uint32_t kRounds = 20000;
+
+// en: Zero-cost check at compile time: NoStats adds no bytes
+// ja: コンパイル時のゼロコスト確認: NoStats はサイズを増やさない
+// en: Queue itself keeps its depth (lazy creation) next to the handle; the receiveBatch() waiter is opt-in (WithBatch)
+// ja: Queue 自体はハンドルの隣に深さ（遅延生成用）を持つ。receiveBatch() の待機者はオプトイン（WithBatch）
+struct QueueLayout
+{
+  QueueHandle_t handle;
+  uint32_t depth;
+};
+static_assert(sizeof(Queue<uint32_t>) == sizeof(QueueLayout), "NoStats must not add storage");
+static_assert(sizeof(Mutex) == sizeof(SemaphoreHandle_t), "NoStats must not add storage");
+static_assert(sizeof(BinarySemaphore) == sizeof(SemaphoreHandle_t), "NoStats must not add storage");
+
+void report(const char *bench, const char *policy, size_t bytes, int64_t us)
+{
+  Serial.printf("{\"bench\":\"%s\",\"policy\":\"%s\",\"sizeof\":%u,\"ops\":%lu,\"us\":%lld,\"ns_per_op\":%.1f}\n",
+                bench,
+                policy,
+                static_cast<unsigned>(bytes),
+                static_cast<unsigned long>(kRounds),
+                static_cast<long long>(us),
+                us * 1000.0 / kRounds);
+}
+
+template <class Q>
+void benchQueue(const char *policy)
+{
+  Q q(1);
+  uint32_t v = 0;
+  const int64_t start = esp_timer_get_time();
+  for (uint32_t i = 0; i < kRounds; ++i)
+  {
+    q.send(i, 10);
+    q.receive(v, 10);
+  }
+  report("queue_send_receive", policy, sizeof(q), esp_timer_get_time() - start);
+}
+
+template <class M>
+void benchMutex(const char *policy)
+{
+  M m;
+  const int64_t start = esp_timer_get_time();
+  for (uint32_t i = 0; i < kRounds; ++i)
+  {
+    m.lock(10);
+    m.unlock();
+  }
+  report("mutex_lock_unlock", policy, sizeof(m), esp_timer_get_time() - start);
+}
+
+void setup()
+{
+  Serial.begin(115200);
+  delay(1000);
+
+  benchQueue<Queue<uint32_t>>("NoStats");
+  benchQueue<Queue<uint32_t, WithStats>>("WithStats");
+  benchMutex<Mutex>("NoStats");
+  benchMutex<BasicMutex<WithStats>>("WithStats");
+  Serial.println("{\"bench\":\"done\"}");
+}
+
+void loop()
+{
+  delay(1000);
+}
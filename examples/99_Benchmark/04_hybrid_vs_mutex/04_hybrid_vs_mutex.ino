@@ -0,0 +1,110 @@
+#include <Arduino.h>
+#include <ESP32SyncKit.h>
+#include <esp_rom_sys.h>
+#include <esp_timer.h>
+
+// en: HybridMutex vs Mutex for short critical sections. Uncontended: one task locks/unlocks in a loop.
+// en: Light contention: a task on the other core takes the same lock every few microseconds.
+// en: One JSON object per line; "spin" is the HybridMutex spin count (0 = block immediately).
+// ja: 短いクリティカルセクションでの HybridMutex と Mutex の比較。競合なし: 1タスクで lock/unlock を繰り返す。
+// ja: 軽い競合: 別コアのタスクが数マイクロ秒ごとに同じロックを取る。
+// ja: 結果は1行1オブジェクトの JSON。"spin" は HybridMutex のスピン回数（0 = すぐにブロック）
+
+using namespace ESP32SyncKit;
+
+constexpr uint32_t kRounds = 20000;
+constexpr BaseType_t kBenchCore = 0;  // en: measuring task / ja: 計測タスク
+constexpr BaseType_t kHelperCore = 1; // en: contender task / ja: 競合タスク
+constexpr UBaseType_t kPriority = 5;
+constexpr uint32_t kHelperGapUs = 5; // en: contender pause between its locks / ja: 競合タスクのロック間隔
+
+BinarySemaphore helperDone;
+volatile uint32_t shared = 0;
+
+void report(const char *bench, const char *lock, uint32_t spin, uint32_t ops, int64_t us)
+{
+  Serial.printf("{\"bench\":\"%s\",\"lock\":\"%s\",\"spin\":%lu,\"ops\":%lu,\"us\":%lld,\"ns_per_op\":%.1f}\n",
+                bench,
+                lock,
+                static_cast<unsigned long>(spin),
+                static_cast<unsigned long>(ops),
+                static_cast<long long>(us),
+                ops ? us * 1000.0 / ops : 0.0);
+}
+
+// en: A critical section of a few hundred nanoseconds
+// ja: 数百ナノ秒のクリティカルセクション
+inline void criticalWork()
+{
+  for (int i = 0; i < 16; ++i)
+  {
+    shared = shared + 1;
+  }
+}
+
+template <class M>
+int64_t runLoop(M &m)
+{
+  const int64_t start = esp_timer_get_time();
+  for (uint32_t i = 0; i < kRounds; ++i)
+  {
+    typename M::LockGuard guard(m);
+    criticalWork();
+  }
+  return esp_timer_get_time() - start;
+}
+
+template <class M>
+void contender(void *pv)
+{
+  M *m = static_cast<M *>(pv);
+  for (uint32_t i = 0; i < kRounds; ++i)
+  {
+    {
+      typename M::LockGuard guard(*m);
+      criticalWork();
+    }
+    esp_rom_delay_us(kHelperGapUs);
+  }
+  helperDone.give();
+  vTaskDelete(nullptr);
+}
+
+template <class M>
+void benchPair(const char *lock, M &m, uint32_t spin)
+{
+  report("uncontended", lock, spin, kRounds, runLoop(m));
+
+  xTaskCreatePinnedToCore(&contender<M>, "bench-helper", 4096, &m, kPriority, nullptr, kHelperCore);
+  const int64_t us = runLoop(m);
+  helperDone.take();
+  report("light_contention", lock, spin, kRounds, us);
+}
+
+void benchTask(void * /*pv*/)
+{
+  {
+    Mutex m;
+    benchPair("Mutex", m, 0);
+  }
+  for (uint32_t spin : {0u, 50u, kHybridSpinDefault, 1000u})
+  {
+    HybridMutex m(spin);
+    benchPair("HybridMutex", m, spin);
+  }
+
+  Serial.println("{\"bench\":\"done\"}");
+  vTaskDelete(nullptr);
+}
+
+void setup()
+{
+  Serial.begin(115200);
+  delay(1000);
+  xTaskCreatePinnedToCore(benchTask, "bench", 8192, nullptr, kPriority, nullptr, kBenchCore);
+}
+
+void loop()
+{
+  delay(1000);
+}
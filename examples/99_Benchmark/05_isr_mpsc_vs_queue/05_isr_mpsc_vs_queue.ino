@@ -0,0 +1,168 @@
+#include <Arduino.h>
+#include <ESP32SyncKit.h>
+#include <esp_cpu.h>
+
+// en: ISR hand-off to one consumer task: Queue<T>::send (xQueueSendFromISR, the 01_Queue/05_irq_gpio_send path)
+// en: vs MpscQueue::trySend. A hardware timer on each core fires every kPeriodUs and times its send in CPU cycles.
+// en: The consumer drains with receiveMany(); "items_per_wakeup" above 1 means wakeups were coalesced.
+// ja: 1つの消費タスクへの ISR からの受け渡し: Queue<T>::send（xQueueSendFromISR。01_Queue/05_irq_gpio_send の経路）と
+// ja: MpscQueue::trySend の比較。各コアのハードウェアタイマーが kPeriodUs ごとに発火し、送信を CPU サイクルで計測する。
+// ja: 消費側は receiveMany() で取り出す。"items_per_wakeup" が 1 を超えれば起床がまとめられている
+
+using namespace ESP32SyncKit;
+
+constexpr uint32_t kTimerHz = 1000000; // en: 1 us timer resolution / ja: タイマー分解能 1 us
+constexpr uint32_t kPeriodUs = 50;     // en: per-core interrupt period / ja: コアごとの割り込み周期
+constexpr uint32_t kRunMs = 2000;
+constexpr uint32_t kDepth = 64;
+constexpr BaseType_t kBenchCore = 0;    // en: coordinating task / ja: 制御タスク
+constexpr BaseType_t kConsumerCore = 1; // en: consumer task / ja: 消費タスク
+constexpr UBaseType_t kPriority = 5;
+
+Queue<uint32_t> queue(kDepth);
+MpscQueue<uint32_t, kDepth> mpsc;
+Queue<BaseType_t> timersStopped(2);
+BinarySemaphore consumerDone;
+
+// en: Written only by the ISR of its core; read after the timers are stopped
+// ja: 各コアの ISR だけが書き込み、タイマー停止後に読む
+struct IsrStats
+{
+  uint32_t sends;
+  uint32_t failures;
+  uint64_t cycles;
+  uint32_t maxCycles;
+};
+IsrStats isrStats[2];
+
+volatile bool useMpsc = false;
+volatile bool consuming = false;
+uint32_t consumed = 0;
+uint32_t wakeups = 0;
+
+void IRAM_ATTR onTimer()
+{
+  IsrStats &s = isrStats[xPortGetCoreID()];
+  const uint32_t value = s.sends + s.failures;
+  const uint32_t start = esp_cpu_get_cycle_count();
+  const bool ok = useMpsc ? mpsc.trySend(value) : queue.send(value);
+  const uint32_t cycles = esp_cpu_get_cycle_count() - start;
+
+  if (!ok)
+  {
+    ++s.failures;
+    return;
+  }
+  ++s.sends;
+  s.cycles += cycles;
+  if (cycles > s.maxCycles)
+  {
+    s.maxCycles = cycles;
+  }
+}
+
+// en: The timer interrupt is allocated on the core that attaches it, so one task per core owns one timer
+// ja: タイマー割り込みは登録したコアに割り当てられるため、コアごとに1タスクが1つのタイマーを持つ
+void timerTask(void * /*pv*/)
+{
+  hw_timer_t *timer = timerBegin(kTimerHz);
+  timerAttachInterrupt(timer, &onTimer);
+  timerAlarm(timer, kPeriodUs, true, 0);
+
+  (void)ulTaskNotifyTake(pdTRUE, portMAX_DELAY); // en: stop request / ja: 停止要求
+  timerEnd(timer);
+  timersStopped.send(xPortGetCoreID());
+  vTaskDelete(nullptr);
+}
+
+void consumerTask(void * /*pv*/)
+{
+  uint32_t items[kDepth];
+  while (consuming)
+  {
+    const uint32_t n = useMpsc ? mpsc.receiveMany(items, kDepth, 10) : queue.receiveMany(items, kDepth, 10);
+    if (n != 0)
+    {
+      consumed += n;
+      ++wakeups;
+    }
+  }
+  consumerDone.give();
+  vTaskDelete(nullptr);
+}
+
+void report(const char *name, BaseType_t core, const IsrStats &s)
+{
+  const uint32_t mhz = getCpuFrequencyMhz();
+  const double avgCycles = s.sends ? static_cast<double>(s.cycles) / s.sends : 0.0;
+  Serial.printf("{\"bench\":\"isr_send\",\"queue\":\"%s\",\"core\":%ld,\"sends\":%lu,\"failures\":%lu,"
+                "\"avg_cycles\":%.1f,\"max_cycles\":%lu,\"avg_ns\":%.1f}\n",
+                name,
+                static_cast<long>(core),
+                static_cast<unsigned long>(s.sends),
+                static_cast<unsigned long>(s.failures),
+                avgCycles,
+                static_cast<unsigned long>(s.maxCycles),
+                mhz ? avgCycles * 1000.0 / mhz : 0.0);
+}
+
+void runOnce(const char *name, bool mpscMode)
+{
+  memset(isrStats, 0, sizeof(isrStats));
+  consumed = 0;
+  wakeups = 0;
+  useMpsc = mpscMode;
+  consuming = true;
+  xTaskCreatePinnedToCore(consumerTask, "bench-consumer", 4096, nullptr, kPriority, nullptr, kConsumerCore);
+
+  TaskHandle_t timerTasks[2] = {};
+  for (BaseType_t core = 0; core < 2; ++core)
+  {
+    xTaskCreatePinnedToCore(timerTask, "bench-timer", 4096, nullptr, kPriority + 1, &timerTasks[core], core);
+  }
+
+  delay(kRunMs);
+
+  for (TaskHandle_t task : timerTasks)
+  {
+    xTaskNotifyGive(task);
+  }
+  BaseType_t stoppedCore = 0;
+  timersStopped.receive(stoppedCore);
+  timersStopped.receive(stoppedCore);
+  consuming = false;
+  consumerDone.take();
+
+  report(name, 0, isrStats[0]);
+  report(name, 1, isrStats[1]);
+  Serial.printf("{\"bench\":\"consumer\",\"queue\":\"%s\",\"items\":%lu,\"wakeups\":%lu,\"items_per_wakeup\":%.2f}\n",
+                name,
+                static_cast<unsigned long>(consumed),
+                static_cast<unsigned long>(wakeups),
+                wakeups ? static_cast<double>(consumed) / wakeups : 0.0);
+}
+
+void benchTask(void * /*pv*/)
+{
+  // en: Create the Queue before any ISR touches it (lazy creation is refused in an ISR)
+  // ja: ISR が触れる前に Queue を生成する（ISR では遅延生成できない）
+  queue.begin();
+
+  runOnce("Queue", false);
+  runOnce("MpscQueue", true);
+
+  Serial.println("{\"bench\":\"done\"}");
+  vTaskDelete(nullptr);
+}
+
+void setup()
+{
+  Serial.begin(115200);
+  delay(1000);
+  xTaskCreatePinnedToCore(benchTask, "bench", 8192, nullptr, kPriority, nullptr, kBenchCore);
+}
+
+void loop()
+{
+  delay(1000);
+}
@@ -0,0 +1,190 @@
+#include <Arduino.h>
+#include <ESP32SyncKit.h>
+#include <esp_timer.h>
+
+// en: CPU-bound batch on both cores: one task doing everything, a hand-made split (two pinned tasks fed
+// en: by a Queue, each taking half the range) and WorkPool::parallelFor. The "skewed" workload makes the
+// en: first quarter of the items 8x as expensive, so the fixed halves finish at very different times.
+// en: "balance" is the less busy core's busy time divided by the busier one's (1.0 = even).
+// ja: 両コアでの CPU 負荷バッチ: 1タスクで全部処理、手作業の分割（Queue で起動される固定の2タスクが
+// ja: 範囲の半分ずつを担当）、WorkPool::parallelFor の比較。"skewed" では先頭 1/4 の要素が 8 倍重いため、
+// ja: 固定の半分ずつでは終わる時刻が大きくずれる。"balance" は暇な側のコアの稼働時間を忙しい側で割った値（1.0 = 均等）
+
+using namespace ESP32SyncKit;
+
+constexpr uint32_t kItems = 4096;
+constexpr uint32_t kGrain = 16;
+constexpr uint32_t kBaseCost = 400; // en: inner iterations per item / ja: 1要素あたりの内側の反復回数
+constexpr uint32_t kRounds = 5;
+constexpr BaseType_t kBenchCore = 0;
+constexpr UBaseType_t kPriority = 5;
+
+uint32_t results[kItems];
+bool skewed = false;
+
+// en: Deterministic busy work so every mode computes the same checksum
+// ja: どの方式でも同じチェックサムになる決定的な計算
+uint32_t work(uint32_t i)
+{
+  const uint32_t cost = (skewed && i < kItems / 4) ? kBaseCost * 8 : kBaseCost;
+  uint32_t x = i * 2654435761u + 1;
+  for (uint32_t k = 0; k < cost; ++k)
+  {
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+  }
+  return x;
+}
+
+void runRange(uint32_t begin, uint32_t end)
+{
+  for (uint32_t i = begin; i < end; ++i)
+  {
+    results[i] = work(i);
+  }
+}
+
+uint32_t checksum()
+{
+  uint32_t sum = 0;
+  for (uint32_t v : results)
+  {
+    sum += v;
+  }
+  return sum;
+}
+
+// en: Hand-made split: one helper per core, each given a fixed half through its own Queue
+// ja: 手作業の分割: コアごとの補助タスクに、それぞれの Queue で固定の半分を渡す
+struct Range
+{
+  uint32_t begin;
+  uint32_t end;
+};
+Queue<Range> halves[2] = {Queue<Range>(1), Queue<Range>(1)};
+Queue<int64_t> halfDone(2);
+
+void halfTask(void *pv)
+{
+  Queue<Range> &in = *static_cast<Queue<Range> *>(pv);
+  Range r;
+  while (in.receive(r))
+  {
+    const int64_t start = esp_timer_get_time();
+    runRange(r.begin, r.end);
+    halfDone.send(esp_timer_get_time() - start);
+  }
+}
+
+WorkPool<> pool;
+
+void report(const char *mode, int64_t us, int64_t serialUs, int64_t busy0, int64_t busy1, uint32_t sum)
+{
+  const int64_t hi = busy0 > busy1 ? busy0 : busy1;
+  const int64_t lo = busy0 > busy1 ? busy1 : busy0;
+  Serial.printf("{\"bench\":\"workpool\",\"workload\":\"%s\",\"mode\":\"%s\",\"items\":%lu,\"us\":%lld,"
+                "\"speedup\":%.2f,\"busy_us\":[%lld,%lld],\"balance\":%.2f,\"checksum\":%lu}\n",
+                skewed ? "skewed" : "uniform",
+                mode,
+                static_cast<unsigned long>(kItems),
+                static_cast<long long>(us),
+                us ? static_cast<double>(serialUs) / us : 0.0,
+                static_cast<long long>(busy0),
+                static_cast<long long>(busy1),
+                hi ? static_cast<double>(lo) / hi : 0.0,
+                static_cast<unsigned long>(sum));
+}
+
+void runWorkload(bool skew)
+{
+  skewed = skew;
+
+  // en: Best of kRounds for each mode
+  // ja: 各方式とも kRounds 回のうち最良値
+  int64_t serialUs = INT64_MAX;
+  for (uint32_t r = 0; r < kRounds; ++r)
+  {
+    const int64_t start = esp_timer_get_time();
+    runRange(0, kItems);
+    const int64_t us = esp_timer_get_time() - start;
+    serialUs = us < serialUs ? us : serialUs;
+  }
+  report("serial", serialUs, serialUs, serialUs, 0, checksum());
+
+  int64_t splitUs = INT64_MAX;
+  int64_t splitBusy[2] = {};
+  for (uint32_t r = 0; r < kRounds; ++r)
+  {
+    memset(results, 0, sizeof(results));
+    const int64_t start = esp_timer_get_time();
+    halves[0].send(Range{0, kItems / 2});
+    halves[1].send(Range{kItems / 2, kItems});
+    int64_t busy[2] = {};
+    halfDone.receive(busy[0]);
+    halfDone.receive(busy[1]);
+    const int64_t us = esp_timer_get_time() - start;
+    if (us < splitUs)
+    {
+      splitUs = us;
+      splitBusy[0] = busy[0];
+      splitBusy[1] = busy[1];
+    }
+  }
+  report("static_split", splitUs, serialUs, splitBusy[0], splitBusy[1], checksum());
+
+  int64_t poolUs = INT64_MAX;
+  WorkerStats poolBusy[2] = {};
+  for (uint32_t r = 0; r < kRounds; ++r)
+  {
+    memset(results, 0, sizeof(results));
+    pool.resetStats();
+    const int64_t start = esp_timer_get_time();
+    pool.parallelFor(0, kItems, kGrain, [](uint32_t begin, uint32_t end) { runRange(begin, end); });
+    const int64_t us = esp_timer_get_time() - start;
+    if (us < poolUs)
+    {
+      poolUs = us;
+      poolBusy[0] = pool.workerStats(0);
+      poolBusy[1] = pool.workerStats(1);
+    }
+  }
+  report("workpool", poolUs, serialUs, static_cast<int64_t>(poolBusy[0].busyUs), static_cast<int64_t>(poolBusy[1].busyUs), checksum());
+  Serial.printf("{\"bench\":\"workpool_steals\",\"workload\":\"%s\",\"steals\":[%lu,%lu],\"jobs\":[%lu,%lu]}\n",
+                skewed ? "skewed" : "uniform",
+                static_cast<unsigned long>(poolBusy[0].steals),
+                static_cast<unsigned long>(poolBusy[1].steals),
+                static_cast<unsigned long>(poolBusy[0].jobs),
+                static_cast<unsigned long>(poolBusy[1].jobs));
+}
+
+void benchTask(void * /*pv*/)
+{
+  // en: Same priority for every worker so no mode gets an unfair scheduler advantage
+  // ja: どの方式も同じ優先度で動かし、スケジューラ上の有利不利をなくす
+  for (BaseType_t core = 0; core < 2; ++core)
+  {
+    xTaskCreatePinnedToCore(halfTask, "bench-half", 4096, &halves[core], kPriority - 1, nullptr, core);
+  }
+  WorkPoolConfig config;
+  config.priority = kPriority - 1;
+  pool.begin(config);
+
+  runWorkload(false);
+  runWorkload(true);
+
+  Serial.println("{\"bench\":\"done\"}");
+  vTaskDelete(nullptr);
+}
+
+void setup()
+{
+  Serial.begin(115200);
+  delay(1000);
+  xTaskCreatePinnedToCore(benchTask, "bench", 8192, nullptr, kPriority, nullptr, kBenchCore);
+}
+
+void loop()
+{
+  delay(1000);
+}
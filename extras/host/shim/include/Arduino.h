@@ -0,0 +1,66 @@
+#pragma once
+
+// en: Host stand-in for the arduino-esp32 core: Serial on stdout, the time functions and the hardware timer API.
+// en: The timer interrupt runs on its own thread inside an ISR scope, so xPortInIsrContext() is true there.
+// ja: arduino-esp32 コアのホスト向け代替: 標準出力への Serial、時間関数、ハードウェアタイマー API。
+// ja: タイマー割り込みは専用スレッドの ISR スコープ内で動くため、そこでは xPortInIsrContext() が true になる
+
+#include <math.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <freertos/queue.h>
+#include <freertos/semphr.h>
+#include <esp_log.h>
+
+#define IRAM_ATTR
+#define DRAM_ATTR
+
+class Print
+{
+public:
+  size_t printf(const char *format, ...) __attribute__((format(printf, 2, 3)));
+  size_t print(const char *text);
+  size_t print(char c);
+  size_t print(int value);
+  size_t print(unsigned int value);
+  size_t print(long value);
+  size_t print(unsigned long value);
+  size_t print(double value, int digits = 2);
+  size_t println();
+  template <class T>
+  size_t println(T value)
+  {
+    const size_t n = print(value);
+    return n + println();
+  }
+};
+
+class HardwareSerial : public Print
+{
+public:
+  void begin(unsigned long /*baud*/) {}
+};
+
+extern HardwareSerial Serial;
+
+void delay(uint32_t ms);
+unsigned long millis(void);
+unsigned long micros(void);
+uint32_t getCpuFrequencyMhz(void);
+
+typedef struct hw_timer_s hw_timer_t;
+hw_timer_t *timerBegin(uint32_t frequency);
+void timerEnd(hw_timer_t *timer);
+void timerAttachInterrupt(hw_timer_t *timer, void (*userFunc)(void));
+void timerAlarm(hw_timer_t *timer, uint64_t alarm_value, bool autoreload, uint64_t reload_count);
+
+// en: Implemented by the sketch
+// ja: スケッチ側で実装する
+void setup(void);
+void loop(void);
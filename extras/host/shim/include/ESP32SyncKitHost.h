@@ -0,0 +1,32 @@
+#pragma once
+
+// en: Test hooks of the host shim (not part of the library API)
+// ja: ホスト用シムのテスト用フック（ライブラリ API ではない）
+
+#include <esp_log.h>
+#include <stdint.h>
+
+namespace ESP32SyncKitHost
+{
+  // en: Runs the enclosed code as if it were an interrupt handler: xPortInIsrContext() returns true and
+  // en: blocking FreeRTOS calls abort. Nests.
+  // ja: 囲んだコードを割り込みハンドラとして実行する: xPortInIsrContext() が true を返し、ブロッキングする
+  // ja: FreeRTOS 呼び出しは abort する。入れ子にできる
+  class IsrScope
+  {
+  public:
+    IsrScope();
+    ~IsrScope();
+    IsrScope(const IsrScope &) = delete;
+    IsrScope &operator=(const IsrScope &) = delete;
+  };
+
+  // en: Number of ESP_LOGx lines written at a level since the last resetLogCounts()
+  // ja: 直近の resetLogCounts() 以降に出力された ESP_LOGx の行数（レベル別）
+  uint32_t logCount(esp_log_level_t level);
+  void resetLogCounts();
+
+  // en: Silence log output (lines are still counted)
+  // ja: ログ出力を止める（行数は数え続ける）
+  void setLogEcho(bool echo);
+} // namespace ESP32SyncKitHost
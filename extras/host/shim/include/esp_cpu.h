@@ -0,0 +1,7 @@
+#pragma once
+
+#include <stdint.h>
+
+// en: Steady-clock nanoseconds; getCpuFrequencyMhz() reports 1000 so cycles convert back to ns
+// ja: steady clock のナノ秒。getCpuFrequencyMhz() は 1000 を返すため、サイクルはそのまま ns に換算できる
+uint32_t esp_cpu_get_cycle_count(void);
@@ -0,0 +1,7 @@
+#pragma once
+
+#include <stdint.h>
+
+// en: Busy-waits like the ROM routine; it does not sleep
+// ja: ROM の関数と同じくビジーウェイトする。スリープはしない
+void esp_rom_delay_us(uint32_t us);
@@ -0,0 +1,7 @@
+#pragma once
+
+#include <stdint.h>
+
+// en: Microseconds since the process started (steady clock)
+// ja: プロセス開始からのマイクロ秒（steady clock）
+int64_t esp_timer_get_time(void);
@@ -0,0 +1,100 @@
+#pragma once
+
+// en: Host (Linux) stand-in for the ESP-IDF FreeRTOS headers. Tasks are std::threads, kernel objects are guarded
+// en: by one kernel lock, and one tick is one millisecond. Only the API used by ESP32SyncKit and its benchmark
+// en: sketches is provided. Timing follows the host scheduler, not the ESP32: use it to catch regressions in
+// en: the library layer, not to predict device numbers.
+// ja: ESP-IDF の FreeRTOS ヘッダーのホスト（Linux）向け代替。タスクは std::thread、カーネルオブジェクトは1つの
+// ja: カーネルロックで保護し、1 tick = 1 ミリ秒。ESP32SyncKit とベンチマークスケッチが使う API だけを提供する。
+// ja: タイミングはホストのスケジューラに従い ESP32 とは異なる: 実機の数値の予測ではなく、ライブラリ層の
+// ja: 性能劣化の検出に使う
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+typedef uint32_t TickType_t;
+typedef int BaseType_t;
+typedef unsigned int UBaseType_t;
+typedef uint8_t StackType_t;
+
+#define pdFALSE ((BaseType_t)0)
+#define pdTRUE ((BaseType_t)1)
+#define pdFAIL pdFALSE
+#define pdPASS pdTRUE
+#define errQUEUE_EMPTY ((BaseType_t)0)
+#define errQUEUE_FULL ((BaseType_t)0)
+
+#define configTICK_RATE_HZ 1000
+#define configMAX_PRIORITIES 25
+#define configMAX_TASK_NAME_LEN 16
+#define configNUMBER_OF_CORES 2
+#define configUSE_QUEUE_SETS 1
+#ifndef configTASK_NOTIFICATION_ARRAY_ENTRIES
+#define configTASK_NOTIFICATION_ARRAY_ENTRIES 3
+#endif
+
+#define portMAX_DELAY ((TickType_t)0xffffffffUL)
+#define portTICK_PERIOD_MS ((TickType_t)1000 / configTICK_RATE_HZ)
+#define portNUM_PROCESSORS configNUMBER_OF_CORES
+#define tskNO_AFFINITY ((BaseType_t)0x7fffffff)
+
+#define pdMS_TO_TICKS(xTimeInMs) ((TickType_t)(((uint64_t)(xTimeInMs) * (uint64_t)configTICK_RATE_HZ) / 1000U))
+#define pdTICKS_TO_MS(xTicks) ((uint32_t)(((uint64_t)(xTicks) * 1000U) / (uint64_t)configTICK_RATE_HZ))
+
+#define configASSERT(x)                                                                        \
+  do                                                                                           \
+  {                                                                                            \
+    if (!(x))                                                                                  \
+    {                                                                                          \
+      fprintf(stderr, "configASSERT(%s) failed at %s:%d\n", #x, __FILE__, __LINE__);          \
+      abort();                                                                                 \
+    }                                                                                          \
+  } while (0)
+
+// en: Recursive spinlock like ESP-IDF's; owner 0 = free
+// ja: ESP-IDF と同じ再帰スピンロック。owner 0 = 空き
+typedef struct
+{
+  uint32_t owner;
+  uint32_t count;
+} portMUX_TYPE;
+
+#define portMUX_INITIALIZER_UNLOCKED {0, 0}
+
+void vPortEnterCritical(portMUX_TYPE *mux);
+void vPortExitCritical(portMUX_TYPE *mux);
+BaseType_t xPortInIsrContext(void);
+BaseType_t xPortGetCoreID(void);
+void vPortYield(void);
+
+#define portENTER_CRITICAL(mux) vPortEnterCritical(mux)
+#define portEXIT_CRITICAL(mux) vPortExitCritical(mux)
+#define portENTER_CRITICAL_ISR(mux) vPortEnterCritical(mux)
+#define portEXIT_CRITICAL_ISR(mux) vPortExitCritical(mux)
+#define portENTER_CRITICAL_SAFE(mux) vPortEnterCritical(mux)
+#define portEXIT_CRITICAL_SAFE(mux) vPortExitCritical(mux)
+#define portYIELD() vPortYield()
+#define portYIELD_FROM_ISR(...) ((void)0)
+
+// en: Static-allocation buffers are accepted and ignored; the shim allocates on the heap
+// ja: 静的確保用バッファは受け取るが使わない。シムはヒープに確保する
+typedef struct
+{
+  void *reserved[4];
+} StaticQueue_t;
+typedef StaticQueue_t StaticSemaphore_t;
+typedef struct
+{
+  void *reserved[4];
+} StaticEventGroup_t;
+typedef struct
+{
+  void *reserved[4];
+} StaticStreamBuffer_t;
+typedef StaticStreamBuffer_t StaticMessageBuffer_t;
+typedef struct
+{
+  void *reserved[4];
+} StaticTask_t;
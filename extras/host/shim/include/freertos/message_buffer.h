@@ -0,0 +1,23 @@
+#pragma once
+
+#include "stream_buffer.h"
+
+typedef StreamBufferHandle_t MessageBufferHandle_t;
+
+#define xMessageBufferCreate(xBufferSizeBytes) xStreamBufferGenericCreate((xBufferSizeBytes), 0, pdTRUE)
+#define xMessageBufferCreateStatic(xBufferSizeBytes, pucMessageBufferStorageArea, pxStaticMessageBuffer) \
+  ((void)(pucMessageBufferStorageArea), (void)(pxStaticMessageBuffer), xMessageBufferCreate((xBufferSizeBytes)))
+#define vMessageBufferDelete(xMessageBuffer) vStreamBufferDelete((xMessageBuffer))
+#define xMessageBufferSend(xMessageBuffer, pvTxData, xDataLengthBytes, xTicksToWait) \
+  xStreamBufferSend((xMessageBuffer), (pvTxData), (xDataLengthBytes), (xTicksToWait))
+#define xMessageBufferSendFromISR(xMessageBuffer, pvTxData, xDataLengthBytes, pxHigherPriorityTaskWoken) \
+  xStreamBufferSendFromISR((xMessageBuffer), (pvTxData), (xDataLengthBytes), (pxHigherPriorityTaskWoken))
+#define xMessageBufferReceive(xMessageBuffer, pvRxData, xBufferLengthBytes, xTicksToWait) \
+  xStreamBufferReceive((xMessageBuffer), (pvRxData), (xBufferLengthBytes), (xTicksToWait))
+#define xMessageBufferReceiveFromISR(xMessageBuffer, pvRxData, xBufferLengthBytes, pxHigherPriorityTaskWoken) \
+  xStreamBufferReceiveFromISR((xMessageBuffer), (pvRxData), (xBufferLengthBytes), (pxHigherPriorityTaskWoken))
+#define xMessageBufferSpacesAvailable(xMessageBuffer) xStreamBufferSpacesAvailable((xMessageBuffer))
+#define xMessageBufferNextLengthBytes(xMessageBuffer) xStreamBufferNextMessageLengthBytes((xMessageBuffer))
+#define xMessageBufferReset(xMessageBuffer) xStreamBufferReset((xMessageBuffer))
+#define xMessageBufferIsEmpty(xMessageBuffer) xStreamBufferIsEmpty((xMessageBuffer))
+#define xMessageBufferIsFull(xMessageBuffer) xStreamBufferIsFull((xMessageBuffer))
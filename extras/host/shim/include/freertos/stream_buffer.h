@@ -0,0 +1,26 @@
+#pragma once
+
+#include "task.h"
+
+typedef struct StreamBufferDef_t *StreamBufferHandle_t;
+
+StreamBufferHandle_t xStreamBufferGenericCreate(size_t xBufferSizeBytes, size_t xTriggerLevelBytes, BaseType_t xIsMessageBuffer);
+void vStreamBufferDelete(StreamBufferHandle_t xStreamBuffer);
+
+size_t xStreamBufferSend(StreamBufferHandle_t xStreamBuffer, const void *pvTxData, size_t xDataLengthBytes, TickType_t xTicksToWait);
+size_t xStreamBufferSendFromISR(StreamBufferHandle_t xStreamBuffer, const void *pvTxData, size_t xDataLengthBytes,
+                                BaseType_t *pxHigherPriorityTaskWoken);
+size_t xStreamBufferReceive(StreamBufferHandle_t xStreamBuffer, void *pvRxData, size_t xBufferLengthBytes, TickType_t xTicksToWait);
+size_t xStreamBufferReceiveFromISR(StreamBufferHandle_t xStreamBuffer, void *pvRxData, size_t xBufferLengthBytes,
+                                   BaseType_t *pxHigherPriorityTaskWoken);
+size_t xStreamBufferBytesAvailable(StreamBufferHandle_t xStreamBuffer);
+size_t xStreamBufferSpacesAvailable(StreamBufferHandle_t xStreamBuffer);
+size_t xStreamBufferNextMessageLengthBytes(StreamBufferHandle_t xStreamBuffer);
+BaseType_t xStreamBufferSetTriggerLevel(StreamBufferHandle_t xStreamBuffer, size_t xTriggerLevel);
+BaseType_t xStreamBufferReset(StreamBufferHandle_t xStreamBuffer);
+BaseType_t xStreamBufferIsEmpty(StreamBufferHandle_t xStreamBuffer);
+BaseType_t xStreamBufferIsFull(StreamBufferHandle_t xStreamBuffer);
+
+#define xStreamBufferCreate(xBufferSizeBytes, xTriggerLevelBytes) xStreamBufferGenericCreate((xBufferSizeBytes), (xTriggerLevelBytes), pdFALSE)
+#define xStreamBufferCreateStatic(xBufferSizeBytes, xTriggerLevelBytes, pucStreamBufferStorageArea, pxStaticStreamBuffer) \
+  ((void)(pucStreamBufferStorageArea), (void)(pxStaticStreamBuffer), xStreamBufferCreate((xBufferSizeBytes), (xTriggerLevelBytes)))
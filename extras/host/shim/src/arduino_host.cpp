@@ -0,0 +1,211 @@
+// en: arduino-esp32 and esp_log stand-ins: Serial writes to stdout, ESP_LOGx to stderr (so stdout stays pure JSON
+// en: for the benchmarks), and each hardware timer is a thread that calls its handler inside an ISR scope.
+// ja: arduino-esp32 と esp_log の代替: Serial は標準出力、ESP_LOGx は標準エラー出力へ書く（ベンチマークの標準出力を
+// ja: JSON だけに保つため）。ハードウェアタイマーはハンドラを ISR スコープ内で呼ぶスレッドで表す
+
+#include <Arduino.h>
+#include <esp_log.h>
+#include <esp_timer.h>
+
+#include "ESP32SyncKitHost.h"
+#include "host_internal.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <stdarg.h>
+#include <string>
+#include <thread>
+
+HardwareSerial Serial;
+
+namespace
+{
+  std::mutex &serialLock()
+  {
+    static std::mutex lock;
+    return lock;
+  }
+
+  std::string pendingLine;
+  ESP32SyncKitHost::detail::SerialLineHook lineHook = nullptr;
+
+  std::atomic<uint32_t> logCounts[ESP_LOG_VERBOSE + 1];
+  std::atomic<bool> logEcho{true};
+
+  size_t serialWrite(const char *text, size_t length)
+  {
+    std::lock_guard<std::mutex> lock(serialLock());
+    fwrite(text, 1, length, stdout);
+    for (size_t i = 0; i < length; ++i)
+    {
+      if (text[i] != '\n')
+      {
+        pendingLine.push_back(text[i]);
+        continue;
+      }
+      fflush(stdout);
+      if (!pendingLine.empty() && pendingLine.back() == '\r')
+      {
+        pendingLine.pop_back();
+      }
+      if (lineHook != nullptr)
+      {
+        lineHook(pendingLine.c_str());
+      }
+      pendingLine.clear();
+    }
+    return length;
+  }
+
+  size_t serialPrintf(const char *format, va_list args)
+  {
+    char line[256];
+    va_list copy;
+    va_copy(copy, args);
+    const int n = vsnprintf(line, sizeof(line), format, copy);
+    va_end(copy);
+    if (n < 0)
+    {
+      return 0;
+    }
+    if (static_cast<size_t>(n) < sizeof(line))
+    {
+      return serialWrite(line, static_cast<size_t>(n));
+    }
+    std::string longLine(static_cast<size_t>(n) + 1, '\0');
+    vsnprintf(&longLine[0], longLine.size(), format, args);
+    return serialWrite(longLine.c_str(), static_cast<size_t>(n));
+  }
+} // namespace
+
+struct hw_timer_s
+{
+  uint32_t frequency = 0;
+  void (*handler)() = nullptr;
+  BaseType_t core = 0;
+  std::atomic<bool> running{false};
+  std::thread thread;
+};
+
+namespace ESP32SyncKitHost
+{
+  uint32_t logCount(esp_log_level_t level) { return logCounts[level].load(); }
+
+  void resetLogCounts()
+  {
+    for (std::atomic<uint32_t> &count : logCounts)
+    {
+      count.store(0);
+    }
+  }
+
+  void setLogEcho(bool echo) { logEcho.store(echo); }
+
+  namespace detail
+  {
+    void setSerialLineHook(SerialLineHook hook)
+    {
+      std::lock_guard<std::mutex> lock(serialLock());
+      lineHook = hook;
+    }
+  } // namespace detail
+} // namespace ESP32SyncKitHost
+
+// ---- esp_log ----
+
+void esp_log_write(esp_log_level_t level, const char * /*tag*/, const char *format, ...)
+{
+  logCounts[level].fetch_add(1);
+  if (!logEcho.load())
+  {
+    return;
+  }
+  va_list args;
+  va_start(args, format);
+  vfprintf(stderr, format, args);
+  va_end(args);
+}
+
+uint32_t esp_log_timestamp(void) { return static_cast<uint32_t>(esp_timer_get_time() / 1000); }
+
+// ---- Serial ----
+
+size_t Print::printf(const char *format, ...)
+{
+  va_list args;
+  va_start(args, format);
+  const size_t n = serialPrintf(format, args);
+  va_end(args);
+  return n;
+}
+
+size_t Print::print(const char *text) { return serialWrite(text, strlen(text)); }
+size_t Print::print(char c) { return serialWrite(&c, 1); }
+size_t Print::print(int value) { return printf("%d", value); }
+size_t Print::print(unsigned int value) { return printf("%u", value); }
+size_t Print::print(long value) { return printf("%ld", value); }
+size_t Print::print(unsigned long value) { return printf("%lu", value); }
+size_t Print::print(double value, int digits) { return printf("%.*f", digits, value); }
+size_t Print::println() { return serialWrite("\r\n", 2); }
+
+// ---- time ----
+
+void delay(uint32_t ms) { vTaskDelay(pdMS_TO_TICKS(ms)); }
+unsigned long millis(void) { return static_cast<unsigned long>(esp_timer_get_time() / 1000); }
+unsigned long micros(void) { return static_cast<unsigned long>(esp_timer_get_time()); }
+uint32_t getCpuFrequencyMhz(void) { return 1000; }
+
+// ---- hardware timers ----
+
+hw_timer_t *timerBegin(uint32_t frequency)
+{
+  hw_timer_t *timer = new hw_timer_t();
+  timer->frequency = frequency;
+  timer->core = xPortGetCoreID(); // en: the interrupt is allocated on the calling core / ja: 割り込みは呼び出し元コアに割り当てられる
+  return timer;
+}
+
+void timerAttachInterrupt(hw_timer_t *timer, void (*userFunc)(void)) { timer->handler = userFunc; }
+
+void timerAlarm(hw_timer_t *timer, uint64_t alarm_value, bool autoreload, uint64_t /*reload_count*/)
+{
+  if (timer->running.exchange(false) && timer->thread.joinable())
+  {
+    timer->thread.join();
+  }
+  const std::chrono::nanoseconds period(alarm_value * 1000000000ull / timer->frequency);
+  timer->running.store(true);
+  timer->thread = std::thread([timer, period, autoreload] {
+    ESP32SyncKitHost::detail::bindThreadToCore(timer->core);
+    ESP32SyncKitHost::IsrScope isr;
+    std::chrono::steady_clock::time_point next = std::chrono::steady_clock::now() + period;
+    while (timer->running.load())
+    {
+      std::this_thread::sleep_until(next);
+      if (!timer->running.load())
+      {
+        break;
+      }
+      timer->handler();
+      if (!autoreload)
+      {
+        break;
+      }
+      // en: Late alarms are merged, as a pending interrupt is on hardware
+      // ja: 遅れたアラームはハードウェアの保留割り込みと同じく1回にまとめる
+      next = std::max(next + period, std::chrono::steady_clock::now());
+    }
+  });
+}
+
+void timerEnd(hw_timer_t *timer)
+{
+  timer->running.store(false);
+  if (timer->thread.joinable())
+  {
+    timer->thread.join();
+  }
+  delete timer;
+}
@@ -0,0 +1,1120 @@
+// en: FreeRTOS kernel emulation on std::thread. Every kernel object is guarded by one kernel lock and each object
+// en: owns a condition variable for its waiters. Priorities are recorded but not enforced, and every task runs
+// en: concurrently with the others, as tasks pinned to different cores do on the ESP32.
+// ja: std::thread 上の FreeRTOS カーネルのエミュレーション。すべてのカーネルオブジェクトを1つのカーネルロックで
+// ja: 保護し、各オブジェクトが待機者用の条件変数を持つ。優先度は記録するだけで反映せず、すべてのタスクは
+// ja: ESP32 で別コアに固定したタスクのように互いに並行して動く
+
+#include <freertos/FreeRTOS.h>
+#include <freertos/event_groups.h>
+#include <freertos/queue.h>
+#include <freertos/semphr.h>
+#include <freertos/stream_buffer.h>
+#include <freertos/task.h>
+
+#include <esp_cpu.h>
+#include <esp_rom_sys.h>
+#include <esp_timer.h>
+
+#include "ESP32SyncKitHost.h"
+#include "host_internal.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <new>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+struct tskTaskControlBlock
+{
+  char name[configMAX_TASK_NAME_LEN] = {};
+  UBaseType_t priority = 1;
+  BaseType_t core = 1;
+  uint32_t notifyValue[configTASK_NOTIFICATION_ARRAY_ENTRIES] = {};
+  uint8_t notifyState[configTASK_NOTIFICATION_ARRAY_ENTRIES] = {};
+  std::condition_variable cv;
+};
+
+struct QueueDefinition
+{
+  enum Kind
+  {
+    kQueue,
+    kSemaphore,
+    kMutex,
+    kSet
+  };
+
+  Kind kind = kQueue;
+  UBaseType_t length = 0;
+  UBaseType_t itemSize = 0;
+  UBaseType_t count = 0;
+  UBaseType_t head = 0;
+  std::vector<uint8_t> storage;
+  TaskHandle_t holder = nullptr;           // en: kMutex / ja: kMutex 用
+  QueueDefinition *set = nullptr;          // en: set this member belongs to / ja: 所属するキューセット
+  std::deque<QueueDefinition *> members;   // en: kSet: members with data, in arrival order / ja: kSet: データのあるメンバー（到着順）
+  std::condition_variable cv;
+};
+
+struct EventGroupDef_t
+{
+  EventBits_t bits = 0;
+  std::condition_variable cv;
+};
+
+struct StreamBufferDef_t
+{
+  bool message = false;
+  size_t size = 0;
+  size_t trigger = 1;
+  size_t head = 0;
+  size_t used = 0;
+  std::vector<uint8_t> data;
+  std::condition_variable cv;
+};
+
+namespace
+{
+  using Clock = std::chrono::steady_clock;
+
+  constexpr uint8_t kNotWaiting = 0;
+  constexpr uint8_t kWaiting = 1;
+  constexpr uint8_t kReceived = 2;
+  constexpr EventBits_t kEventBitsMask = 0x00ffffffu; // en: top 8 bits are reserved by FreeRTOS / ja: 上位8ビットは FreeRTOS の予約
+  constexpr size_t kMessageHeader = sizeof(size_t);
+
+  struct TaskExit
+  {
+  };
+
+  Clock::time_point startTime()
+  {
+    static const Clock::time_point start = Clock::now();
+    return start;
+  }
+
+  std::mutex &kernelLock()
+  {
+    static std::mutex lock;
+    return lock;
+  }
+
+  std::atomic<uint32_t> nextOwnerId{1};
+  thread_local tskTaskControlBlock *currentTcb = nullptr;
+  thread_local BaseType_t currentCore = 1; // en: threads not created as tasks act as Arduino's loopTask (core 1) / ja: タスク以外のスレッドは Arduino の loopTask（コア1）扱い
+  thread_local int isrDepth = 0;
+  thread_local int criticalDepth = 0;
+  thread_local uint32_t ownerId = 0;
+
+  [[noreturn]] void fatal(const char *api, const char *what)
+  {
+    fprintf(stderr, "host FreeRTOS: %s %s\n", api, what);
+    fflush(stderr);
+    abort();
+  }
+
+  // en: Task-level API: calling it from an ISR is a bug on the ESP32 as well
+  // ja: タスク用 API: ESP32 でも ISR から呼ぶのはバグ
+  void requireTask(const char *api)
+  {
+    if (isrDepth > 0)
+    {
+      fatal(api, "called from ISR context");
+    }
+  }
+
+  tskTaskControlBlock *self()
+  {
+    if (currentTcb == nullptr)
+    {
+      currentTcb = new tskTaskControlBlock();
+      strncpy(currentTcb->name, "loopTask", sizeof(currentTcb->name) - 1);
+      currentTcb->core = currentCore;
+    }
+    return currentTcb;
+  }
+
+  template <class Ready>
+  bool blockUntil(const char *api, std::unique_lock<std::mutex> &lock, std::condition_variable &cv, TickType_t ticks, Ready ready)
+  {
+    if (ready())
+    {
+      return true;
+    }
+    if (ticks == 0)
+    {
+      return false;
+    }
+    if (criticalDepth > 0)
+    {
+      fatal(api, "would block inside a critical section");
+    }
+    if (ticks == portMAX_DELAY)
+    {
+      cv.wait(lock, ready);
+      return true;
+    }
+    return cv.wait_for(lock, std::chrono::milliseconds(pdTICKS_TO_MS(ticks)), ready);
+  }
+
+  void setTaskWoken(BaseType_t *woken)
+  {
+    if (woken != nullptr)
+    {
+      *woken = pdFALSE;
+    }
+  }
+
+  // ---- queues and semaphores ----
+
+  QueueHandle_t newQueue(QueueDefinition::Kind kind, UBaseType_t length, UBaseType_t itemSize, UBaseType_t initialCount)
+  {
+    QueueDefinition *q = new (std::nothrow) QueueDefinition();
+    if (q == nullptr)
+    {
+      return nullptr;
+    }
+    q->kind = kind;
+    q->length = length;
+    q->itemSize = itemSize;
+    q->count = initialCount;
+    q->storage.resize(static_cast<size_t>(length) * itemSize);
+    return q;
+  }
+
+  void announceToSet(QueueDefinition *q)
+  {
+    if (q->set != nullptr)
+    {
+      q->set->members.push_back(q);
+      ++q->set->count;
+      q->set->cv.notify_all();
+    }
+  }
+
+  void pushItem(QueueDefinition *q, const void *item, bool front)
+  {
+    if (q->kind == QueueDefinition::kQueue && q->itemSize != 0)
+    {
+      UBaseType_t slot;
+      if (front)
+      {
+        q->head = (q->head + q->length - 1) % q->length;
+        slot = q->head;
+      }
+      else
+      {
+        slot = (q->head + q->count) % q->length;
+      }
+      memcpy(&q->storage[static_cast<size_t>(slot) * q->itemSize], item, q->itemSize);
+    }
+    if (q->kind == QueueDefinition::kMutex)
+    {
+      q->holder = nullptr;
+    }
+    ++q->count;
+    q->cv.notify_all();
+    announceToSet(q);
+  }
+
+  void copyFront(QueueDefinition *q, void *out)
+  {
+    if (q->kind == QueueDefinition::kQueue && q->itemSize != 0 && out != nullptr)
+    {
+      memcpy(out, &q->storage[static_cast<size_t>(q->head) * q->itemSize], q->itemSize);
+    }
+  }
+
+  void popItem(QueueDefinition *q, void *out)
+  {
+    copyFront(q, out);
+    if (q->kind == QueueDefinition::kQueue)
+    {
+      q->head = (q->head + 1) % q->length;
+    }
+    if (q->kind == QueueDefinition::kMutex)
+    {
+      q->holder = self();
+    }
+    --q->count;
+    q->cv.notify_all();
+  }
+
+  BaseType_t queueSend(const char *api, QueueHandle_t q, const void *item, TickType_t ticks, bool front)
+  {
+    std::unique_lock<std::mutex> lock(kernelLock());
+    if (!blockUntil(api, lock, q->cv, ticks, [q] { return q->count < q->length; }))
+    {
+      return errQUEUE_FULL;
+    }
+    pushItem(q, item, front);
+    return pdPASS;
+  }
+
+  BaseType_t queueReceive(const char *api, QueueHandle_t q, void *out, TickType_t ticks)
+  {
+    std::unique_lock<std::mutex> lock(kernelLock());
+    if (!blockUntil(api, lock, q->cv, ticks, [q] { return q->count != 0; }))
+    {
+      return errQUEUE_EMPTY;
+    }
+    popItem(q, out);
+    return pdPASS;
+  }
+
+  BaseType_t queueOverwrite(QueueHandle_t q, const void *item)
+  {
+    std::lock_guard<std::mutex> lock(kernelLock());
+    configASSERT(q->length == 1);
+    if (q->count == 1)
+    {
+      memcpy(q->storage.data(), item, q->itemSize);
+      q->cv.notify_all();
+      return pdPASS;
+    }
+    pushItem(q, item, false);
+    return pdPASS;
+  }
+
+  // ---- stream and message buffers ----
+
+  void ringWrite(StreamBufferDef_t *sb, const void *src, size_t n)
+  {
+    const uint8_t *bytes = static_cast<const uint8_t *>(src);
+    for (size_t i = 0; i < n; ++i)
+    {
+      sb->data[(sb->head + sb->used + i) % sb->size] = bytes[i];
+    }
+    sb->used += n;
+  }
+
+  void ringPeek(const StreamBufferDef_t *sb, void *dst, size_t n)
+  {
+    uint8_t *bytes = static_cast<uint8_t *>(dst);
+    for (size_t i = 0; i < n; ++i)
+    {
+      bytes[i] = sb->data[(sb->head + i) % sb->size];
+    }
+  }
+
+  void ringDrop(StreamBufferDef_t *sb, size_t n)
+  {
+    sb->head = (sb->head + n) % sb->size;
+    sb->used -= n;
+  }
+
+  size_t nextMessageLength(const StreamBufferDef_t *sb)
+  {
+    size_t length = 0;
+    if (sb->used >= kMessageHeader)
+    {
+      ringPeek(sb, &length, kMessageHeader);
+    }
+    return length;
+  }
+
+  size_t streamSend(const char *api, StreamBufferHandle_t sb, const void *data, size_t length, TickType_t ticks)
+  {
+    std::unique_lock<std::mutex> lock(kernelLock());
+    if (length == 0)
+    {
+      return 0;
+    }
+    const size_t required = sb->message ? length + kMessageHeader : std::min(length, sb->size);
+    if (required > sb->size)
+    {
+      return 0;
+    }
+    const bool fits = blockUntil(api, lock, sb->cv, ticks, [sb, required] { return sb->size - sb->used >= required; });
+    if (sb->message)
+    {
+      if (!fits)
+      {
+        return 0;
+      }
+      ringWrite(sb, &length, kMessageHeader);
+      ringWrite(sb, data, length);
+      sb->cv.notify_all();
+      return length;
+    }
+    const size_t n = std::min(length, sb->size - sb->used);
+    ringWrite(sb, data, n);
+    if (n != 0)
+    {
+      sb->cv.notify_all();
+    }
+    return n;
+  }
+
+  size_t streamReceive(const char *api, StreamBufferHandle_t sb, void *data, size_t length, TickType_t ticks)
+  {
+    std::unique_lock<std::mutex> lock(kernelLock());
+    // en: Like FreeRTOS, an empty stream buffer wakes its reader at the trigger level; a timeout returns what is there
+    // ja: FreeRTOS と同じく、空のストリームバッファの読み手はトリガーレベルで起こされ、タイムアウト時はある分を返す
+    const size_t wanted = sb->message ? 1 : sb->trigger;
+    if (sb->used == 0)
+    {
+      (void)blockUntil(api, lock, sb->cv, ticks, [sb, wanted] { return sb->used >= wanted; });
+    }
+    if (sb->used == 0)
+    {
+      return 0;
+    }
+    size_t n;
+    if (sb->message)
+    {
+      n = nextMessageLength(sb);
+      if (n > length)
+      {
+        return 0; // en: message stays in the buffer / ja: メッセージはバッファに残る
+      }
+      ringDrop(sb, kMessageHeader);
+    }
+    else
+    {
+      n = std::min(length, sb->used);
+    }
+    ringPeek(sb, data, n);
+    ringDrop(sb, n);
+    sb->cv.notify_all();
+    return n;
+  }
+} // namespace
+
+namespace ESP32SyncKitHost
+{
+  IsrScope::IsrScope() { ++isrDepth; }
+  IsrScope::~IsrScope() { --isrDepth; }
+
+  namespace detail
+  {
+    void bindThreadToCore(BaseType_t core) { currentCore = core; }
+  } // namespace detail
+} // namespace ESP32SyncKitHost
+
+// ---- port layer ----
+
+void vPortEnterCritical(portMUX_TYPE *mux)
+{
+  if (ownerId == 0)
+  {
+    ownerId = nextOwnerId.fetch_add(1, std::memory_order_relaxed);
+  }
+  ++criticalDepth;
+  if (__atomic_load_n(&mux->owner, __ATOMIC_RELAXED) == ownerId)
+  {
+    ++mux->count; // en: recursive entry, as on ESP-IDF / ja: ESP-IDF と同じ再帰進入
+    return;
+  }
+  uint32_t expected = 0;
+  while (!__atomic_compare_exchange_n(&mux->owner, &expected, ownerId, false, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED))
+  {
+    expected = 0;
+    std::this_thread::yield();
+  }
+  mux->count = 1;
+}
+
+void vPortExitCritical(portMUX_TYPE *mux)
+{
+  if (__atomic_load_n(&mux->owner, __ATOMIC_RELAXED) != ownerId || mux->count == 0)
+  {
+    fatal("vPortExitCritical", "called by a thread that does not hold the lock");
+  }
+  --criticalDepth;
+  if (--mux->count == 0)
+  {
+    __atomic_store_n(&mux->owner, 0, __ATOMIC_RELEASE);
+  }
+}
+
+BaseType_t xPortInIsrContext(void) { return isrDepth > 0 ? pdTRUE : pdFALSE; }
+BaseType_t xPortGetCoreID(void) { return currentCore; }
+void vPortYield(void) { std::this_thread::yield(); }
+
+int64_t esp_timer_get_time(void)
+{
+  return std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - startTime()).count();
+}
+
+uint32_t esp_cpu_get_cycle_count(void)
+{
+  return static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - startTime()).count());
+}
+
+void esp_rom_delay_us(uint32_t us)
+{
+  const int64_t until = esp_timer_get_time() + us;
+  while (esp_timer_get_time() < until)
+  {
+  }
+}
+
+// ---- tasks ----
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t pxTaskCode, const char *pcName, uint32_t /*usStackDepth*/, void *pvParameters,
+                                   UBaseType_t uxPriority, TaskHandle_t *pxCreatedTask, BaseType_t xCoreID)
+{
+  requireTask("xTaskCreatePinnedToCore");
+  tskTaskControlBlock *task = new tskTaskControlBlock();
+  strncpy(task->name, pcName ? pcName : "", sizeof(task->name) - 1);
+  task->priority = uxPriority;
+  task->core = (xCoreID == tskNO_AFFINITY) ? 0 : xCoreID;
+  if (pxCreatedTask != nullptr)
+  {
+    *pxCreatedTask = task; // en: written before the task runs, as FreeRTOS does / ja: FreeRTOS と同じくタスク実行前に書く
+  }
+  try
+  {
+    std::thread([task, pxTaskCode, pvParameters] {
+      currentTcb = task;
+      currentCore = task->core;
+      try
+      {
+        pxTaskCode(pvParameters);
+      }
+      catch (const TaskExit &)
+      {
+      }
+    }).detach();
+  }
+  catch (const std::system_error &)
+  {
+    if (pxCreatedTask != nullptr)
+    {
+      *pxCreatedTask = nullptr;
+    }
+    delete task;
+    return pdFAIL;
+  }
+  return pdPASS;
+}
+
+void vTaskDelete(TaskHandle_t xTaskToDelete)
+{
+  requireTask("vTaskDelete");
+  if (xTaskToDelete == nullptr || xTaskToDelete == currentTcb)
+  {
+    throw TaskExit(); // en: unwinds to the thread entry above / ja: 上のスレッド入口まで巻き戻す
+  }
+  // en: A thread cannot be stopped from outside; the library only deletes the calling task
+  // ja: スレッドは外から止められない。ライブラリは呼び出し元タスクしか削除しない
+  fatal("vTaskDelete", "of another task is not supported on the host");
+}
+
+void vTaskDelay(TickType_t xTicksToDelay)
+{
+  requireTask("vTaskDelay");
+  if (criticalDepth > 0)
+  {
+    fatal("vTaskDelay", "called inside a critical section");
+  }
+  if (xTicksToDelay == 0)
+  {
+    std::this_thread::yield();
+    return;
+  }
+  std::this_thread::sleep_for(std::chrono::milliseconds(pdTICKS_TO_MS(xTicksToDelay)));
+}
+
+TaskHandle_t xTaskGetCurrentTaskHandle(void) { return self(); }
+TickType_t xTaskGetTickCount(void) { return static_cast<TickType_t>(pdMS_TO_TICKS(esp_timer_get_time() / 1000)); }
+TickType_t xTaskGetTickCountFromISR(void) { return xTaskGetTickCount(); }
+char *pcTaskGetName(TaskHandle_t xTaskToQuery) { return (xTaskToQuery ? xTaskToQuery : self())->name; }
+
+UBaseType_t uxTaskPriorityGet(TaskHandle_t xTask)
+{
+  std::lock_guard<std::mutex> lock(kernelLock());
+  return (xTask ? xTask : self())->priority;
+}
+
+// ---- task notifications ----
+
+namespace
+{
+  BaseType_t notifyLocked(TaskHandle_t task, UBaseType_t index, uint32_t value, eNotifyAction action, uint32_t *previous)
+  {
+    configASSERT(task != nullptr && index < configTASK_NOTIFICATION_ARRAY_ENTRIES);
+    uint32_t &slot = task->notifyValue[index];
+    if (previous != nullptr)
+    {
+      *previous = slot;
+    }
+    const uint8_t oldState = task->notifyState[index];
+    task->notifyState[index] = kReceived;
+    switch (action)
+    {
+    case eSetBits:
+      slot |= value;
+      break;
+    case eIncrement:
+      ++slot;
+      break;
+    case eSetValueWithOverwrite:
+      slot = value;
+      break;
+    case eSetValueWithoutOverwrite:
+      if (oldState == kReceived)
+      {
+        return pdFAIL;
+      }
+      slot = value;
+      break;
+    case eNoAction:
+      break;
+    }
+    task->cv.notify_all();
+    return pdPASS;
+  }
+} // namespace
+
+BaseType_t xTaskGenericNotify(TaskHandle_t xTaskToNotify, UBaseType_t uxIndexToNotify, uint32_t ulValue, eNotifyAction eAction,
+                              uint32_t *pulPreviousNotificationValue)
+{
+  requireTask("xTaskNotify");
+  std::lock_guard<std::mutex> lock(kernelLock());
+  return notifyLocked(xTaskToNotify, uxIndexToNotify, ulValue, eAction, pulPreviousNotificationValue);
+}
+
+BaseType_t xTaskGenericNotifyFromISR(TaskHandle_t xTaskToNotify, UBaseType_t uxIndexToNotify, uint32_t ulValue, eNotifyAction eAction,
+                                     uint32_t *pulPreviousNotificationValue, BaseType_t *pxHigherPriorityTaskWoken)
+{
+  std::lock_guard<std::mutex> lock(kernelLock());
+  setTaskWoken(pxHigherPriorityTaskWoken);
+  return notifyLocked(xTaskToNotify, uxIndexToNotify, ulValue, eAction, pulPreviousNotificationValue);
+}
+
+void vTaskGenericNotifyGiveFromISR(TaskHandle_t xTaskToNotify, UBaseType_t uxIndexToNotify, BaseType_t *pxHigherPriorityTaskWoken)
+{
+  (void)xTaskGenericNotifyFromISR(xTaskToNotify, uxIndexToNotify, 0, eIncrement, nullptr, pxHigherPriorityTaskWoken);
+}
+
+uint32_t ulTaskGenericNotifyTake(UBaseType_t uxIndexToWaitOn, BaseType_t xClearCountOnExit, TickType_t xTicksToWait)
+{
+  requireTask("ulTaskNotifyTake");
+  configASSERT(uxIndexToWaitOn < configTASK_NOTIFICATION_ARRAY_ENTRIES);
+  tskTaskControlBlock *task = self();
+  std::unique_lock<std::mutex> lock(kernelLock());
+  uint32_t &slot = task->notifyValue[uxIndexToWaitOn];
+  uint8_t &state = task->notifyState[uxIndexToWaitOn];
+  if (slot == 0 && xTicksToWait != 0)
+  {
+    state = kWaiting;
+    (void)blockUntil("ulTaskNotifyTake", lock, task->cv, xTicksToWait, [&] { return state == kReceived; });
+  }
+  const uint32_t value = slot;
+  if (value != 0)
+  {
+    slot = xClearCountOnExit ? 0 : value - 1;
+  }
+  state = kNotWaiting;
+  return value;
+}
+
+BaseType_t xTaskGenericNotifyWait(UBaseType_t uxIndexToWaitOn, uint32_t ulBitsToClearOnEntry, uint32_t ulBitsToClearOnExit,
+                                  uint32_t *pulNotificationValue, TickType_t xTicksToWait)
+{
+  requireTask("xTaskNotifyWait");
+  configASSERT(uxIndexToWaitOn < configTASK_NOTIFICATION_ARRAY_ENTRIES);
+  tskTaskControlBlock *task = self();
+  std::unique_lock<std::mutex> lock(kernelLock());
+  uint32_t &slot = task->notifyValue[uxIndexToWaitOn];
+  uint8_t &state = task->notifyState[uxIndexToWaitOn];
+  if (state != kReceived)
+  {
+    slot &= ~ulBitsToClearOnEntry;
+    if (xTicksToWait != 0)
+    {
+      state = kWaiting;
+      (void)blockUntil("xTaskNotifyWait", lock, task->cv, xTicksToWait, [&] { return state == kReceived; });
+    }
+  }
+  if (pulNotificationValue != nullptr)
+  {
+    *pulNotificationValue = slot;
+  }
+  const bool received = (state == kReceived);
+  if (received)
+  {
+    slot &= ~ulBitsToClearOnExit;
+  }
+  state = kNotWaiting;
+  return received ? pdPASS : pdFAIL;
+}
+
+BaseType_t xTaskGenericNotifyStateClear(TaskHandle_t xTask, UBaseType_t uxIndexToClear)
+{
+  configASSERT(uxIndexToClear < configTASK_NOTIFICATION_ARRAY_ENTRIES);
+  tskTaskControlBlock *task = xTask ? xTask : self();
+  std::lock_guard<std::mutex> lock(kernelLock());
+  if (task->notifyState[uxIndexToClear] != kReceived)
+  {
+    return pdFAIL;
+  }
+  task->notifyState[uxIndexToClear] = kNotWaiting;
+  return pdPASS;
+}
+
+uint32_t ulTaskGenericNotifyValueClear(TaskHandle_t xTask, UBaseType_t uxIndexToClear, uint32_t ulBitsToClear)
+{
+  configASSERT(uxIndexToClear < configTASK_NOTIFICATION_ARRAY_ENTRIES);
+  tskTaskControlBlock *task = xTask ? xTask : self();
+  std::lock_guard<std::mutex> lock(kernelLock());
+  const uint32_t value = task->notifyValue[uxIndexToClear];
+  task->notifyValue[uxIndexToClear] &= ~ulBitsToClear;
+  return value;
+}
+
+// ---- queues ----
+
+QueueHandle_t xQueueCreate(UBaseType_t uxQueueLength, UBaseType_t uxItemSize)
+{
+  requireTask("xQueueCreate");
+  configASSERT(uxQueueLength > 0);
+  return newQueue(QueueDefinition::kQueue, uxQueueLength, uxItemSize, 0);
+}
+
+QueueHandle_t xQueueCreateStatic(UBaseType_t uxQueueLength, UBaseType_t uxItemSize, uint8_t * /*pucQueueStorage*/, StaticQueue_t *pxStaticQueue)
+{
+  configASSERT(pxStaticQueue != nullptr);
+  return xQueueCreate(uxQueueLength, uxItemSize);
+}
+
+void vQueueDelete(QueueHandle_t xQueue)
+{
+  requireTask("vQueueDelete");
+  delete xQueue;
+}
+
+BaseType_t xQueueSendToBack(QueueHandle_t xQueue, const void *pvItemToQueue, TickType_t xTicksToWait)
+{
+  requireTask("xQueueSend");
+  return queueSend("xQueueSend", xQueue, pvItemToQueue, xTicksToWait, false);
+}
+
+BaseType_t xQueueSendToFront(QueueHandle_t xQueue, const void *pvItemToQueue, TickType_t xTicksToWait)
+{
+  requireTask("xQueueSendToFront");
+  return queueSend("xQueueSendToFront", xQueue, pvItemToQueue, xTicksToWait, true);
+}
+
+BaseType_t xQueueSendToBackFromISR(QueueHandle_t xQueue, const void *pvItemToQueue, BaseType_t *pxHigherPriorityTaskWoken)
+{
+  setTaskWoken(pxHigherPriorityTaskWoken);
+  return queueSend("xQueueSendFromISR", xQueue, pvItemToQueue, 0, false);
+}
+
+BaseType_t xQueueSendToFrontFromISR(QueueHandle_t xQueue, const void *pvItemToQueue, BaseType_t *pxHigherPriorityTaskWoken)
+{
+  setTaskWoken(pxHigherPriorityTaskWoken);
+  return queueSend("xQueueSendToFrontFromISR", xQueue, pvItemToQueue, 0, true);
+}
+
+BaseType_t xQueueOverwrite(QueueHandle_t xQueue, const void *pvItemToQueue)
+{
+  requireTask("xQueueOverwrite");
+  return queueOverwrite(xQueue, pvItemToQueue);
+}
+
+BaseType_t xQueueOverwriteFromISR(QueueHandle_t xQueue, const void *pvItemToQueue, BaseType_t *pxHigherPriorityTaskWoken)
+{
+  setTaskWoken(pxHigherPriorityTaskWoken);
+  return queueOverwrite(xQueue, pvItemToQueue);
+}
+
+BaseType_t xQueueReceive(QueueHandle_t xQueue, void *pvBuffer, TickType_t xTicksToWait)
+{
+  requireTask("xQueueReceive");
+  return queueReceive("xQueueReceive", xQueue, pvBuffer, xTicksToWait);
+}
+
+BaseType_t xQueueReceiveFromISR(QueueHandle_t xQueue, void *pvBuffer, BaseType_t *pxHigherPriorityTaskWoken)
+{
+  setTaskWoken(pxHigherPriorityTaskWoken);
+  return queueReceive("xQueueReceiveFromISR", xQueue, pvBuffer, 0);
+}
+
+BaseType_t xQueuePeek(QueueHandle_t xQueue, void *pvBuffer, TickType_t xTicksToWait)
+{
+  requireTask("xQueuePeek");
+  std::unique_lock<std::mutex> lock(kernelLock());
+  if (!blockUntil("xQueuePeek", lock, xQueue->cv, xTicksToWait, [xQueue] { return xQueue->count != 0; }))
+  {
+    return errQUEUE_EMPTY;
+  }
+  copyFront(xQueue, pvBuffer);
+  return pdPASS;
+}
+
+UBaseType_t uxQueueMessagesWaiting(QueueHandle_t xQueue)
+{
+  std::lock_guard<std::mutex> lock(kernelLock());
+  return xQueue->count;
+}
+
+UBaseType_t uxQueueMessagesWaitingFromISR(QueueHandle_t xQueue) { return uxQueueMessagesWaiting(xQueue); }
+
+UBaseType_t uxQueueSpacesAvailable(QueueHandle_t xQueue)
+{
+  std::lock_guard<std::mutex> lock(kernelLock());
+  return xQueue->length - xQueue->count;
+}
+
+BaseType_t xQueueReset(QueueHandle_t xQueue)
+{
+  std::lock_guard<std::mutex> lock(kernelLock());
+  xQueue->count = 0;
+  xQueue->head = 0;
+  xQueue->cv.notify_all();
+  return pdPASS;
+}
+
+// ---- queue sets ----
+
+QueueSetHandle_t xQueueCreateSet(UBaseType_t uxEventQueueLength)
+{
+  requireTask("xQueueCreateSet");
+  return newQueue(QueueDefinition::kSet, uxEventQueueLength, 0, 0);
+}
+
+BaseType_t xQueueAddToSet(QueueSetMemberHandle_t xQueueOrSemaphore, QueueSetHandle_t xQueueSet)
+{
+  std::lock_guard<std::mutex> lock(kernelLock());
+  if (xQueueOrSemaphore->set != nullptr || xQueueOrSemaphore->count != 0)
+  {
+    return pdFAIL; // en: FreeRTOS only adds empty members / ja: FreeRTOS は空のメンバーしか追加できない
+  }
+  xQueueOrSemaphore->set = xQueueSet;
+  return pdPASS;
+}
+
+BaseType_t xQueueRemoveFromSet(QueueSetMemberHandle_t xQueueOrSemaphore, QueueSetHandle_t xQueueSet)
+{
+  std::lock_guard<std::mutex> lock(kernelLock());
+  if (xQueueOrSemaphore->set != xQueueSet || xQueueOrSemaphore->count != 0)
+  {
+    return pdFAIL;
+  }
+  xQueueOrSemaphore->set = nullptr;
+  std::deque<QueueDefinition *> &members = xQueueSet->members;
+  members.erase(std::remove(members.begin(), members.end(), xQueueOrSemaphore), members.end());
+  xQueueSet->count = static_cast<UBaseType_t>(members.size());
+  return pdPASS;
+}
+
+QueueSetMemberHandle_t xQueueSelectFromSet(QueueSetHandle_t xQueueSet, TickType_t xTicksToWait)
+{
+  requireTask("xQueueSelectFromSet");
+  std::unique_lock<std::mutex> lock(kernelLock());
+  if (!blockUntil("xQueueSelectFromSet", lock, xQueueSet->cv, xTicksToWait, [xQueueSet] { return !xQueueSet->members.empty(); }))
+  {
+    return nullptr;
+  }
+  QueueDefinition *member = xQueueSet->members.front();
+  xQueueSet->members.pop_front();
+  --xQueueSet->count;
+  return member;
+}
+
+QueueSetMemberHandle_t xQueueSelectFromSetFromISR(QueueSetHandle_t xQueueSet)
+{
+  std::lock_guard<std::mutex> lock(kernelLock());
+  if (xQueueSet->members.empty())
+  {
+    return nullptr;
+  }
+  QueueDefinition *member = xQueueSet->members.front();
+  xQueueSet->members.pop_front();
+  --xQueueSet->count;
+  return member;
+}
+
+// ---- semaphores ----
+
+SemaphoreHandle_t xSemaphoreCreateBinary(void)
+{
+  requireTask("xSemaphoreCreateBinary");
+  return newQueue(QueueDefinition::kSemaphore, 1, 0, 0);
+}
+
+SemaphoreHandle_t xSemaphoreCreateBinaryStatic(StaticSemaphore_t *pxSemaphoreBuffer)
+{
+  configASSERT(pxSemaphoreBuffer != nullptr);
+  return xSemaphoreCreateBinary();
+}
+
+SemaphoreHandle_t xSemaphoreCreateCounting(UBaseType_t uxMaxCount, UBaseType_t uxInitialCount)
+{
+  requireTask("xSemaphoreCreateCounting");
+  configASSERT(uxMaxCount > 0 && uxInitialCount <= uxMaxCount);
+  return newQueue(QueueDefinition::kSemaphore, uxMaxCount, 0, uxInitialCount);
+}
+
+SemaphoreHandle_t xSemaphoreCreateCountingStatic(UBaseType_t uxMaxCount, UBaseType_t uxInitialCount, StaticSemaphore_t *pxSemaphoreBuffer)
+{
+  configASSERT(pxSemaphoreBuffer != nullptr);
+  return xSemaphoreCreateCounting(uxMaxCount, uxInitialCount);
+}
+
+SemaphoreHandle_t xSemaphoreCreateMutex(void)
+{
+  requireTask("xSemaphoreCreateMutex");
+  return newQueue(QueueDefinition::kMutex, 1, 0, 1);
+}
+
+SemaphoreHandle_t xSemaphoreCreateMutexStatic(StaticSemaphore_t *pxMutexBuffer)
+{
+  configASSERT(pxMutexBuffer != nullptr);
+  return xSemaphoreCreateMutex();
+}
+
+void vSemaphoreDelete(SemaphoreHandle_t xSemaphore) { vQueueDelete(xSemaphore); }
+
+BaseType_t xSemaphoreTake(SemaphoreHandle_t xSemaphore, TickType_t xBlockTime)
+{
+  requireTask("xSemaphoreTake");
+  return queueReceive("xSemaphoreTake", xSemaphore, nullptr, xBlockTime);
+}
+
+BaseType_t xSemaphoreTakeFromISR(SemaphoreHandle_t xSemaphore, BaseType_t *pxHigherPriorityTaskWoken)
+{
+  configASSERT(xSemaphore->kind != QueueDefinition::kMutex);
+  setTaskWoken(pxHigherPriorityTaskWoken);
+  return queueReceive("xSemaphoreTakeFromISR", xSemaphore, nullptr, 0);
+}
+
+BaseType_t xSemaphoreGive(SemaphoreHandle_t xSemaphore)
+{
+  requireTask("xSemaphoreGive");
+  std::lock_guard<std::mutex> lock(kernelLock());
+  if (xSemaphore->count >= xSemaphore->length)
+  {
+    return pdFAIL;
+  }
+  if (xSemaphore->kind == QueueDefinition::kMutex && xSemaphore->holder != self())
+  {
+    return pdFAIL; // en: only the holder may give a mutex / ja: ミューテックスを返せるのは保持者だけ
+  }
+  pushItem(xSemaphore, nullptr, false);
+  return pdPASS;
+}
+
+BaseType_t xSemaphoreGiveFromISR(SemaphoreHandle_t xSemaphore, BaseType_t *pxHigherPriorityTaskWoken)
+{
+  configASSERT(xSemaphore->kind != QueueDefinition::kMutex);
+  std::lock_guard<std::mutex> lock(kernelLock());
+  setTaskWoken(pxHigherPriorityTaskWoken);
+  if (xSemaphore->count >= xSemaphore->length)
+  {
+    return pdFAIL;
+  }
+  pushItem(xSemaphore, nullptr, false);
+  return pdPASS;
+}
+
+TaskHandle_t xSemaphoreGetMutexHolder(SemaphoreHandle_t xSemaphore)
+{
+  std::lock_guard<std::mutex> lock(kernelLock());
+  return xSemaphore->kind == QueueDefinition::kMutex ? xSemaphore->holder : nullptr;
+}
+
+UBaseType_t uxSemaphoreGetCount(SemaphoreHandle_t xSemaphore) { return uxQueueMessagesWaiting(xSemaphore); }
+
+// ---- event groups ----
+
+EventGroupHandle_t xEventGroupCreate(void)
+{
+  requireTask("xEventGroupCreate");
+  return new (std::nothrow) EventGroupDef_t();
+}
+
+EventGroupHandle_t xEventGroupCreateStatic(StaticEventGroup_t *pxEventGroupBuffer)
+{
+  configASSERT(pxEventGroupBuffer != nullptr);
+  return xEventGroupCreate();
+}
+
+void vEventGroupDelete(EventGroupHandle_t xEventGroup)
+{
+  requireTask("vEventGroupDelete");
+  delete xEventGroup;
+}
+
+EventBits_t xEventGroupSetBits(EventGroupHandle_t xEventGroup, EventBits_t uxBitsToSet)
+{
+  requireTask("xEventGroupSetBits");
+  std::lock_guard<std::mutex> lock(kernelLock());
+  xEventGroup->bits |= (uxBitsToSet & kEventBitsMask);
+  xEventGroup->cv.notify_all();
+  return xEventGroup->bits;
+}
+
+BaseType_t xEventGroupSetBitsFromISR(EventGroupHandle_t xEventGroup, EventBits_t uxBitsToSet, BaseType_t *pxHigherPriorityTaskWoken)
+{
+  std::lock_guard<std::mutex> lock(kernelLock());
+  setTaskWoken(pxHigherPriorityTaskWoken);
+  xEventGroup->bits |= (uxBitsToSet & kEventBitsMask);
+  xEventGroup->cv.notify_all();
+  return pdPASS;
+}
+
+EventBits_t xEventGroupClearBits(EventGroupHandle_t xEventGroup, EventBits_t uxBitsToClear)
+{
+  std::lock_guard<std::mutex> lock(kernelLock());
+  const EventBits_t before = xEventGroup->bits;
+  xEventGroup->bits &= ~uxBitsToClear;
+  return before;
+}
+
+BaseType_t xEventGroupClearBitsFromISR(EventGroupHandle_t xEventGroup, EventBits_t uxBitsToClear)
+{
+  (void)xEventGroupClearBits(xEventGroup, uxBitsToClear);
+  return pdPASS;
+}
+
+EventBits_t xEventGroupGetBitsFromISR(EventGroupHandle_t xEventGroup)
+{
+  std::lock_guard<std::mutex> lock(kernelLock());
+  return xEventGroup->bits;
+}
+
+EventBits_t xEventGroupWaitBits(EventGroupHandle_t xEventGroup, EventBits_t uxBitsToWaitFor, BaseType_t xClearOnExit,
+                                BaseType_t xWaitForAllBits, TickType_t xTicksToWait)
+{
+  requireTask("xEventGroupWaitBits");
+  std::unique_lock<std::mutex> lock(kernelLock());
+  auto satisfied = [&] {
+    const EventBits_t hit = xEventGroup->bits & uxBitsToWaitFor;
+    return xWaitForAllBits ? hit == uxBitsToWaitFor : hit != 0;
+  };
+  if (!blockUntil("xEventGroupWaitBits", lock, xEventGroup->cv, xTicksToWait, satisfied))
+  {
+    return xEventGroup->bits;
+  }
+  const EventBits_t bits = xEventGroup->bits;
+  if (xClearOnExit)
+  {
+    xEventGroup->bits &= ~uxBitsToWaitFor;
+  }
+  return bits;
+}
+
+EventBits_t xEventGroupSync(EventGroupHandle_t xEventGroup, EventBits_t uxBitsToSet, EventBits_t uxBitsToWaitFor, TickType_t xTicksToWait)
+{
+  requireTask("xEventGroupSync");
+  std::unique_lock<std::mutex> lock(kernelLock());
+  xEventGroup->bits |= (uxBitsToSet & kEventBitsMask);
+  xEventGroup->cv.notify_all();
+  if (!blockUntil("xEventGroupSync", lock, xEventGroup->cv, xTicksToWait,
+                  [&] { return (xEventGroup->bits & uxBitsToWaitFor) == uxBitsToWaitFor; }))
+  {
+    return xEventGroup->bits;
+  }
+  const EventBits_t bits = xEventGroup->bits;
+  xEventGroup->bits &= ~uxBitsToWaitFor;
+  return bits;
+}
+
+// ---- stream and message buffers ----
+
+StreamBufferHandle_t xStreamBufferGenericCreate(size_t xBufferSizeBytes, size_t xTriggerLevelBytes, BaseType_t xIsMessageBuffer)
+{
+  requireTask("xStreamBufferCreate");
+  configASSERT(xBufferSizeBytes > 0 && xTriggerLevelBytes <= xBufferSizeBytes);
+  StreamBufferDef_t *sb = new (std::nothrow) StreamBufferDef_t();
+  if (sb == nullptr)
+  {
+    return nullptr;
+  }
+  sb->message = (xIsMessageBuffer != pdFALSE);
+  sb->size = xBufferSizeBytes;
+  sb->trigger = xTriggerLevelBytes == 0 ? 1 : xTriggerLevelBytes;
+  sb->data.resize(xBufferSizeBytes);
+  return sb;
+}
+
+void vStreamBufferDelete(StreamBufferHandle_t xStreamBuffer)
+{
+  requireTask("vStreamBufferDelete");
+  delete xStreamBuffer;
+}
+
+size_t xStreamBufferSend(StreamBufferHandle_t xStreamBuffer, const void *pvTxData, size_t xDataLengthBytes, TickType_t xTicksToWait)
+{
+  requireTask("xStreamBufferSend");
+  return streamSend("xStreamBufferSend", xStreamBuffer, pvTxData, xDataLengthBytes, xTicksToWait);
+}
+
+size_t xStreamBufferSendFromISR(StreamBufferHandle_t xStreamBuffer, const void *pvTxData, size_t xDataLengthBytes,
+                                BaseType_t *pxHigherPriorityTaskWoken)
+{
+  setTaskWoken(pxHigherPriorityTaskWoken);
+  return streamSend("xStreamBufferSendFromISR", xStreamBuffer, pvTxData, xDataLengthBytes, 0);
+}
+
+size_t xStreamBufferReceive(StreamBufferHandle_t xStreamBuffer, void *pvRxData, size_t xBufferLengthBytes, TickType_t xTicksToWait)
+{
+  requireTask("xStreamBufferReceive");
+  return streamReceive("xStreamBufferReceive", xStreamBuffer, pvRxData, xBufferLengthBytes, xTicksToWait);
+}
+
+size_t xStreamBufferReceiveFromISR(StreamBufferHandle_t xStreamBuffer, void *pvRxData, size_t xBufferLengthBytes,
+                                   BaseType_t *pxHigherPriorityTaskWoken)
+{
+  setTaskWoken(pxHigherPriorityTaskWoken);
+  return streamReceive("xStreamBufferReceiveFromISR", xStreamBuffer, pvRxData, xBufferLengthBytes, 0);
+}
+
+size_t xStreamBufferBytesAvailable(StreamBufferHandle_t xStreamBuffer)
+{
+  std::lock_guard<std::mutex> lock(kernelLock());
+  return xStreamBuffer->used;
+}
+
+size_t xStreamBufferSpacesAvailable(StreamBufferHandle_t xStreamBuffer)
+{
+  std::lock_guard<std::mutex> lock(kernelLock());
+  return xStreamBuffer->size - xStreamBuffer->used;
+}
+
+size_t xStreamBufferNextMessageLengthBytes(StreamBufferHandle_t xStreamBuffer)
+{
+  std::lock_guard<std::mutex> lock(kernelLock());
+  return xStreamBuffer->message ? nextMessageLength(xStreamBuffer) : 0;
+}
+
+BaseType_t xStreamBufferSetTriggerLevel(StreamBufferHandle_t xStreamBuffer, size_t xTriggerLevel)
+{
+  std::lock_guard<std::mutex> lock(kernelLock());
+  if (xTriggerLevel > xStreamBuffer->size)
+  {
+    return pdFALSE;
+  }
+  xStreamBuffer->trigger = xTriggerLevel == 0 ? 1 : xTriggerLevel;
+  return pdTRUE;
+}
+
+BaseType_t xStreamBufferReset(StreamBufferHandle_t xStreamBuffer)
+{
+  std::lock_guard<std::mutex> lock(kernelLock());
+  xStreamBuffer->head = 0;
+  xStreamBuffer->used = 0;
+  xStreamBuffer->cv.notify_all();
+  return pdPASS;
+}
+
+BaseType_t xStreamBufferIsEmpty(StreamBufferHandle_t xStreamBuffer) { return xStreamBufferBytesAvailable(xStreamBuffer) == 0 ? pdTRUE : pdFALSE; }
+
+BaseType_t xStreamBufferIsFull(StreamBufferHandle_t xStreamBuffer)
+{
+  std::lock_guard<std::mutex> lock(kernelLock());
+  const size_t reserve = xStreamBuffer->message ? kMessageHeader : 0;
+  return (xStreamBuffer->size - xStreamBuffer->used) <= reserve ? pdTRUE : pdFALSE;
+}
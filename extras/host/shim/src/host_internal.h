@@ -0,0 +1,18 @@
+#pragma once
+
+#include <freertos/FreeRTOS.h>
+
+namespace ESP32SyncKitHost
+{
+  namespace detail
+  {
+    // en: Make xPortGetCoreID() report core on the calling thread (timer interrupt threads)
+    // ja: 呼び出しスレッドで xPortGetCoreID() が core を返すようにする（タイマー割り込みスレッド用）
+    void bindThreadToCore(BaseType_t core);
+
+    // en: Called with each complete line written to Serial (without the newline)
+    // ja: Serial に書かれた1行ごとに（改行を除いて）呼ばれる
+    using SerialLineHook = void (*)(const char *line);
+    void setSerialLineHook(SerialLineHook hook);
+  } // namespace detail
+} // namespace ESP32SyncKitHost
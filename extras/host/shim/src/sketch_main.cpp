@@ -0,0 +1,35 @@
+// en: Entry point for sketches built on the host: setup() once, then loop() forever, like Arduino's loopTask.
+// en: The process exits when the sketch prints the benchmark end marker {"bench":"done"}, the same line a serial
+// en: capture script waits for on the device.
+// ja: ホストでビルドしたスケッチの入口: Arduino の loopTask と同じく setup() を1回呼び、以降 loop() を繰り返す。
+// ja: スケッチがベンチマーク終了マーカー {"bench":"done"}（実機でシリアル取得スクリプトが待つのと同じ行）を
+// ja: 出力するとプロセスを終了する
+
+#include <Arduino.h>
+
+#include "host_internal.h"
+
+#include <string.h>
+
+namespace
+{
+  void exitOnDoneMarker(const char *line)
+  {
+    if (strcmp(line, "{\"bench\":\"done\"}") == 0)
+    {
+      fflush(stdout);
+      fflush(stderr);
+      _Exit(0); // en: tasks are still running; skip static destructors / ja: タスクはまだ動いているため静的デストラクタを飛ばす
+    }
+  }
+} // namespace
+
+int main()
+{
+  ESP32SyncKitHost::detail::setSerialLineHook(&exitOnDoneMarker);
+  setup();
+  for (;;)
+  {
+    loop();
+  }
+}
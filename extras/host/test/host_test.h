@@ -0,0 +1,59 @@
+#pragma once
+
+// en: Minimal test harness for the host build: CHECK records a failure and continues; main() returns the count.
+// ja: ホストビルド用の最小テストハーネス: CHECK は失敗を記録して続行し、main() は失敗数を返す
+
+#include <ESP32SyncKitHost.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+#include <stdio.h>
+
+#include <atomic>
+#include <functional>
+#include <thread>
+
+namespace HostTest
+{
+  inline int failures = 0;
+
+  inline void check(bool ok, const char *expr, const char *file, int line)
+  {
+    if (!ok)
+    {
+      ++failures;
+      fprintf(stderr, "%s:%d: CHECK(%s) failed\n", file, line, expr);
+    }
+  }
+
+  // en: Run fn as a FreeRTOS task pinned to core and return once it finished
+  // ja: fn を core に固定した FreeRTOS タスクとして実行し、終了を待って戻る
+  inline void runTask(const std::function<void()> &fn, BaseType_t core = 0)
+  {
+    struct Context
+    {
+      const std::function<void()> *fn;
+      std::atomic<bool> done{false};
+    } context{&fn};
+    xTaskCreatePinnedToCore(
+        [](void *pv) {
+          Context *c = static_cast<Context *>(pv);
+          (*c->fn)();
+          c->done.store(true);
+          vTaskDelete(nullptr);
+        },
+        "test", 4096, &context, 5, nullptr, core);
+    while (!context.done.load())
+    {
+      std::this_thread::yield();
+    }
+  }
+
+  inline int report(const char *name)
+  {
+    printf("%s: %s (%d failures)\n", name, failures == 0 ? "OK" : "FAILED", failures);
+    return failures == 0 ? 0 : 1;
+  }
+} // namespace HostTest
+
+#define CHECK(expr) HostTest::check(static_cast<bool>(expr), #expr, __FILE__, __LINE__)
@@ -0,0 +1,396 @@
+// en: Core primitives on the host shim: Queue, Notify, BinarySemaphore, Mutex, HybridMutex, SharedMutex guards, their
+// en: Static variants, ObjectQueue, EventFlags and Future tickets, from tasks and from ISR scopes
+// ja: ホスト用シム上のコアプリミティブ: Queue、Notify、BinarySemaphore、Mutex、HybridMutex、SharedMutex のガード、
+// ja: Static 版、ObjectQueue、EventFlags、Future のチケットをタスクと ISR スコープから確認する
+
+#include "host_test.h"
+
+#include <ESP32SyncKit.h>
+#include <ESP32SyncKitEventFlags.h>
+#include <ESP32SyncKitFuture.h>
+#include <ESP32SyncKitHybridMutex.h>
+#include <ESP32SyncKitObjectQueue.h>
+#include <ESP32SyncKitSharedMutex.h>
+#include <ESP32SyncKitStatic.h>
+
+#include <stdexcept>
+#include <string>
+
+using namespace ESP32SyncKit;
+
+namespace
+{
+  void testQueue()
+  {
+    Queue<uint32_t> q(4);
+    uint32_t v = 0;
+    CHECK(!q.tryReceive(v));
+    for (uint32_t i = 0; i < 4; ++i)
+    {
+      CHECK(q.trySend(i));
+    }
+    CHECK(!q.trySend(99));
+    CHECK(q.count() == 4);
+    for (uint32_t i = 0; i < 4; ++i)
+    {
+      CHECK(q.receive(v, 10) && v == i);
+    }
+
+    // en: Timed receive waits for roughly its timeout
+    // ja: 時間指定の受信はおおよそタイムアウトまで待つ
+    const int64_t start = esp_timer_get_time();
+    CHECK(!q.receive(v, 30));
+    CHECK(esp_timer_get_time() - start >= 25000);
+
+    // en: In an ISR the timeout is ignored and the FromISR API is used
+    // ja: ISR ではタイムアウトを無視し FromISR API を使う
+    {
+      ESP32SyncKitHost::IsrScope isr;
+      CHECK(q.send(7, WaitForever));
+      CHECK(q.receive(v, WaitForever) && v == 7);
+      CHECK(!q.receive(v, WaitForever));
+    }
+
+    // en: Cross-task hand-off in order
+    // ja: タスク間で順序どおりに受け渡す
+    constexpr uint32_t kItems = 5000;
+    std::atomic<uint32_t> errors{0};
+    std::thread consumer([&] {
+      HostTest::runTask([&] {
+        uint32_t x = 0;
+        for (uint32_t i = 0; i < kItems; ++i)
+        {
+          if (!q.receive(x, 1000) || x != i)
+          {
+            errors.fetch_add(1);
+          }
+        }
+      }, 1);
+    });
+    HostTest::runTask([&] {
+      for (uint32_t i = 0; i < kItems; ++i)
+      {
+        q.send(i);
+      }
+    });
+    consumer.join();
+    CHECK(errors.load() == 0);
+  }
+
+  void testNotify()
+  {
+    HostTest::runTask([] {
+      Notify counter;
+      CHECK(counter.bindToSelf());
+      {
+        ESP32SyncKitHost::IsrScope isr;
+        CHECK(counter.notify());
+        CHECK(counter.notify());
+      }
+      CHECK(counter.takeAll(0) == 2);
+      CHECK(!counter.take(10));
+    });
+
+    std::atomic<TaskHandle_t> waiter{nullptr};
+    std::atomic<bool> gotBits{false};
+    std::thread t([&] {
+      HostTest::runTask([&] {
+        Notify bits;
+        bits.bindToSelf();
+        waiter.store(xTaskGetCurrentTaskHandle());
+        gotBits.store(bits.waitBits(0x3, 1000, true, true));
+      }, 1);
+    });
+    while (waiter.load() == nullptr)
+    {
+      std::this_thread::yield();
+    }
+    Notify sender(waiter.load());
+    CHECK(sender.setBits(0x1));
+    {
+      ESP32SyncKitHost::IsrScope isr;
+      CHECK(sender.setBits(0x2));
+    }
+    t.join();
+    CHECK(gotBits.load());
+  }
+
+  void testBinarySemaphore()
+  {
+    BinarySemaphore sem;
+    CHECK(sem.begin());
+    CHECK(!sem.take(10));
+    {
+      ESP32SyncKitHost::IsrScope isr;
+      CHECK(sem.give());
+    }
+    CHECK(sem.take(10));
+  }
+
+  void testMutex()
+  {
+    Mutex m;
+    CHECK(m.lock(10));
+    CHECK(m.unlock());
+
+    // en: unlock() before any lock() is misuse: logged, and no semaphore is created
+    // ja: lock() 前の unlock() は誤用: ログに出し、セマフォは生成しない
+    BasicMutex<WithStats> fresh;
+    ESP32SyncKitHost::resetLogCounts();
+    CHECK(!fresh.unlock());
+    CHECK(ESP32SyncKitHost::logCount(ESP_LOG_ERROR) == 1);
+    CHECK(fresh.stats().failures == 1 && fresh.stats().sends == 0);
+    CHECK(fresh.lock(10) && fresh.unlock());
+
+    constexpr uint32_t kIncrements = 20000;
+    uint32_t counter = 0;
+    auto work = [&] {
+      for (uint32_t i = 0; i < kIncrements; ++i)
+      {
+        Mutex::LockGuard guard(m);
+        ++counter;
+      }
+    };
+    std::thread other([&] { HostTest::runTask(work, 1); });
+    HostTest::runTask(work, 0);
+    other.join();
+    CHECK(counter == 2 * kIncrements);
+  }
+
+  // en: HybridMutex: a failed tryLock() is silent, a failed LockGuard logs, and move assignment releases the lock the
+  // en: guard held
+  // ja: HybridMutex: 失敗した tryLock() はログを出さず、失敗した LockGuard はログを出し、ムーブ代入はガードが
+  // ja: 持っていたロックを解放する
+  void testHybridMutex()
+  {
+    BasicHybridMutex<WithStats> m;
+    HybridMutex first;
+    HybridMutex second;
+    std::atomic<bool> held{false};
+    std::atomic<bool> release{false};
+    std::thread owner([&] {
+      HostTest::runTask([&] {
+        CHECK(m.lock());
+        held.store(true);
+        while (!release.load())
+        {
+          vTaskDelay(1);
+        }
+        CHECK(m.unlock());
+      }, 1);
+    });
+    HostTest::runTask([&] {
+      while (!held.load())
+      {
+        taskYIELD();
+      }
+      ESP32SyncKitHost::resetLogCounts();
+      CHECK(!m.tryLock());
+      CHECK(ESP32SyncKitHost::logCount(ESP_LOG_WARN) == 0);
+      {
+        BasicHybridMutex<WithStats>::LockGuard guard(m, 2);
+        CHECK(!guard.locked());
+      }
+      CHECK(ESP32SyncKitHost::logCount(ESP_LOG_WARN) == 2); // en: lock timeout + LockGuard / ja: lock タイムアウト + LockGuard
+      release.store(true);
+      CHECK(m.lock(1000));
+      CHECK(m.unlock());
+
+      HybridMutex::LockGuard guard(first);
+      CHECK(guard.locked());
+      guard = HybridMutex::LockGuard(second);
+      CHECK(guard.locked());
+      CHECK(first.tryLock()); // en: released by the move assignment / ja: ムーブ代入で解放済み
+      CHECK(first.unlock());
+    });
+    owner.join();
+    CHECK(m.stats().failures == 1 && m.stats().timeouts == 1);
+  }
+
+  // en: SharedMutex guards: a failed lock logs, and move assignment releases the lock the target guard held
+  // ja: SharedMutex のガード: ロック失敗はログに出し、ムーブ代入は代入先のガードが持っていたロックを解放する
+  void testSharedMutexGuards()
+  {
+    SharedMutex first;
+    SharedMutex second;
+    HostTest::runTask([&] {
+      SharedMutex::LockGuard writer(first);
+      CHECK(writer.locked());
+      writer = SharedMutex::LockGuard(second);
+      CHECK(writer.locked());
+      CHECK(first.tryLockShared());
+      CHECK(first.unlockShared());
+
+      SharedMutex::SharedLockGuard reader(first);
+      CHECK(reader.locked());
+      ESP32SyncKitHost::resetLogCounts();
+      reader = SharedMutex::SharedLockGuard(second, 0); // en: fails: second is held exclusively / ja: second は排他保持中で失敗
+      CHECK(!reader.locked());
+      CHECK(ESP32SyncKitHost::logCount(ESP_LOG_WARN) == 1);
+      CHECK(first.tryLock()); // en: the shared lock on first was released / ja: first の共有ロックは解放済み
+      CHECK(first.unlock());
+    });
+  }
+
+  // en: A Static* variant cannot be moved out through its base class, which would leave the handle pointing into it
+  // ja: Static* 版は基底クラス経由でもムーブできない（ハンドルが元のオブジェクトを指したまま残るため）
+  static_assert(!std::is_constructible<Queue<int>, StaticQueue<int, 4> &&>::value, "StaticQueue moved into Queue");
+  static_assert(!std::is_assignable<Queue<int> &, StaticQueue<int, 4> &&>::value, "StaticQueue assigned to Queue");
+  static_assert(!std::is_constructible<BinarySemaphore, StaticBinarySemaphore &&>::value,
+                "StaticBinarySemaphore moved into BinarySemaphore");
+  static_assert(!std::is_constructible<Mutex, StaticMutex &&>::value, "StaticMutex moved into Mutex");
+  static_assert(!std::is_assignable<Mutex &, StaticMutex &&>::value, "StaticMutex assigned to Mutex");
+  static_assert(std::is_move_constructible<Queue<int>>::value, "Queue itself stays movable");
+
+  void testStatic()
+  {
+    // en: Policies are forwarded to the base class
+    // ja: ポリシーは基底クラスへそのまま渡る
+    StaticQueue<uint32_t, 2, WithStats> q;
+    Queue<uint32_t, WithStats> &base = q;
+    uint32_t v = 0;
+    CHECK(base.trySend(1) && base.trySend(2) && !base.trySend(3));
+    CHECK(q.receive(v, 10) && v == 1);
+    CHECK(q.stats().sends == 2 && q.stats().receives == 1 && q.stats().failures == 1);
+
+    BasicStaticBinarySemaphore<WithStats> sem;
+    CHECK(sem.give() && sem.take(10) && !sem.take(0));
+    CHECK(sem.stats().sends == 1 && sem.stats().receives == 1);
+
+    BasicStaticMutex<WithStats, LogNone> m;
+    CHECK(m.lock(10) && m.unlock());
+    CHECK(m.stats().receives == 1 && m.stats().sends == 1);
+  }
+
+  // en: From an ISR, ObjectQueue moves trivially destructible objects and rejects the rest with a warning
+  // ja: ISR では ObjectQueue はトリビアル破棄可能なオブジェクトだけを運び、それ以外は警告を出して拒否する
+  void testObjectQueueIsr()
+  {
+    struct Pair
+    {
+      uint32_t a;
+      uint32_t b;
+    };
+    ObjectQueue<Pair> pairs(2);
+    ObjectQueue<std::string> strings(2);
+    CHECK(strings.send(std::string(40, 'x'), 0));
+    ESP32SyncKitHost::resetLogCounts();
+    {
+      ESP32SyncKitHost::IsrScope isr;
+      CHECK(pairs.emplace(Pair{1, 2}));
+      Pair p{};
+      CHECK(pairs.receive(p, WaitForever) && p.a == 1 && p.b == 2);
+
+      std::string s;
+      CHECK(!strings.send(std::string("isr"), 0));
+      CHECK(!strings.tryEmplace(3, 'y'));
+      CHECK(!strings.receive(s, 0));
+    }
+    (void)flushDeferredLogs();
+    CHECK(ESP32SyncKitHost::logCount(ESP_LOG_WARN) == 3);
+    std::string s;
+    CHECK(strings.receive(s, 0) && s.size() == 40);
+    CHECK(strings.count() == 0);
+  }
+
+  // en: A throwing constructor hands the taken slot back, so a depth-1 queue still accepts the next object
+  // ja: コンストラクタが例外を投げても取り出したスロットは戻り、深さ1のキューは次のオブジェクトを受け付ける
+  void testObjectQueueThrow()
+  {
+    struct Picky
+    {
+      uint32_t v;
+      explicit Picky(uint32_t x) : v(x)
+      {
+        if (x == 0)
+        {
+          throw std::invalid_argument("zero");
+        }
+      }
+    };
+    ObjectQueue<Picky> q(1);
+    for (int round = 0; round < 2; ++round)
+    {
+      bool thrown = false;
+      try
+      {
+        ESP32SyncKitHost::IsrScope isr;
+        (void)q.tryEmplace(0u);
+      }
+      catch (const std::invalid_argument &)
+      {
+        thrown = true;
+      }
+      CHECK(thrown);
+      thrown = false;
+      try
+      {
+        (void)q.emplace(0u);
+      }
+      catch (const std::invalid_argument &)
+      {
+        thrown = true;
+      }
+      CHECK(thrown);
+      CHECK(q.count() == 0);
+    }
+    CHECK(q.tryEmplace(7u));
+    Picky out(1);
+    CHECK(q.receive(out, 0) && out.v == 7);
+  }
+
+  // en: From an ISR, EventFlags::wait() is a plain check; clearOnExit is refused, since the clear would be deferred
+  // ja: ISR では EventFlags::wait() は単なる確認。クリアが後回しになるため clearOnExit は拒否する
+  void testEventFlagsIsr()
+  {
+    EventFlags flags;
+    CHECK(flags.set(0x3));
+    ESP32SyncKitHost::resetLogCounts();
+    {
+      ESP32SyncKitHost::IsrScope isr;
+      CHECK(flags.tryWait(0x1));
+      CHECK(!flags.tryWait(0x1, true));
+      CHECK(flags.tryWait(0x1));
+    }
+    (void)flushDeferredLogs();
+    CHECK(ESP32SyncKitHost::logCount(ESP_LOG_ERROR) == 1);
+    CHECK(flags.get() == 0x3);
+    CHECK(flags.tryWait(0x1, true) && flags.get() == 0x2);
+  }
+
+  // en: Re-arming one Future past the 24-bit generation wrap keeps handing out valid Promises on slot 0
+  // ja: 1つの Future を 24 ビットの世代が一周するまで再設定しても、スロット 0 で有効な Promise を返し続ける
+  void testFutureTicketWrap()
+  {
+    Future<uint32_t> future;
+    uint32_t invalid = 0;
+    for (uint32_t i = 0; i < (1u << 24) + 2; ++i)
+    {
+      if (!future.promise().valid())
+      {
+        ++invalid;
+      }
+    }
+    CHECK(invalid == 0);
+    Promise<uint32_t> promise = future.promise();
+    CHECK(promise.set(7));
+    uint32_t v = 0;
+    CHECK(future.tryGet(v) && v == 7);
+  }
+} // namespace
+
+int main()
+{
+  testQueue();
+  testNotify();
+  testBinarySemaphore();
+  testMutex();
+  testHybridMutex();
+  testSharedMutexGuards();
+  testStatic();
+  testObjectQueueIsr();
+  testObjectQueueThrow();
+  testEventFlagsIsr();
+  testFutureTicketWrap();
+  return HostTest::report("test_core");
+}
@@ -0,0 +1,154 @@
+// en: Timeout and full messages of the newer primitives follow their LogPolicy: LogAll prints them,
+// en: LogRateLimited and LogNone do not
+// ja: 新しいプリミティブのタイムアウト・満杯メッセージがログポリシーに従うことを確認する: LogAll は出力し、
+// ja: LogRateLimited と LogNone は出力しない
+// en: Misuse errors of Select, and of a Loan through its BufferPool, follow the LogPolicy too
+// ja: Select の誤用エラーと、BufferPool を通した Loan の誤用エラーもログポリシーに従う
+// en: A precise deadline polls its sub-tick remainder without printing a timeout per poll
+// ja: precise な期限は1ティック未満の残りをポーリングしても、ポーリングごとにタイムアウトを出力しない
+
+#include "host_test.h"
+
+#include <ESP32SyncKit.h>
+#include <ESP32SyncKitBufferPool.h>
+#include <ESP32SyncKitFuture.h>
+#include <ESP32SyncKitLatest.h>
+#include <ESP32SyncKitMpscQueue.h>
+#include <ESP32SyncKitObjectQueue.h>
+#include <ESP32SyncKitSelect.h>
+#include <ESP32SyncKitSpscQueue.h>
+#include <ESP32SyncKitTopic.h>
+
+using namespace ESP32SyncKit;
+
+namespace
+{
+  uint32_t warnings()
+  {
+    (void)flushDeferredLogs();
+    return ESP32SyncKitHost::logCount(ESP_LOG_WARN);
+  }
+
+  // en: Runs one timed-out or rejected operation per primitive and returns the number of warnings printed
+  // ja: プリミティブごとにタイムアウト・拒否される操作を1回ずつ行い、出力された警告の数を返す
+  template <class LogPolicy>
+  uint32_t timeoutWarnings()
+  {
+    uint32_t before = 0;
+    HostTest::runTask([&] {
+      before = warnings();
+      int v = 0;
+
+      SpscQueue<int, 2, LogPolicy> spsc;
+      CHECK(!spsc.receive(v, 2));
+      MpscQueue<int, 2, LogPolicy> mpsc;
+      CHECK(!mpsc.receive(v, 2));
+      ObjectQueue<int, LogPolicy> objects(1);
+      CHECK(!objects.receive(v, 2));
+      BufferPool<int, 1, LogPolicy> pool;
+      Loan<int> loan = pool.acquire(2);
+      CHECK(!pool.acquire(2));
+      Latest<int, WakeOnUpdate, LogPolicy> latest;
+      uint32_t version = latest.version();
+      CHECK(!latest.waitNewer(v, version, 2));
+      Topic<int, 2, 1, LogPolicy> topic;
+      typename Topic<int, 2, 1, LogPolicy>::Subscriber sub(topic);
+      CHECK(!sub.receive(v, 2));
+      Future<int, LogPolicy> future;
+      Promise<int, LogPolicy> promise = future.promise();
+      CHECK(!future.get(v, 2));
+      future.cancel();
+      CHECK(!promise.set(1));
+      {
+        ESP32SyncKitHost::IsrScope isr;
+        CHECK(spsc.trySend(1) && spsc.trySend(2) && !spsc.trySend(3));
+      }
+    });
+    return warnings() - before;
+  }
+
+  uint32_t errors()
+  {
+    (void)flushDeferredLogs();
+    return ESP32SyncKitHost::logCount(ESP_LOG_ERROR);
+  }
+
+  // en: Runs misuses in a task and in an ISR (deferred, never rate limited) and returns the number of errors printed:
+  // en: Select fails begin() twice, so the second falls under the rate limit; a pooled buffer is released twice
+  // ja: 誤用をタスクと ISR（後回しにされ、レート制限はかからない）で行い、出力されたエラーの数を返す:
+  // ja: Select は begin() に2回失敗し、2回目はレート制限にかかる。プールのバッファは2回返却する
+  template <class Policy>
+  uint32_t misuseErrors()
+  {
+    const uint32_t before = errors();
+    HostTest::runTask([&] {
+      Select<1, Policy> select;
+      CHECK(!select.begin()); // en: no members / ja: メンバーなし
+      CHECK(!select.begin());
+      {
+        ESP32SyncKitHost::IsrScope isr;
+        CHECK(select.dispatch(0) == -1);
+      }
+
+      BufferPool<uint32_t, 1, Policy> pool;
+      typename Loan<uint32_t>::Raw raw = pool.acquire(0).detach();
+      (void)Loan<uint32_t>::adopt(raw);
+      (void)Loan<uint32_t>::adopt(raw); // en: double release / ja: 二重返却
+      {
+        ESP32SyncKitHost::IsrScope isr;
+        (void)Loan<uint32_t>::adopt(raw);
+      }
+      CHECK(pool.available() == 1);
+    });
+    return errors() - before;
+  }
+
+  void testPreciseDeadline()
+  {
+    Mutex m;
+    std::atomic<bool> held{false};
+    std::atomic<bool> release{false};
+    std::thread owner([&] {
+      HostTest::runTask([&] {
+        CHECK(m.lock(WaitForever));
+        held.store(true);
+        while (!release.load())
+        {
+          vTaskDelay(1);
+        }
+        CHECK(m.unlock());
+      }, 1);
+    });
+    HostTest::runTask([&] {
+      while (!held.load())
+      {
+        taskYIELD();
+      }
+      const uint32_t before = warnings();
+      const int64_t start = esp_timer_get_time();
+      CHECK(!m.lock(Deadline(std::chrono::microseconds(2500)).precise()));
+      const int64_t elapsed = esp_timer_get_time() - start;
+      // en: Only what the design guarantees under any scheduling: never early, done well within a generous ceiling,
+      // en: and the zero-tick polls add no warning to the (at most one) blocking attempt
+      // ja: どんなスケジューリングでも設計上保証されることだけを確認する: 期限より早く終わらず、余裕のある上限内に
+      // ja: 終わり、0ティックのポーリングは（高々1回の）ブロック試行に警告を加えない
+      CHECK(elapsed >= 2500 && elapsed < 500000);
+      CHECK(warnings() - before <= 1);
+      release.store(true);
+    });
+    owner.join();
+  }
+} // namespace
+
+int main()
+{
+  ESP32SyncKitHost::setLogEcho(false);
+  CHECK(timeoutWarnings<LogAll>() == 9);
+  CHECK(timeoutWarnings<LogRateLimited<1000>>() == 1); // en: only the ISR full warning / ja: ISR の満杯警告のみ
+  CHECK(timeoutWarnings<LogNone>() == 0);
+  CHECK(misuseErrors<LogAll>() == 5);
+  CHECK(misuseErrors<LogRateLimited<1000>>() == 4);
+  CHECK(misuseErrors<LogNone>() == 0);
+  testPreciseDeadline();
+  return HostTest::report("test_log_policy");
+}
@@ -0,0 +1,140 @@
+// en: MpscQueue under contention: task and ISR producers on both cores race for slots of a small ring that wraps
+// en: thousands of times. Every accepted item arrives exactly once and in per-producer order, every rejected send
+// en: is counted in dropped(), and the consumer's notification slot is left clean.
+// ja: 競合下の MpscQueue: 両コアのタスクと ISR の生産者が、何千周もする小さなリングのスロットを奪い合う。
+// ja: 受け付けた要素はすべて生産者ごとの順序で1回だけ届き、拒否された送信はすべて dropped() に数えられ、
+// ja: 消費者の通知スロットにはカウントが残らない
+
+#include "host_test.h"
+
+#include <ESP32SyncKit.h>
+#include <ESP32SyncKitMpscQueue.h>
+#include <esp_rom_sys.h>
+
+#include <random>
+#include <vector>
+
+using namespace ESP32SyncKit;
+
+namespace
+{
+  constexpr uint32_t kTaskProducers = 2;
+  constexpr uint32_t kIsrProducers = 2;
+  constexpr uint32_t kProducers = kTaskProducers + kIsrProducers;
+  constexpr uint32_t kItemsPerProducer = 20000;
+
+  uint32_t encode(uint32_t producer, uint32_t seq) { return (producer << 24) | seq; }
+
+  template <size_t N>
+  void stress(const char *name)
+  {
+    MpscQueue<uint32_t, N> q;
+    std::atomic<uint32_t> accepted{0};
+    std::atomic<uint32_t> rejected{0};
+    std::atomic<uint32_t> running{kProducers};
+    std::vector<std::thread> producers;
+
+    // en: Task producers retry until each item is accepted, so their sequence has no gaps
+    // ja: タスクの生産者は受け付けられるまで再送するため、番号に抜けがない
+    for (uint32_t p = 0; p < kTaskProducers; ++p)
+    {
+      producers.emplace_back([&, p] {
+        HostTest::runTask([&] {
+          for (uint32_t seq = 0; seq < kItemsPerProducer; ++seq)
+          {
+            while (!q.trySend(encode(p, seq)))
+            {
+              rejected.fetch_add(1);
+              taskYIELD();
+            }
+            accepted.fetch_add(1);
+          }
+          running.fetch_sub(1);
+        }, static_cast<BaseType_t>(p % 2));
+      });
+    }
+
+    // en: ISR producers drop on full, as an interrupt handler would
+    // ja: ISR の生産者は割り込みハンドラと同じく満杯なら捨てる
+    for (uint32_t p = kTaskProducers; p < kProducers; ++p)
+    {
+      producers.emplace_back([&, p] {
+        ESP32SyncKitHost::IsrScope isr;
+        std::minstd_rand rng(p);
+        for (uint32_t seq = 0; seq < kItemsPerProducer; ++seq)
+        {
+          if (q.trySend(encode(p, seq)))
+          {
+            accepted.fetch_add(1);
+          }
+          else
+          {
+            rejected.fetch_add(1);
+          }
+          if (rng() % 8 == 0)
+          {
+            esp_rom_delay_us(rng() % 20);
+          }
+        }
+        running.fetch_sub(1);
+      });
+    }
+
+    uint32_t received = 0;
+    uint32_t errors = 0;
+    HostTest::runTask([&] {
+      uint32_t next[kProducers] = {};
+      uint32_t batch[4];
+      while (true)
+      {
+        const uint32_t n = (received % 2 == 0) ? q.receiveMany(batch, 4, 10) : (q.receive(batch[0], 10) ? 1 : 0);
+        if (n == 0 && running.load() == 0 && q.count() == 0)
+        {
+          break;
+        }
+        for (uint32_t i = 0; i < n; ++i)
+        {
+          const uint32_t producer = batch[i] >> 24;
+          const uint32_t seq = batch[i] & 0xffffff;
+          const bool inOrder = producer < kTaskProducers ? seq == next[producer] : seq >= next[producer];
+          if (producer >= kProducers || !inOrder)
+          {
+            ++errors;
+            continue;
+          }
+          next[producer] = seq + 1;
+          ++received;
+        }
+      }
+      for (uint32_t p = 0; p < kTaskProducers; ++p)
+      {
+        CHECK(next[p] == kItemsPerProducer);
+      }
+      CHECK(ulTaskNotifyTakeIndexed(kSyncKitNotifyIndex, pdTRUE, 0) == 0);
+    }, 1);
+    for (std::thread &t : producers)
+    {
+      t.join();
+    }
+
+    if (errors != 0 || received != accepted.load() || q.dropped() != rejected.load())
+    {
+      fprintf(stderr, "%s: errors=%u received=%u accepted=%u dropped=%u rejected=%u\n", name,
+              static_cast<unsigned>(errors), static_cast<unsigned>(received), static_cast<unsigned>(accepted.load()),
+              static_cast<unsigned>(q.dropped()), static_cast<unsigned>(rejected.load()));
+    }
+    CHECK(errors == 0);
+    CHECK(received == accepted.load());
+    CHECK(q.dropped() == rejected.load());
+    CHECK(accepted.load() >= kTaskProducers * kItemsPerProducer);
+    CHECK(q.count() == 0);
+  }
+} // namespace
+
+int main()
+{
+  ESP32SyncKitHost::setLogEcho(false);
+  stress<2>("MpscQueue<2>");
+  stress<8>("MpscQueue<8>");
+  return HostTest::report("test_mpsc_queue");
+}
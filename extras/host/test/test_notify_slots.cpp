@@ -0,0 +1,274 @@
+// en: Notification-based waits use their own NotifyIndex slot and never leave a stale count behind, even when the
+// en: wake-up races the timeout; a Notify on another slot of the same task is left untouched
+// ja: 通知で待つプリミティブは NotifyIndex 番のスロットだけを使い、起床がタイムアウトと競合しても古いカウントを
+// ja: 残さない。同じタスクの別スロットの Notify には影響しない
+
+#include "host_test.h"
+
+#include <ESP32SyncKit.h>
+#include <ESP32SyncKitFuture.h>
+#include <ESP32SyncKitLatest.h>
+#include <ESP32SyncKitMpscQueue.h>
+#include <ESP32SyncKitSpscQueue.h>
+#include <ESP32SyncKitTopic.h>
+#include <ESP32SyncKitWorkPool.h>
+#include <esp_rom_sys.h>
+
+#include <random>
+
+using namespace ESP32SyncKit;
+
+namespace
+{
+  constexpr uint32_t kRounds = 400;
+
+  // en: Calls wait(round) from a task with a 1 ms timeout while another task calls wake(round) after a random
+  // en: delay around that timeout, then checks that no count is left in slot 0 or 1 of the waiting task
+  // ja: 待機タスクから 1 ms のタイムアウトで wait(round) を呼び、別のタスクがそのタイムアウト前後のランダムな遅延の後に
+  // ja: wake(round) を呼ぶ。最後に待機タスクのスロット 0 と 1 にカウントが残っていないことを確認する
+  template <class Wait, class Wake>
+  void race(const char *name, Wait wait, Wake wake)
+  {
+    std::atomic<uint32_t> round{0};
+    std::atomic<bool> stop{false};
+    std::thread waker([&] {
+      HostTest::runTask([&] {
+        std::minstd_rand rng(1);
+        uint32_t seen = 0;
+        while (!stop.load())
+        {
+          const uint32_t r = round.load();
+          if (r == seen)
+          {
+            taskYIELD();
+            continue;
+          }
+          seen = r;
+          esp_rom_delay_us(rng() % 2000);
+          wake(r);
+        }
+      }, 1);
+    });
+    HostTest::runTask([&] {
+      for (uint32_t r = 1; r <= kRounds; ++r)
+      {
+        round.store(r);
+        wait(r);
+      }
+      stop.store(true);
+      vTaskDelay(pdMS_TO_TICKS(5));
+      const uint32_t stale0 = ulTaskNotifyTakeIndexed(0, pdTRUE, 0);
+      const uint32_t stale1 = ulTaskNotifyTakeIndexed(1, pdTRUE, 0);
+      if (stale0 != 0 || stale1 != 0)
+      {
+        fprintf(stderr, "%s: stale counts %u/%u\n", name, static_cast<unsigned>(stale0), static_cast<unsigned>(stale1));
+      }
+      CHECK(stale0 == 0 && stale1 == 0);
+    });
+    waker.join();
+  }
+
+  void testSpscNoStale()
+  {
+    SpscQueue<uint32_t, 4> q;
+    race("SpscQueue", [&](uint32_t) { uint32_t v; (void)q.receive(v, 1); }, [&](uint32_t r) { (void)q.trySend(r); });
+  }
+
+  void testMpscNoStale()
+  {
+    MpscQueue<uint32_t, 4> q;
+    race("MpscQueue", [&](uint32_t) { uint32_t v; (void)q.receive(v, 1); }, [&](uint32_t r) { (void)q.trySend(r); });
+  }
+
+  void testLatestNoStale()
+  {
+    Latest<uint32_t, WakeOnUpdate> cell;
+    uint32_t version = 0;
+    race("Latest", [&](uint32_t) { uint32_t v; (void)cell.waitNewer(v, version, 1); }, [&](uint32_t r) { cell.write(r); });
+  }
+
+  void testTopicNoStale()
+  {
+    Topic<uint32_t, 4, 1> topic;
+    Topic<uint32_t, 4, 1>::Subscriber sub(topic);
+    race("Topic", [&](uint32_t) { uint32_t v; (void)sub.receive(v, 1); }, [&](uint32_t r) { (void)topic.publish(r, 0); });
+  }
+
+  void testFutureNoStale()
+  {
+    Future<uint32_t> future;
+    std::atomic<uint32_t> armed{0};
+    Promise<uint32_t> promise;
+    race(
+        "Future",
+        [&](uint32_t r) {
+          promise = future.promise();
+          armed.store(r);
+          uint32_t v;
+          (void)future.get(v, 1);
+          while (armed.load() != 0)
+          {
+            taskYIELD(); // en: the waker is done with this round's Promise / ja: 起こす側がこの回の Promise を使い終えるまで
+          }
+        },
+        [&](uint32_t r) {
+          while (armed.load() != r)
+          {
+            taskYIELD();
+          }
+          (void)promise.set(r);
+          armed.store(0);
+        });
+  }
+
+  void testBatchNoStale()
+  {
+    Queue<uint32_t, NoStats, LogAll, WithBatch<>> q(8);
+    race(
+        "Queue::receiveBatch",
+        [&](uint32_t r) {
+          uint32_t out[4];
+          (void)q.trySend(r);
+          (void)q.receiveBatch(out, 4, 2, 1, 0);
+        },
+        [&](uint32_t r) { (void)q.trySend(r); });
+    uint32_t out[8];
+    (void)q.tryReceiveMany(out, 8);
+  }
+
+  void testCompletionNoStale()
+  {
+    WorkPool<> pool;
+    CHECK(pool.begin());
+    std::minstd_rand rng(2);
+    HostTest::runTask([&] {
+      for (uint32_t r = 0; r < kRounds; ++r)
+      {
+        Completion done;
+        const uint32_t us = rng() % 2000;
+        CHECK(pool.submit(done, [us] { esp_rom_delay_us(us); }));
+        while (!done.wait(1))
+        {
+        }
+      }
+      CHECK(ulTaskNotifyTakeIndexed(kSyncKitNotifyIndex, pdTRUE, 0) == 0);
+    });
+    CHECK(pool.end());
+  }
+
+  // en: A default SpscQueue and a default Notify counter on the same consumer do not disturb each other
+  // ja: 同じ消費者の既定の SpscQueue と既定の Notify カウンタは互いに干渉しない
+  void testSeparateSlots()
+  {
+    static_assert(kSyncKitNotifyIndex != 0, "the host shim has a second notification slot");
+    constexpr uint32_t kItems = 200;
+    SpscQueue<uint32_t, 2> q;
+    std::atomic<TaskHandle_t> consumer{nullptr};
+    std::thread producer([&] {
+      HostTest::runTask([&] {
+        while (consumer.load() == nullptr)
+        {
+          taskYIELD();
+        }
+        Notify counter(consumer.load());
+        for (uint32_t i = 0; i < kItems; ++i)
+        {
+          CHECK(q.send(i, 1000));
+          CHECK(counter.notify());
+        }
+      }, 1);
+    });
+    HostTest::runTask([&] {
+      Notify counter;
+      CHECK(counter.bindToSelf());
+      consumer.store(xTaskGetCurrentTaskHandle());
+      uint32_t received = 0;
+      uint32_t v = 0;
+      while (received < kItems && q.receive(v, 1000))
+      {
+        CHECK(v == received);
+        ++received;
+      }
+      CHECK(received == kItems);
+      uint32_t notified = 0;
+      while (notified < kItems && counter.take(1000))
+      {
+        ++notified;
+      }
+      CHECK(notified == kItems);
+      CHECK(counter.takeAll(0) == 0);
+    });
+    producer.join();
+  }
+
+  // en: receiveBatch on the default WithBatch slot leaves a default Notify counter of the same consumer intact
+  // ja: 既定の WithBatch スロットでの receiveBatch は、同じ消費者の既定の Notify カウンタを壊さない
+  void testBatchSeparateSlot()
+  {
+    constexpr uint32_t kItems = 400;
+    Queue<uint32_t, NoStats, LogAll, WithBatch<>> q(16);
+    std::atomic<TaskHandle_t> consumer{nullptr};
+    std::thread producer([&] {
+      HostTest::runTask([&] {
+        while (consumer.load() == nullptr)
+        {
+          taskYIELD();
+        }
+        Notify counter(consumer.load());
+        for (uint32_t i = 0; i < kItems; ++i)
+        {
+          CHECK(q.send(i, 1000));
+          CHECK(counter.notify());
+          if (i % 4 == 0)
+          {
+            vTaskDelay(1);
+          }
+        }
+      }, 1);
+    });
+    HostTest::runTask([&] {
+      Notify counter;
+      CHECK(counter.bindToSelf());
+      consumer.store(xTaskGetCurrentTaskHandle());
+      uint32_t received = 0;
+      uint32_t out[8];
+      while (received < kItems)
+      {
+        const uint32_t n = q.receiveBatch(out, 8, 4, 5, 1000);
+        if (n == 0)
+        {
+          break;
+        }
+        for (uint32_t i = 0; i < n; ++i)
+        {
+          CHECK(out[i] == received + i);
+        }
+        received += n;
+      }
+      CHECK(received == kItems);
+      uint32_t notified = 0;
+      while (notified < kItems && counter.take(1000))
+      {
+        ++notified;
+      }
+      CHECK(notified == kItems);
+      CHECK(ulTaskNotifyTakeIndexed(kSyncKitNotifyIndex, pdTRUE, 0) == 0);
+    });
+    producer.join();
+  }
+} // namespace
+
+int main()
+{
+  ESP32SyncKitHost::setLogEcho(false);
+  testSpscNoStale();
+  testMpscNoStale();
+  testLatestNoStale();
+  testTopicNoStale();
+  testFutureNoStale();
+  testBatchNoStale();
+  testCompletionNoStale();
+  testSeparateSlots();
+  testBatchSeparateSlot();
+  return HostTest::report("test_notify_slots");
+}
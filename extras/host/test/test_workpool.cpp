@@ -0,0 +1,127 @@
+// en: WorkPool nesting: a blocking parallelFor() inside a job sleeps instead of spinning once there is nothing to
+// en: steal, leaves the worker's notification slot clean, and mixed with inbox submissions never loses a wake-up
+// ja: WorkPool の入れ子: ジョブ内のブロッキング版 parallelFor() は奪える仕事がなくなると空回りせずに眠り、
+// ja: ワーカの通知スロットにカウントを残さず、受付キューへの投入と混ざっても起床を失わない
+
+#include "host_test.h"
+
+#include <ESP32SyncKit.h>
+#include <ESP32SyncKitWorkPool.h>
+#include <esp_rom_sys.h>
+
+#include <time.h>
+
+#include <random>
+
+using namespace ESP32SyncKit;
+
+namespace
+{
+  // en: Room for the test lambdas' reference captures / ja: テストのラムダの参照キャプチャが入る大きさ
+  using Pool = WorkPool<32, 64>;
+
+  uint64_t threadCpuUs()
+  {
+    timespec ts;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return static_cast<uint64_t>(ts.tv_sec) * 1000000u + static_cast<uint64_t>(ts.tv_nsec) / 1000u;
+  }
+
+  // en: The other worker steals the upper half and blocks 50 ms in its last chunk; the caller's CPU time while it
+  // en: waits for that chunk stays far below 50 ms
+  // ja: 他方のワーカが上半分を奪い、その最後の断片で 50 ms ブロックする。その断片を待つ間の呼び出し側の CPU 時間は
+  // ja: 50 ms を大きく下回る
+  void testNestedSleeps()
+  {
+    constexpr uint32_t kItems = 64;
+    Pool pool;
+    CHECK(pool.begin());
+    std::atomic<uint32_t> sum{0};
+    std::atomic<bool> blocked{false};
+    uint64_t waitCpuUs = 0;
+    uint32_t stale = 0;
+    HostTest::runTask([&] {
+      Completion done;
+      CHECK(pool.submit(done, [&] {
+        const TaskHandle_t caller = xTaskGetCurrentTaskHandle();
+        const uint64_t start = threadCpuUs();
+        CHECK(pool.parallelFor(0, kItems, 1, [&, caller](uint32_t begin, uint32_t end) {
+          for (uint32_t i = begin; i < end; ++i)
+          {
+            sum.fetch_add(i);
+          }
+          if (xTaskGetCurrentTaskHandle() == caller)
+          {
+            esp_rom_delay_us(100);
+          }
+          else if (end == kItems)
+          {
+            blocked.store(true);
+            vTaskDelay(pdMS_TO_TICKS(50));
+          }
+        }));
+        waitCpuUs = threadCpuUs() - start;
+        stale = ulTaskNotifyTakeIndexed(kSyncKitNotifyIndex, pdTRUE, 0);
+      }));
+      CHECK(done.wait());
+    });
+    CHECK(pool.end());
+
+    CHECK(sum.load() == kItems * (kItems - 1) / 2);
+    CHECK(stale == 0);
+    if (blocked.load() && waitCpuUs >= 20000)
+    {
+      fprintf(stderr, "nested parallelFor: %u us of CPU while waiting\n", static_cast<unsigned>(waitCpuUs));
+    }
+    CHECK(!blocked.load() || waitCpuUs < 20000);
+  }
+
+  // en: Jobs that each run a nested parallelFor(), interleaved with plain submissions through the inbox: every job
+  // en: runs once, and helpers woken by deque pushes leave no count on their slot
+  // ja: それぞれ入れ子の parallelFor() を実行するジョブと、受付キューを通る通常の投入を交互に行う。すべての
+  // ja: ジョブが1回ずつ実行され、deque への push で起こされたヘルパーのスロットにカウントが残らない
+  void testNestedMixed()
+  {
+    constexpr uint32_t kRounds = 200;
+    constexpr uint32_t kItems = 32;
+    Pool pool;
+    CHECK(pool.begin());
+    std::atomic<uint32_t> ranges{0};
+    std::atomic<uint32_t> plain{0};
+    HostTest::runTask([&] {
+      std::minstd_rand rng(3);
+      for (uint32_t r = 0; r < kRounds; ++r)
+      {
+        Completion done;
+        const uint32_t us = rng() % 300;
+        for (uint32_t j = 0; j < 2; ++j)
+        {
+          CHECK(pool.submit(done, [&, us] {
+            std::atomic<uint32_t> items{0};
+            CHECK(pool.parallelFor(0, kItems, 2, [&, us](uint32_t begin, uint32_t end) {
+              items.fetch_add(end - begin);
+              esp_rom_delay_us(us);
+            }));
+            CHECK(items.load() == kItems);
+            CHECK(ulTaskNotifyTakeIndexed(kSyncKitNotifyIndex, pdTRUE, 0) == 0);
+            ranges.fetch_add(1);
+          }));
+          CHECK(pool.submit(done, [&] { plain.fetch_add(1); }));
+        }
+        CHECK(done.wait(5000));
+      }
+      CHECK(ulTaskNotifyTakeIndexed(kSyncKitNotifyIndex, pdTRUE, 0) == 0);
+    });
+    CHECK(pool.end(5000));
+    CHECK(ranges.load() == 2 * kRounds);
+    CHECK(plain.load() == 2 * kRounds);
+  }
+} // namespace
+
+int main()
+{
+  ESP32SyncKitHost::setLogEcho(false);
+  testNestedSleeps();
+  testNestedMixed();
+  return HostTest::report("test_workpool");
+}
@@ -2,6 +2,13 @@
 
 #include <Arduino.h>
 #include <esp_log.h>
+#include <esp_rom_sys.h>
+#include <esp_timer.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <atomic>
+#include <chrono>
+#include <type_traits>
 #include <utility>
 
 #include <freertos/FreeRTOS.h>
@@ -14,63 +21,785 @@ namespace ESP32SyncKit
 
   constexpr uint32_t WaitForever = portMAX_DELAY;
   inline constexpr const char *kLogTag = "ESP32SyncKit";
+  // en: Cache line size used to keep producer/consumer fields apart
+  // ja: 生産者/消費者側のフィールドを分離するためのキャッシュライン長
+  inline constexpr size_t kCacheLineSize = 32;
 
-  template <class T>
-  class Queue
+  namespace detail
+  {
+    // en: Tag for adopting an already created handle (used by the Static* variants)
+    // ja: 生成済みハンドルを引き取るためのタグ（Static* 版で使用）
+    struct AdoptHandle
+    {
+    };
+
+    // en: Enabled when Other is a class derived from Base: a Static* variant, whose handle points into its own storage
+    // ja: Other が Base の派生クラス、つまりハンドルが自身の領域を指す Static* 版のときに有効
+    template <class Base, class Other>
+    using EnableIfDerived = typename std::enable_if<std::is_base_of<Base, typename std::decay<Other>::type>::value &&
+                                                        !std::is_same<Base, typename std::decay<Other>::type>::value,
+                                                    int>::type;
+
+    // en: Grants library-internal helpers (e.g. Select) access to the native handle
+    // ja: ライブラリ内部の補助クラス（Select など）にネイティブハンドルへのアクセスを許可する
+    struct HandleAccess
+    {
+      // en: Creates a lazily constructed primitive on the way (task context)
+      // ja: 遅延生成のプリミティブはここで生成される（タスク文脈）
+      template <class Primitive>
+      static auto get(Primitive &primitive) { return primitive.ensureCreated(); }
+    };
+  } // namespace detail
+
+  // en: Absolute time budget on the esp_timer clock. Build one from milliseconds or any std::chrono duration and
+  // en: pass it to every blocking call in a chain: each call waits only for what is left, so the total never drifts.
+  // en: Tick-granular by default (a positive budget rounds up to at least one tick); precise() also polls
+  // en: the sub-tick remainder so all-or-nothing calls end within microseconds of the deadline.
+  // ja: esp_timer の時計による絶対的な時間予算。ミリ秒または任意の std::chrono の時間から作り、一連のブロッキング
+  // ja: 呼び出しすべてに渡す。各呼び出しは残り時間だけ待つので、合計がずれることはない。
+  // ja: 既定ではティック単位（正の予算は最低1ティックに切り上げ）。precise() では1ティック未満の残りもポーリングし、
+  // ja: 全部か無しの呼び出しは期限からマイクロ秒単位の誤差で終わる
+  class Deadline
   {
   public:
-    explicit Queue(uint32_t depth)
-        : handle_(nullptr)
+    // en: Relative budget from now; WaitForever means no deadline
+    // ja: 現在からの相対的な予算。WaitForever は期限なし
+    static Deadline after(uint32_t timeoutMs)
+    {
+      return timeoutMs == WaitForever ? never() : Deadline(esp_timer_get_time() + static_cast<int64_t>(timeoutMs) * 1000);
+    }
+
+    // en: Absolute deadline in esp_timer_get_time() microseconds
+    // ja: esp_timer_get_time() のマイクロ秒で表した絶対期限
+    static Deadline at(int64_t timeUs) { return Deadline(timeUs); }
+
+    static Deadline never() { return Deadline(kNeverUs); }
+
+    // en: Implicit, so blocking calls accept durations directly: queue.send(v, 250ms)
+    // ja: 暗黙変換なので、ブロッキング呼び出しに時間をそのまま渡せる: queue.send(v, 250ms)
+    template <class Rep, class Period>
+    Deadline(std::chrono::duration<Rep, Period> budget)
+        : atUs_(esp_timer_get_time() + std::chrono::ceil<std::chrono::microseconds>(budget).count())
+    {
+    }
+
+    Deadline precise() const
+    {
+      Deadline copy = *this;
+      copy.precise_ = true;
+      return copy;
+    }
+
+    bool isPrecise() const { return precise_; }
+    bool isNever() const { return atUs_ == kNeverUs; }
+    bool expired() const { return !isNever() && esp_timer_get_time() >= atUs_; }
+    int64_t atUs() const { return atUs_; }
+
+    // en: Time left (0 once expired, INT64_MAX for never)
+    // ja: 残り時間（期限切れなら 0、期限なしなら INT64_MAX）
+    int64_t remainingUs() const
+    {
+      if (isNever())
+      {
+        return kNeverUs;
+      }
+      const int64_t left = atUs_ - esp_timer_get_time();
+      return left > 0 ? left : 0;
+    }
+
+    // en: What is left as a whole-tick timeoutMs for the uint32_t APIs (rounded up, or down when precise)
+    // ja: 残り時間を uint32_t API 用のティック単位の timeoutMs にしたもの（切り上げ。precise では切り捨て）
+    uint32_t timeoutMs() const
+    {
+      if (isNever())
+      {
+        return WaitForever;
+      }
+      constexpr int64_t tickUs = static_cast<int64_t>(portTICK_PERIOD_MS) * 1000;
+      const int64_t left = remainingUs();
+      const int64_t ticks = precise_ ? left / tickUs : (left + tickUs - 1) / tickUs;
+      const int64_t ms = ticks * static_cast<int64_t>(portTICK_PERIOD_MS);
+      return ms >= static_cast<int64_t>(WaitForever) ? WaitForever - 1 : static_cast<uint32_t>(ms);
+    }
+
+  private:
+    static constexpr int64_t kNeverUs = INT64_MAX;
+
+    explicit Deadline(int64_t atUs) : atUs_(atUs) {}
+
+    int64_t atUs_;
+    bool precise_ = false;
+  };
+
+  namespace detail
+  {
+    // en: Gap between polls of the sub-tick remainder of a precise deadline
+    // ja: precise な期限の1ティック未満の残りをポーリングする間隔
+    constexpr int64_t kPrecisePollUs = 50;
+
+    // en: Run a timeoutMs-based call against a Deadline. Only bool (all-or-nothing) calls are retried for the
+    // en: sub-tick remainder of a precise deadline; partial-count calls are never repeated. Each retry first yields
+    // en: to ready tasks of the same priority and then waits kPrecisePollUs, so the poll does not hammer the object.
+    // ja: timeoutMs ベースの呼び出しを Deadline で実行する。precise な期限の1ティック未満の残りで再試行するのは
+    // ja: bool（全部か無し）の呼び出しだけで、件数を返す部分成功型の呼び出しは繰り返さない。再試行の前には同じ
+    // ja: 優先度の実行可能タスクへ譲り、kPrecisePollUs 待つため、オブジェクトを連打しない
+    template <class Op>
+    auto untilDeadline(const Deadline &deadline, Op op) -> decltype(op(uint32_t{0}))
+    {
+      auto result = op(deadline.timeoutMs());
+      if constexpr (std::is_same<decltype(result), bool>::value)
+      {
+        while (!result && deadline.isPrecise() && !deadline.expired() && !xPortInIsrContext())
+        {
+          taskYIELD();
+          const int64_t left = deadline.remainingUs();
+          esp_rom_delay_us(static_cast<uint32_t>(left < kPrecisePollUs ? left : kPrecisePollUs));
+          result = op(deadline.timeoutMs());
+        }
+      }
+      return result;
+    }
+  } // namespace detail
+
+  // en: Stats policies. NoStats (default) compiles every hook away; WithStats keeps ISR-safe atomic counters.
+  // ja: 統計ポリシー。NoStats（既定）はフックをすべて消去し、WithStats は ISR 安全な atomic カウンタを持つ
+  struct NoStats
+  {
+  };
+  struct WithStats
+  {
+  };
+  // en: Mutex only: WithStats plus wait/hold histograms and owner tracking (see ESP32SyncKitMutexProfile.h)
+  // ja: Mutex 専用: WithStats に待ち/保持ヒストグラムと所有者追跡を加える（ESP32SyncKitMutexProfile.h 参照）
+  struct WithProfile
+  {
+  };
+
+  // en: Snapshot returned by stats(). For Mutex, sends = unlocks and receives = locks.
+  // ja: stats() が返すスナップショット。Mutex では sends = unlock 回数、receives = lock 回数
+  struct StatsSnapshot
+  {
+    uint32_t sends = 0;          // en: successful send/give/notify/setBits / ja: 送信成功数
+    uint32_t receives = 0;       // en: successful receive/take/waitBits / ja: 受信成功数
+    uint32_t failures = 0;       // en: full/empty/ISR/misuse failures / ja: 満杯/空/ISR/誤用による失敗
+    uint32_t timeouts = 0;       // en: blocking waits that expired / ja: ブロック待ちのタイムアウト
+    uint32_t peakCount = 0;      // en: highest occupancy seen (Queue only) / ja: 最大滞留数（Queue のみ）
+    uint64_t blockedUsTotal = 0; // en: cumulative time spent blocked / ja: ブロックしていた累計時間
+    uint32_t blockedUsMax = 0;   // en: longest single block / ja: 1回あたりの最長ブロック時間
+    uint32_t batches = 0;        // en: receiveBatch() calls that returned items (Queue only) / ja: 要素を返した receiveBatch() の回数（Queue のみ）
+    uint32_t batchItems = 0;     // en: items returned by those calls / ja: それらが返した要素数
+    uint32_t batchMax = 0;       // en: largest batch returned / ja: 最大バッチサイズ
+  };
+
+  namespace detail
+  {
+    // en: Per-lock() scratch passed from lockBegin() to lockAcquired()
+    // ja: lockBegin() から lockAcquired() へ渡す lock() 1回分の作業値
+    struct LockProbe
+    {
+      int64_t startUs = -1;
+    };
+
+    template <class Policy>
+    class StatsRecorder;
+
+    template <>
+    class StatsRecorder<NoStats>
+    {
+    public:
+      static constexpr bool kStatsEnabled = false;
+
+      StatsSnapshot stats() const { return StatsSnapshot{}; }
+      void resetStats() {}
+
+    protected:
+      static int64_t blockBegin(TickType_t) { return -1; }
+      static void blockEnd(int64_t) {}
+      static void countSend(uint32_t = 1) {}
+      static void countReceive(uint32_t = 1) {}
+      static void countFailure(bool) {}
+      static void observeCount(uint32_t) {}
+      static void countBatch(uint32_t) {}
+      static LockProbe lockBegin(SemaphoreHandle_t, TickType_t) { return LockProbe{}; }
+      static void lockAcquired(const LockProbe &) {}
+      static void lockReleasing(SemaphoreHandle_t) {}
+    };
+
+    template <>
+    class StatsRecorder<WithStats>
     {
-      if (depth == 0)
+    public:
+      static constexpr bool kStatsEnabled = true;
+
+      StatsSnapshot stats() const
+      {
+        StatsSnapshot snap;
+        snap.sends = sends_.load(std::memory_order_relaxed);
+        snap.receives = receives_.load(std::memory_order_relaxed);
+        snap.failures = failures_.load(std::memory_order_relaxed);
+        snap.timeouts = timeouts_.load(std::memory_order_relaxed);
+        snap.peakCount = peakCount_.load(std::memory_order_relaxed);
+        snap.blockedUsTotal = blockedUsTotal_.load(std::memory_order_relaxed);
+        snap.blockedUsMax = blockedUsMax_.load(std::memory_order_relaxed);
+        snap.batches = batches_.load(std::memory_order_relaxed);
+        snap.batchItems = batchItems_.load(std::memory_order_relaxed);
+        snap.batchMax = batchMax_.load(std::memory_order_relaxed);
+        return snap;
+      }
+
+      void resetStats()
+      {
+        sends_.store(0, std::memory_order_relaxed);
+        receives_.store(0, std::memory_order_relaxed);
+        failures_.store(0, std::memory_order_relaxed);
+        timeouts_.store(0, std::memory_order_relaxed);
+        peakCount_.store(0, std::memory_order_relaxed);
+        blockedUsTotal_.store(0, std::memory_order_relaxed);
+        blockedUsMax_.store(0, std::memory_order_relaxed);
+        batches_.store(0, std::memory_order_relaxed);
+        batchItems_.store(0, std::memory_order_relaxed);
+        batchMax_.store(0, std::memory_order_relaxed);
+      }
+
+    protected:
+      // en: Timestamp only calls that may actually block (ticks != 0)
+      // ja: 実際にブロックし得る呼び出し（ticks != 0）だけ時刻を取る
+      static int64_t blockBegin(TickType_t ticks) { return ticks ? esp_timer_get_time() : -1; }
+
+      void blockEnd(int64_t start)
+      {
+        if (start < 0)
+        {
+          return;
+        }
+        const uint32_t us = static_cast<uint32_t>(esp_timer_get_time() - start);
+        blockedUsTotal_.fetch_add(us, std::memory_order_relaxed);
+        raise(blockedUsMax_, us);
+      }
+
+      void countSend(uint32_t n = 1) { sends_.fetch_add(n, std::memory_order_relaxed); }
+      void countReceive(uint32_t n = 1) { receives_.fetch_add(n, std::memory_order_relaxed); }
+      void countFailure(bool timedOut) { (timedOut ? timeouts_ : failures_).fetch_add(1, std::memory_order_relaxed); }
+      void observeCount(uint32_t count) { raise(peakCount_, count); }
+      void countBatch(uint32_t n)
+      {
+        batches_.fetch_add(1, std::memory_order_relaxed);
+        batchItems_.fetch_add(n, std::memory_order_relaxed);
+        raise(batchMax_, n);
+      }
+      static LockProbe lockBegin(SemaphoreHandle_t, TickType_t) { return LockProbe{}; }
+      static void lockAcquired(const LockProbe &) {}
+      static void lockReleasing(SemaphoreHandle_t) {}
+
+    private:
+      static void raise(std::atomic<uint32_t> &target, uint32_t value)
+      {
+        uint32_t cur = target.load(std::memory_order_relaxed);
+        while (value > cur && !target.compare_exchange_weak(cur, value, std::memory_order_relaxed))
+        {
+        }
+      }
+
+      std::atomic<uint32_t> sends_{0};
+      std::atomic<uint32_t> receives_{0};
+      std::atomic<uint32_t> failures_{0};
+      std::atomic<uint32_t> timeouts_{0};
+      std::atomic<uint32_t> peakCount_{0};
+      std::atomic<uint64_t> blockedUsTotal_{0};
+      std::atomic<uint32_t> blockedUsMax_{0};
+      std::atomic<uint32_t> batches_{0};
+      std::atomic<uint32_t> batchItems_{0};
+      std::atomic<uint32_t> batchMax_{0};
+    };
+  } // namespace detail
+
+  // en: Log policies. LogAll (default) prints like before; LogRateLimited prints at most one message per
+  // en: IntervalMs per instance and never prints timeouts; LogNone compiles every message away.
+  // en: Messages raised in an ISR are always deferred to a ring and printed later from a task.
+  // ja: ログポリシー。LogAll（既定）は従来どおり出力、LogRateLimited はインスタンスごとに IntervalMs に1件まで
+  // ja: 出力しタイムアウトは出力しない、LogNone はメッセージをすべて消去する。
+  // ja: ISR 内で発生したメッセージは常にリングへ退避し、後でタスクから出力する
+  struct LogAll
+  {
+  };
+  template <uint32_t IntervalMs = 1000>
+  struct LogRateLimited
+  {
+  };
+  struct LogNone
+  {
+  };
+
+  namespace detail
+  {
+    // en: Lock-free multi-producer ring for messages raised in ISRs. Producers claim a slot with a CAS
+    // en: and drop the message when the ring is full; flush() runs in task context.
+    // ja: ISR で発生したメッセージ用のロックフリー多生産者リング。生産者は CAS でスロットを確保し、
+    // ja: 満杯ならメッセージを捨てる。flush() はタスク文脈で実行する
+    class DeferredLog
+    {
+    public:
+      static constexpr uint32_t kEntries = 16;
+
+      void push(esp_log_level_t level, const char *format, long arg)
+      {
+        const uint32_t index = next_.fetch_add(1, std::memory_order_relaxed);
+        Entry &entry = entries_[index % kEntries];
+        uint32_t expected = kEmpty;
+        if (!entry.state.compare_exchange_strong(expected, kWriting, std::memory_order_acquire, std::memory_order_relaxed))
+        {
+          dropped_.fetch_add(1, std::memory_order_relaxed);
+          return;
+        }
+        entry.level = level;
+        entry.format = format;
+        entry.arg = arg;
+        entry.state.store(kReady, std::memory_order_release);
+        pending_.fetch_add(1, std::memory_order_release);
+      }
+
+      bool hasPending() const
       {
-        ESP_LOGE(kLogTag, "[Queue] create failed: depth must be > 0");
-        return;
+        return pending_.load(std::memory_order_relaxed) != 0 || dropped_.load(std::memory_order_relaxed) != 0;
       }
-      handle_ = xQueueCreate(depth, sizeof(T));
-      if (!handle_)
+
+      uint32_t flush()
       {
-        ESP_LOGE(kLogTag, "[Queue] create failed: xQueueCreate");
+        bool expected = false;
+        if (!flushing_.compare_exchange_strong(expected, true, std::memory_order_acquire, std::memory_order_relaxed))
+        {
+          return 0; // en: another task is flushing / ja: 他タスクが出力中
+        }
+
+        uint32_t printed = 0;
+        const uint32_t start = next_.load(std::memory_order_relaxed);
+        for (uint32_t i = 0; i < kEntries; ++i)
+        {
+          Entry &entry = entries_[(start + i) % kEntries];
+          uint32_t ready = kReady;
+          if (!entry.state.compare_exchange_strong(ready, kReading, std::memory_order_acquire, std::memory_order_relaxed))
+          {
+            continue;
+          }
+          const esp_log_level_t level = entry.level;
+          const char *format = entry.format;
+          const long arg = entry.arg;
+          entry.state.store(kEmpty, std::memory_order_release);
+          pending_.fetch_sub(1, std::memory_order_relaxed);
+
+          char line[96];
+          snprintf(line, sizeof(line), format, arg);
+          if (level == ESP_LOG_ERROR)
+          {
+            ESP_LOGE(kLogTag, "%s (ISR)", line);
+          }
+          else
+          {
+            ESP_LOGW(kLogTag, "%s (ISR)", line);
+          }
+          ++printed;
+        }
+
+        const uint32_t dropped = dropped_.exchange(0, std::memory_order_relaxed);
+        if (dropped != 0)
+        {
+          ESP_LOGW(kLogTag, "%lu ISR log messages dropped (ring full)", static_cast<unsigned long>(dropped));
+        }
+        flushing_.store(false, std::memory_order_release);
+        return printed;
+      }
+
+    private:
+      static constexpr uint32_t kEmpty = 0;
+      static constexpr uint32_t kWriting = 1;
+      static constexpr uint32_t kReady = 2;
+      static constexpr uint32_t kReading = 3;
+
+      struct Entry
+      {
+        std::atomic<uint32_t> state{kEmpty};
+        esp_log_level_t level = ESP_LOG_WARN;
+        const char *format = nullptr;
+        long arg = 0;
+      };
+
+      Entry entries_[kEntries];
+      std::atomic<uint32_t> next_{0};
+      std::atomic<uint32_t> pending_{0};
+      std::atomic<uint32_t> dropped_{0};
+      std::atomic<bool> flushing_{false};
+    };
+
+    // en: Constant-initialized, so it is safe to use from an ISR before any task touched it
+    // ja: 定数初期化されるため、どのタスクより先に ISR から使っても安全
+    inline DeferredLog deferredLog;
+
+    // en: Format and print one message in task context (only reached on failure paths)
+    // ja: タスク文脈で1件を整形して出力（失敗パスでのみ到達）
+    inline void emitLog(esp_log_level_t level, const char *format, long arg)
+    {
+      char line[96];
+      snprintf(line, sizeof(line), format, arg);
+      if (level == ESP_LOG_ERROR)
+      {
+        ESP_LOGE(kLogTag, "%s", line);
+      }
+      else
+      {
+        ESP_LOGW(kLogTag, "%s", line);
       }
     }
 
+    template <class Policy>
+    class Diagnostics;
+
+    template <>
+    class Diagnostics<LogAll>
+    {
+    protected:
+      static void logError(const char *format, long arg = 0) { log(ESP_LOG_ERROR, format, arg); }
+      static void logWarn(const char *format, long arg = 0) { log(ESP_LOG_WARN, format, arg); }
+      static void logTimeout(const char *format) { log(ESP_LOG_WARN, format, 0); }
+
+    private:
+      static void log(esp_log_level_t level, const char *format, long arg)
+      {
+        if (xPortInIsrContext())
+        {
+          deferredLog.push(level, format, arg);
+          return;
+        }
+        if (deferredLog.hasPending())
+        {
+          (void)deferredLog.flush();
+        }
+        emitLog(level, format, arg);
+      }
+    };
+
+    template <uint32_t IntervalMs>
+    class Diagnostics<LogRateLimited<IntervalMs>>
+    {
+      static_assert(IntervalMs > 0, "LogRateLimited: IntervalMs must be > 0");
+
+    protected:
+      void logError(const char *format, long arg = 0) const { log(ESP_LOG_ERROR, format, arg); }
+      void logWarn(const char *format, long arg = 0) const { log(ESP_LOG_WARN, format, arg); }
+      // en: Timeouts are flow control here: count them with WithStats instead of printing
+      // ja: ここではタイムアウトはフロー制御とみなす。出力せず WithStats で数えること
+      static void logTimeout(const char *) {}
+
+    private:
+      void log(esp_log_level_t level, const char *format, long arg) const
+      {
+        if (xPortInIsrContext())
+        {
+          deferredLog.push(level, format, arg);
+          return;
+        }
+        if (deferredLog.hasPending())
+        {
+          (void)deferredLog.flush();
+        }
+
+        const uint32_t now = pdTICKS_TO_MS(xTaskGetTickCount());
+        uint32_t last = lastMs_.load(std::memory_order_relaxed);
+        if (now - last < IntervalMs || !lastMs_.compare_exchange_strong(last, now, std::memory_order_relaxed))
+        {
+          suppressed_.fetch_add(1, std::memory_order_relaxed);
+          return;
+        }
+        const uint32_t suppressed = suppressed_.exchange(0, std::memory_order_relaxed);
+        if (suppressed != 0)
+        {
+          ESP_LOGW(kLogTag, "%lu messages suppressed by rate limit", static_cast<unsigned long>(suppressed));
+        }
+        emitLog(level, format, arg);
+      }
+
+      mutable std::atomic<uint32_t> lastMs_{0u - IntervalMs}; // en: first message always passes / ja: 最初の1件は必ず出力
+      mutable std::atomic<uint32_t> suppressed_{0};
+    };
+
+    template <>
+    class Diagnostics<LogNone>
+    {
+    protected:
+      static void logError(const char *, long = 0) {}
+      static void logWarn(const char *, long = 0) {}
+      static void logTimeout(const char *) {}
+    };
+  } // namespace detail
+
+  // en: Print messages deferred from ISRs now (call from loop() or an idle task). Returns the number printed.
+  // ja: ISR から退避されたメッセージを今すぐ出力（loop() やアイドル的なタスクから呼ぶ）。出力件数を返す
+  inline uint32_t flushDeferredLogs()
+  {
+    if (xPortInIsrContext())
+    {
+      return 0;
+    }
+    return detail::deferredLog.flush();
+  }
+
+  // en: Default notification slot of the primitives that sleep on a task notification (SpscQueue, MpscQueue, Latest,
+  // en: Topic, Future, WorkPool/Completion, Queue's WithBatch). It is kept off slot 0, which belongs to Notify,
+  // en: StreamBuffer readers and plain xTaskNotifyGive users, whenever the core has a second slot. The stock Arduino
+  // en: core has only one, so there they share slot 0 and must not be mixed with a Notify on the same task.
+  // en: Override with -DESP32SYNCKIT_NOTIFY_INDEX=n.
+  // ja: タスク通知で眠るプリミティブ（SpscQueue、MpscQueue、Latest、Topic、Future、WorkPool/Completion、Queue の
+  // ja: WithBatch）の既定の通知スロット。コアに2番目のスロットがあれば、Notify、StreamBuffer の読み手、素の
+  // ja: xTaskNotifyGive 利用者のスロット0を避ける。標準の Arduino コアは1スロットしかないため、そこではスロット0を
+  // ja: 共有し、同じタスクの Notify と併用してはならない。-DESP32SYNCKIT_NOTIFY_INDEX=n で変更できる
+#ifndef ESP32SYNCKIT_NOTIFY_INDEX
+#if configTASK_NOTIFICATION_ARRAY_ENTRIES >= 2
+#define ESP32SYNCKIT_NOTIFY_INDEX 1
+#else
+#define ESP32SYNCKIT_NOTIFY_INDEX 0
+#endif
+#endif
+  inline constexpr UBaseType_t kSyncKitNotifyIndex = ESP32SYNCKIT_NOTIFY_INDEX;
+  static_assert(kSyncKitNotifyIndex < configTASK_NOTIFICATION_ARRAY_ENTRIES,
+                "ESP32SYNCKIT_NOTIFY_INDEX must be < configTASK_NOTIFICATION_ARRAY_ENTRIES");
+
+  namespace detail
+  {
+    // en: Wake-up channel on one task-notification slot, used by the lock-free primitives and Topic/Future/WorkPool.
+    // en: A waker claims the waiter (exchange or under a lock) and gives exactly once; a waiter that leaves
+    // en: without having taken that give (timeout, or ready on re-check) absorbs it, so no stale count is left
+    // en: for the next wait. The slot is therefore reserved: do not use it with Notify in either mode.
+    // ja: タスク通知の1スロットを使う起床経路。ロックフリーのプリミティブと Topic/Future/WorkPool が使う。
+    // ja: 起こす側は待機者を確保（exchange またはロック内）してから1回だけ give する。その give を受け取らずに
+    // ja: 抜ける待機者（タイムアウト、再確認で準備完了）はそれを吸収するため、次の待機に古いカウントが残らない。
+    // ja: そのためこのスロットは専有となり、どちらのモードの Notify とも併用できない
+    template <UBaseType_t Index>
+    struct NotifyChannel
+    {
+      static_assert(Index < configTASK_NOTIFICATION_ARRAY_ENTRIES,
+                    "NotifyIndex must be < configTASK_NOTIFICATION_ARRAY_ENTRIES (raise CONFIG_FREERTOS_TASK_NOTIFICATION_ARRAY_ENTRIES)");
+
+      static uint32_t wait(TickType_t ticks) { return ulTaskNotifyTakeIndexed(Index, pdTRUE, ticks); }
+
+      // en: The claimed give is already on its way; it arrives after the waker's short exchange-to-give window
+      // ja: 確保済みの give はすでに送られつつある。起こす側の exchange から give までの短い区間の後に届く
+      static void absorb() { (void)ulTaskNotifyTakeIndexed(Index, pdTRUE, portMAX_DELAY); }
+
+      static void give(TaskHandle_t task, bool inIsr)
+      {
+        if (inIsr)
+        {
+          BaseType_t taskWoken = pdFALSE;
+          vTaskNotifyGiveIndexedFromISR(task, Index, &taskWoken);
+          if (taskWoken == pdTRUE)
+          {
+            portYIELD_FROM_ISR();
+          }
+        }
+        else
+        {
+          (void)xTaskNotifyGiveIndexed(task, Index);
+        }
+      }
+
+      // en: Waker side of an atomic waiter slot: a fence and a load when nobody sleeps, otherwise claim and give
+      // ja: アトミックな待機者スロットの起こす側: 誰も眠っていなければフェンスと読み出し1回、いれば確保して give
+      static void wake(std::atomic<TaskHandle_t> &waiter, bool inIsr)
+      {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (waiter.load(std::memory_order_relaxed) == nullptr)
+        {
+          return; // en: fast path, nobody sleeping / ja: 高速パス（待機者なし）
+        }
+        TaskHandle_t handle = waiter.exchange(nullptr, std::memory_order_acq_rel);
+        if (handle)
+        {
+          give(handle, inIsr);
+        }
+      }
+
+      // en: Waiter side: withdraw from the slot after wait() returned taken (0 = not woken through it)
+      // ja: 待機者側: wait() が taken を返した後にスロットから抜ける（0 = それによって起こされていない）
+      static void leave(std::atomic<TaskHandle_t> &waiter, uint32_t taken)
+      {
+        if (waiter.exchange(nullptr, std::memory_order_acq_rel) == nullptr && taken == 0)
+        {
+          absorb();
+        }
+      }
+    };
+  } // namespace detail
+
+  // en: Batch policies for Queue. NoBatch (default) adds nothing to a send; WithBatch enables receiveBatch(), whose
+  // en: caller sleeps on notification slot NotifyIndex (reserved, as for SpscQueue) and is woken by the send that
+  // en: reaches its threshold. Every successful send of a WithBatch queue pays a fence and one load for that check.
+  // ja: Queue のバッチポリシー。NoBatch（既定）は送信に何も加えない。WithBatch は receiveBatch() を有効にし、
+  // ja: 呼び出し元は通知スロット NotifyIndex（SpscQueue と同じく専有）で眠り、しきい値に達した送信で起こされる。
+  // ja: WithBatch のキューでは送信成功のたびにその確認のためのフェンスと読み出し1回がかかる
+  struct NoBatch
+  {
+  };
+  template <UBaseType_t NotifyIndex = kSyncKitNotifyIndex>
+  struct WithBatch
+  {
+  };
+
+  namespace detail
+  {
+    template <class Policy>
+    class BatchWaiter;
+
+    template <>
+    class BatchWaiter<NoBatch>
+    {
+    public:
+      static constexpr bool kBatchEnabled = false;
+
+    protected:
+      static void wakeBatchWaiter(QueueHandle_t, bool) {}
+    };
+
+    template <UBaseType_t Index>
+    class BatchWaiter<WithBatch<Index>>
+    {
+    public:
+      static constexpr bool kBatchEnabled = true;
+
+    protected:
+      // en: Sleep until threshold items are queued or latencyTicks pass. Publish, re-check, then sleep, so a send
+      // en: between the check and the sleep is not lost; a give that races the timeout is absorbed on the way out.
+      // ja: threshold 件溜まるか latencyTicks 経過するまで眠る。登録・再確認・睡眠の順なので確認と睡眠の間の送信も
+      // ja: 取りこぼさず、タイムアウトと競合した give は抜けるときに吸収する
+      void waitForBatch(QueueHandle_t handle, uint32_t threshold, TickType_t latencyTicks)
+      {
+        const bool infinite = (latencyTicks == portMAX_DELAY);
+        const TickType_t start = xTaskGetTickCount();
+        TickType_t remaining = latencyTicks;
+
+        while (remaining != 0)
+        {
+          batchThreshold_.store(threshold, std::memory_order_relaxed);
+          batchWaiter_.store(xTaskGetCurrentTaskHandle(), std::memory_order_relaxed);
+          std::atomic_thread_fence(std::memory_order_seq_cst);
+          if (uxQueueMessagesWaiting(handle) >= threshold)
+          {
+            Channel::leave(batchWaiter_, 0);
+            return;
+          }
+
+          Channel::leave(batchWaiter_, Channel::wait(remaining));
+          if (uxQueueMessagesWaiting(handle) >= threshold)
+          {
+            return;
+          }
+
+          if (!infinite)
+          {
+            TickType_t elapsed = xTaskGetTickCount() - start;
+            remaining = (elapsed >= latencyTicks) ? 0 : latencyTicks - elapsed;
+          }
+        }
+      }
+
+      // en: Called after every successful send: wake the receiveBatch() caller once its threshold is queued
+      // ja: 送信成功のたびに呼ぶ: receiveBatch() の呼び出し元を、しきい値まで溜まった時点で起こす
+      void wakeBatchWaiter(QueueHandle_t handle, bool inIsr)
+      {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (batchWaiter_.load(std::memory_order_relaxed) == nullptr)
+        {
+          return;
+        }
+        const uint32_t queued = inIsr ? uxQueueMessagesWaitingFromISR(handle) : uxQueueMessagesWaiting(handle);
+        if (queued < batchThreshold_.load(std::memory_order_relaxed))
+        {
+          return; // en: keep it asleep / ja: まだ眠らせておく
+        }
+        TaskHandle_t waiter = batchWaiter_.exchange(nullptr, std::memory_order_acq_rel);
+        if (waiter)
+        {
+          Channel::give(waiter, inIsr);
+        }
+      }
+
+    private:
+      using Channel = NotifyChannel<Index>;
+
+      std::atomic<TaskHandle_t> batchWaiter_{nullptr}; // en: task sleeping in receiveBatch() / ja: receiveBatch() で眠っているタスク
+      std::atomic<uint32_t> batchThreshold_{0};        // en: queued items that wake it / ja: 起こす滞留数
+    };
+  } // namespace detail
+
+  template <class T, class StatsPolicy = NoStats, class LogPolicy = LogAll, class BatchPolicy = NoBatch>
+  class Queue : public detail::StatsRecorder<StatsPolicy>,
+                protected detail::Diagnostics<LogPolicy>,
+                private detail::BatchWaiter<BatchPolicy>
+  {
+    static_assert(!std::is_same<StatsPolicy, WithProfile>::value, "Queue: WithProfile is Mutex-only, use WithStats");
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "Queue<T>: T is copied with memcpy and must be trivially copyable; use ObjectQueue<T> for move-only or non-trivial types");
+
+  public:
+    // en: Only records the depth, so a global or static Queue is constant-initialized (no constructor-order
+    // en: issues). The FreeRTOS queue is created on first use, or up front by begin().
+    // ja: 深さを記録するだけなので、グローバル・static の Queue は定数初期化される（コンストラクタ順序の問題なし）。
+    // ja: FreeRTOS キューは初回使用時、または begin() で前もって生成される
+    constexpr explicit Queue(uint32_t depth)
+        : handle_(nullptr), depth_(depth)
+    {
+    }
+
     ~Queue()
     {
-      if (handle_)
+      QueueHandle_t handle = handle_.exchange(nullptr, std::memory_order_acq_rel);
+      if (handle)
       {
-        vQueueDelete(handle_);
-        handle_ = nullptr;
+        vQueueDelete(handle);
       }
     }
 
     Queue(const Queue &) = delete;
     Queue &operator=(const Queue &) = delete;
 
-    Queue(Queue &&other) noexcept : handle_(other.handle_)
+    Queue(Queue &&other) noexcept
+        : handle_(other.handle_.exchange(nullptr, std::memory_order_acq_rel)), depth_(other.depth_)
     {
-      other.handle_ = nullptr;
     }
     Queue &operator=(Queue &&other) noexcept
     {
       if (this != &other)
       {
-        if (handle_)
+        QueueHandle_t old = handle_.exchange(other.handle_.exchange(nullptr, std::memory_order_acq_rel), std::memory_order_acq_rel);
+        if (old)
         {
-          vQueueDelete(handle_);
+          vQueueDelete(old);
         }
-        handle_ = other.handle_;
-        other.handle_ = nullptr;
+        depth_ = other.depth_;
       }
       return *this;
     }
 
+    // en: A Static* variant cannot be moved out through this class: its handle points into the derived object
+    // ja: Static* 版はこのクラス経由でもムーブできない: ハンドルが派生オブジェクトの領域を指すため
+    template <class Derived, detail::EnableIfDerived<Queue, Derived> = 0>
+    Queue(Derived &&) = delete;
+    template <class Derived, detail::EnableIfDerived<Queue, Derived> = 0>
+    Queue &operator=(Derived &&) = delete;
+
+    // en: Create the queue now (task context) instead of on first use. Optional; call it before an ISR
+    // en: may touch the queue, or to keep the allocation out of a timing-sensitive path. Idempotent.
+    // ja: 初回使用時ではなく今キューを生成する（タスク文脈）。任意。ISR が触れる前や、
+    // ja: 時間に厳しい経路から確保を外したいときに呼ぶ。何度呼んでもよい
+    bool begin() { return ensureCreated() != nullptr; }
+
     bool trySend(const T &value) { return send(value, 0); }
+    bool send(const T &value, const Deadline &deadline) { return detail::untilDeadline(deadline, [&](uint32_t ms) { return send(value, ms); }); }
 
     bool send(const T &value, uint32_t timeoutMs = WaitForever)
     {
-      if (!handle_)
+      QueueHandle_t handle = ensureCreated();
+      if (!handle)
       {
-        ESP_LOGE(kLogTag, "[Queue] send failed: handle null");
+        this->logError("[Queue] send failed: handle null");
         return false;
       }
 
@@ -81,40 +810,48 @@ namespace ESP32SyncKit
       if (inIsr)
       {
         BaseType_t taskWoken = pdFALSE;
-        BaseType_t rc = xQueueSendFromISR(handle_, &value, &taskWoken);
+        BaseType_t rc = xQueueSendFromISR(handle, &value, &taskWoken);
         if (taskWoken == pdTRUE)
         {
           portYIELD_FROM_ISR();
         }
         if (rc != pdPASS)
         {
-          ESP_LOGW(kLogTag, "[Queue] send ISR failed: rc=%ld", static_cast<long>(rc));
+          this->countFailure(false);
+          this->logWarn("[Queue] send ISR failed: rc=%ld", static_cast<long>(rc));
           return false;
         }
+        recordSent(handle, inIsr);
         return true;
       }
       else
       {
-        BaseType_t rc = xQueueSend(handle_, &value, ticks);
+        const int64_t blockStart = this->blockBegin(ticks);
+        BaseType_t rc = xQueueSend(handle, &value, ticks);
+        this->blockEnd(blockStart);
         if (rc != pdPASS)
         {
+          this->countFailure(!nonBlocking);
           if (!nonBlocking)
           {
-            ESP_LOGW(kLogTag, "[Queue] send timeout/full");
+            this->logTimeout("[Queue] send timeout/full");
           }
           return false;
         }
+        recordSent(handle, inIsr);
         return true;
       }
     }
 
     bool trySendToFront(const T &value) { return sendToFront(value, 0); }
+    bool sendToFront(const T &value, const Deadline &deadline) { return detail::untilDeadline(deadline, [&](uint32_t ms) { return sendToFront(value, ms); }); }
 
     bool sendToFront(const T &value, uint32_t timeoutMs = WaitForever)
     {
-      if (!handle_)
+      QueueHandle_t handle = ensureCreated();
+      if (!handle)
       {
-        ESP_LOGE(kLogTag, "[Queue] sendToFront failed: handle null");
+        this->logError("[Queue] sendToFront failed: handle null");
         return false;
       }
 
@@ -125,38 +862,45 @@ namespace ESP32SyncKit
       if (inIsr)
       {
         BaseType_t taskWoken = pdFALSE;
-        BaseType_t rc = xQueueSendToFrontFromISR(handle_, &value, &taskWoken);
+        BaseType_t rc = xQueueSendToFrontFromISR(handle, &value, &taskWoken);
         if (taskWoken == pdTRUE)
         {
           portYIELD_FROM_ISR();
         }
         if (rc != pdPASS)
         {
-          ESP_LOGW(kLogTag, "[Queue] sendToFront ISR failed: rc=%ld", static_cast<long>(rc));
+          this->countFailure(false);
+          this->logWarn("[Queue] sendToFront ISR failed: rc=%ld", static_cast<long>(rc));
           return false;
         }
+        recordSent(handle, inIsr);
         return true;
       }
       else
       {
-        BaseType_t rc = xQueueSendToFront(handle_, &value, ticks);
+        const int64_t blockStart = this->blockBegin(ticks);
+        BaseType_t rc = xQueueSendToFront(handle, &value, ticks);
+        this->blockEnd(blockStart);
         if (rc != pdPASS)
         {
+          this->countFailure(!nonBlocking);
           if (!nonBlocking)
           {
-            ESP_LOGW(kLogTag, "[Queue] sendToFront timeout/full");
+            this->logTimeout("[Queue] sendToFront timeout/full");
           }
           return false;
         }
+        recordSent(handle, inIsr);
         return true;
       }
     }
 
     bool overwrite(const T &value)
     {
-      if (!handle_)
+      QueueHandle_t handle = ensureCreated();
+      if (!handle)
       {
-        ESP_LOGE(kLogTag, "[Queue] overwrite failed: handle null");
+        this->logError("[Queue] overwrite failed: handle null");
         return false;
       }
 
@@ -164,37 +908,43 @@ namespace ESP32SyncKit
       if (inIsr)
       {
         BaseType_t taskWoken = pdFALSE;
-        BaseType_t rc = xQueueOverwriteFromISR(handle_, &value, &taskWoken);
+        BaseType_t rc = xQueueOverwriteFromISR(handle, &value, &taskWoken);
         if (taskWoken == pdTRUE)
         {
           portYIELD_FROM_ISR();
         }
         if (rc != pdPASS)
         {
-          ESP_LOGW(kLogTag, "[Queue] overwrite ISR failed: rc=%ld", static_cast<long>(rc));
+          this->countFailure(false);
+          this->logWarn("[Queue] overwrite ISR failed: rc=%ld", static_cast<long>(rc));
           return false;
         }
+        recordSent(handle, inIsr);
         return true;
       }
       else
       {
-        BaseType_t rc = xQueueOverwrite(handle_, &value);
+        BaseType_t rc = xQueueOverwrite(handle, &value);
         if (rc != pdPASS)
         {
-          ESP_LOGW(kLogTag, "[Queue] overwrite failed");
+          this->countFailure(false);
+          this->logWarn("[Queue] overwrite failed");
           return false;
         }
+        recordSent(handle, inIsr);
         return true;
       }
     }
 
     bool tryReceive(T &out) { return receive(out, 0); }
+    bool receive(T &out, const Deadline &deadline) { return detail::untilDeadline(deadline, [&](uint32_t ms) { return receive(out, ms); }); }
 
     bool receive(T &out, uint32_t timeoutMs = WaitForever)
     {
-      if (!handle_)
+      QueueHandle_t handle = ensureCreated();
+      if (!handle)
       {
-        ESP_LOGE(kLogTag, "[Queue] receive failed: handle null");
+        this->logError("[Queue] receive failed: handle null");
         return false;
       }
 
@@ -205,93 +955,371 @@ namespace ESP32SyncKit
       if (inIsr)
       {
         BaseType_t taskWoken = pdFALSE;
-        BaseType_t rc = xQueueReceiveFromISR(handle_, &out, &taskWoken);
+        BaseType_t rc = xQueueReceiveFromISR(handle, &out, &taskWoken);
         if (taskWoken == pdTRUE)
         {
           portYIELD_FROM_ISR();
         }
         if (rc != pdPASS)
         {
+          this->countFailure(false);
           return false;
         }
+        this->countReceive();
         return true;
       }
       else
       {
-        BaseType_t rc = xQueueReceive(handle_, &out, ticks);
+        const int64_t blockStart = this->blockBegin(ticks);
+        BaseType_t rc = xQueueReceive(handle, &out, ticks);
+        this->blockEnd(blockStart);
         if (rc != pdPASS)
         {
+          this->countFailure(!nonBlocking);
           if (!nonBlocking)
           {
-            ESP_LOGW(kLogTag, "[Queue] receive timeout");
+            this->logTimeout("[Queue] receive timeout");
           }
           return false;
         }
+        this->countReceive();
         return true;
       }
     }
 
-    uint32_t count() const
+    uint32_t trySendMany(const T *values, uint32_t n) { return sendMany(values, n, 0); }
+    uint32_t sendMany(const T *values, uint32_t n, const Deadline &deadline) { return detail::untilDeadline(deadline, [&](uint32_t ms) { return sendMany(values, n, ms); }); }
+
+    // en: Send up to n items. Blocks only until the first item fits, then sends the rest non-blocking.
+    // ja: 最大 n 件送信。最初の1件が入るまでだけブロックし、残りはノンブロックで送る
+    uint32_t sendMany(const T *values, uint32_t n, uint32_t timeoutMs = WaitForever)
     {
-      if (!handle_)
+      QueueHandle_t handle = ensureCreated();
+      if (!handle)
+      {
+        this->logError("[Queue] sendMany failed: handle null");
+        return 0;
+      }
+      if (!values || n == 0)
       {
-        ESP_LOGE(kLogTag, "[Queue] count failed: handle null");
         return 0;
       }
-      return xPortInIsrContext() ? uxQueueMessagesWaitingFromISR(handle_) : uxQueueMessagesWaiting(handle_);
+
+      const bool inIsr = xPortInIsrContext();
+      TickType_t ticks = (inIsr || timeoutMs == 0) ? 0 : (timeoutMs == WaitForever ? portMAX_DELAY : pdMS_TO_TICKS(timeoutMs));
+      const bool nonBlocking = (ticks == 0);
+      uint32_t sent = 0;
+
+      if (inIsr)
+      {
+        BaseType_t taskWoken = pdFALSE;
+        while (sent < n && xQueueSendFromISR(handle, &values[sent], &taskWoken) == pdPASS)
+        {
+          ++sent;
+        }
+        if (taskWoken == pdTRUE)
+        {
+          portYIELD_FROM_ISR(); // en: one yield per batch / ja: バッチごとに1回だけ yield
+        }
+        if (sent == 0)
+        {
+          this->countFailure(false);
+          this->logWarn("[Queue] sendMany ISR failed: full");
+          return 0;
+        }
+        recordSent(handle, inIsr, sent);
+        return sent;
+      }
+
+      const int64_t blockStart = this->blockBegin(ticks);
+      const BaseType_t rc = xQueueSend(handle, &values[0], ticks);
+      this->blockEnd(blockStart);
+      if (rc != pdPASS)
+      {
+        this->countFailure(!nonBlocking);
+        if (!nonBlocking)
+        {
+          this->logTimeout("[Queue] sendMany timeout/full");
+        }
+        return 0;
+      }
+      sent = 1;
+      while (sent < n && xQueueSend(handle, &values[sent], 0) == pdPASS)
+      {
+        ++sent;
+      }
+      recordSent(handle, inIsr, sent);
+      return sent;
+    }
+
+    uint32_t tryReceiveMany(T *out, uint32_t maxN) { return receiveMany(out, maxN, 0); }
+    uint32_t receiveMany(T *out, uint32_t maxN, const Deadline &deadline) { return detail::untilDeadline(deadline, [&](uint32_t ms) { return receiveMany(out, maxN, ms); }); }
+
+    // en: Receive up to maxN items. Blocks only until the first item arrives, then drains the rest non-blocking.
+    // ja: 最大 maxN 件受信。最初の1件が届くまでだけブロックし、残りはノンブロックで取り出す
+    uint32_t receiveMany(T *out, uint32_t maxN, uint32_t timeoutMs = WaitForever)
+    {
+      QueueHandle_t handle = ensureCreated();
+      if (!handle)
+      {
+        this->logError("[Queue] receiveMany failed: handle null");
+        return 0;
+      }
+      if (!out || maxN == 0)
+      {
+        return 0;
+      }
+
+      const bool inIsr = xPortInIsrContext();
+      TickType_t ticks = (inIsr || timeoutMs == 0) ? 0 : (timeoutMs == WaitForever ? portMAX_DELAY : pdMS_TO_TICKS(timeoutMs));
+      const bool nonBlocking = (ticks == 0);
+      uint32_t received = 0;
+
+      if (inIsr)
+      {
+        BaseType_t taskWoken = pdFALSE;
+        while (received < maxN && xQueueReceiveFromISR(handle, &out[received], &taskWoken) == pdPASS)
+        {
+          ++received;
+        }
+        if (taskWoken == pdTRUE)
+        {
+          portYIELD_FROM_ISR(); // en: one yield per batch / ja: バッチごとに1回だけ yield
+        }
+        if (received == 0)
+        {
+          this->countFailure(false);
+          return 0;
+        }
+        this->countReceive(received);
+        return received;
+      }
+
+      const int64_t blockStart = this->blockBegin(ticks);
+      const BaseType_t rc = xQueueReceive(handle, &out[0], ticks);
+      this->blockEnd(blockStart);
+      if (rc != pdPASS)
+      {
+        this->countFailure(!nonBlocking);
+        if (!nonBlocking)
+        {
+          this->logTimeout("[Queue] receiveMany timeout");
+        }
+        return 0;
+      }
+      received = 1;
+      while (received < maxN && xQueueReceive(handle, &out[received], 0) == pdPASS)
+      {
+        ++received;
+      }
+      this->countReceive(received);
+      return received;
+    }
+
+    uint32_t receiveBatch(T *out, uint32_t maxN, uint32_t minItems, uint32_t maxLatencyMs, const Deadline &deadline)
+    {
+      return detail::untilDeadline(deadline, [&](uint32_t ms) { return receiveBatch(out, maxN, minItems, maxLatencyMs, ms); });
+    }
+
+    // en: Coalesced receive (like NIC interrupt coalescing): wait up to timeoutMs for the first item, then keep
+    // en: sleeping until minItems are queued or maxLatencyMs has passed, and drain up to maxN in one call.
+    // en: Producers do not wake the caller per item. Needs the WithBatch policy, whose notification slot the calling
+    // en: task sleeps on. ISR: == tryReceiveMany().
+    // ja: まとめ受信（NIC の割り込み集約と同様）: 最初の1件を最大 timeoutMs 待ち、その後 minItems 件溜まるか
+    // ja: maxLatencyMs 経過するまで眠り続け、最大 maxN 件を1回で取り出す。生産者は1件ごとに起こさない。
+    // ja: WithBatch ポリシーが必要で、呼び出しタスクはその通知スロットで眠る。ISR では tryReceiveMany() と同じ
+    uint32_t receiveBatch(T *out, uint32_t maxN, uint32_t minItems, uint32_t maxLatencyMs, uint32_t timeoutMs = WaitForever)
+    {
+      static_assert(detail::BatchWaiter<BatchPolicy>::kBatchEnabled,
+                    "Queue::receiveBatch needs the WithBatch policy: Queue<T, StatsPolicy, LogPolicy, WithBatch<>>");
+      QueueHandle_t handle = ensureCreated();
+      if (!handle)
+      {
+        this->logError("[Queue] receiveBatch failed: handle null");
+        return 0;
+      }
+      if (!out || maxN == 0)
+      {
+        return 0;
+      }
+      if (xPortInIsrContext())
+      {
+        return receiveMany(out, maxN, 0);
+      }
+
+      TickType_t ticks = (timeoutMs == 0) ? 0 : (timeoutMs == WaitForever ? portMAX_DELAY : pdMS_TO_TICKS(timeoutMs));
+      const int64_t blockStart = this->blockBegin(ticks);
+      if (xQueueReceive(handle, &out[0], ticks) != pdPASS)
+      {
+        this->blockEnd(blockStart);
+        this->countFailure(ticks != 0);
+        if (ticks != 0)
+        {
+          this->logTimeout("[Queue] receiveBatch timeout");
+        }
+        return 0;
+      }
+
+      // en: Items still to be queued besides the one in hand, capped at the queue length (a threshold the queue
+      // en: cannot reach would only ever end by latency)
+      // ja: 受信済みの1件以外にキューへ溜まるべき件数。キュー長で頭打ちにする（到達できないしきい値はレイテンシでしか終わらない）
+      const uint32_t length = uxQueueMessagesWaiting(handle) + uxQueueSpacesAvailable(handle);
+      const uint32_t target = minItems < maxN ? minItems : maxN;
+      const uint32_t threshold = target > 1 ? (target - 1 < length ? target - 1 : length) : 0;
+      if (threshold > 0 && maxLatencyMs > 0)
+      {
+        this->waitForBatch(handle, threshold, maxLatencyMs == WaitForever ? portMAX_DELAY : pdMS_TO_TICKS(maxLatencyMs));
+      }
+
+      uint32_t received = 1;
+      while (received < maxN && xQueueReceive(handle, &out[received], 0) == pdPASS)
+      {
+        ++received;
+      }
+      this->blockEnd(blockStart);
+      this->countReceive(received);
+      this->countBatch(received);
+      return received;
+    }
+
+    uint32_t count() const
+    {
+      QueueHandle_t handle = handle_.load(std::memory_order_acquire);
+      if (!handle)
+      {
+        return 0; // en: not created yet / ja: 未生成
+      }
+      return xPortInIsrContext() ? uxQueueMessagesWaitingFromISR(handle) : uxQueueMessagesWaiting(handle);
     }
 
     bool clear()
     {
-      if (!handle_)
+      QueueHandle_t handle = ensureCreated();
+      if (!handle)
       {
-        ESP_LOGE(kLogTag, "[Queue] clear failed: handle null");
+        this->logError("[Queue] clear failed: handle null");
         return false;
       }
       if (xPortInIsrContext())
       {
-        ESP_LOGW(kLogTag, "[Queue] clear not allowed in ISR");
+        this->logWarn("[Queue] clear not allowed in ISR");
         return false;
       }
-      BaseType_t rc = xQueueReset(handle_);
+      BaseType_t rc = xQueueReset(handle);
       if (rc != pdPASS)
       {
-        ESP_LOGW(kLogTag, "[Queue] clear failed");
+        this->logWarn("[Queue] clear failed");
         return false;
       }
       return true;
     }
 
+  protected:
+    // en: Adopt a handle created by a Static* variant
+    // ja: Static* 版で生成したハンドルを引き取る
+    Queue(detail::AdoptHandle, QueueHandle_t handle)
+        : handle_(handle), depth_(0)
+    {
+      if (!handle)
+      {
+        this->logError("[Queue] create failed: xQueueCreateStatic");
+      }
+    }
+
   private:
-    QueueHandle_t handle_;
+    // en: First-use creation. Tasks racing here may both create; the CAS publishes one handle and the
+    // en: loser deletes its own. Creation allocates, so it is refused in an ISR (call begin() first).
+    // ja: 初回使用時の生成。ここで競合したタスクは両方生成し得るが、CAS で1つを公開し、負けた側は自分の分を削除する。
+    // ja: 生成はメモリを確保するため ISR では拒否する（先に begin() を呼ぶ）
+    QueueHandle_t ensureCreated()
+    {
+      QueueHandle_t handle = handle_.load(std::memory_order_acquire);
+      if (handle)
+      {
+        return handle;
+      }
+      if (xPortInIsrContext())
+      {
+        this->logError("[Queue] create failed: first use in ISR, call begin() first");
+        return nullptr;
+      }
+      if (depth_ == 0)
+      {
+        this->logError("[Queue] create failed: depth must be > 0");
+        return nullptr;
+      }
+      QueueHandle_t created = xQueueCreate(depth_, sizeof(T));
+      if (!created)
+      {
+        this->logError("[Queue] create failed: xQueueCreate");
+        return nullptr;
+      }
+      if (!handle_.compare_exchange_strong(handle, created, std::memory_order_acq_rel, std::memory_order_acquire))
+      {
+        vQueueDelete(created); // en: another task won / ja: 他タスクが先に生成した
+        return handle;
+      }
+      return created;
+    }
+
+    void recordSent(QueueHandle_t handle, bool inIsr, uint32_t n = 1)
+    {
+      this->countSend(n);
+      if constexpr (detail::StatsRecorder<StatsPolicy>::kStatsEnabled)
+      {
+        this->observeCount(count());
+      }
+      if constexpr (detail::BatchWaiter<BatchPolicy>::kBatchEnabled)
+      {
+        this->wakeBatchWaiter(handle, inIsr);
+      }
+    }
+
+    friend struct detail::HandleAccess;
+
+    std::atomic<QueueHandle_t> handle_;
+    uint32_t depth_;
   };
 
-  class Notify
+  enum class NotifyMode
   {
+    Unknown,
+    Counter,
+    Bits
+  };
+
+  // en: Index selects the task's notification slot (xTaskNotify*Indexed); 0 is the classic single slot.
+  // en: Other indices need CONFIG_FREERTOS_TASK_NOTIFICATION_ARRAY_ENTRIES > 1.
+  // ja: Index はタスクの通知スロット（xTaskNotify*Indexed）を選ぶ。0 は従来の単一スロット。
+  // ja: それ以外の番号には CONFIG_FREERTOS_TASK_NOTIFICATION_ARRAY_ENTRIES > 1 が必要
+  template <class StatsPolicy = NoStats, class LogPolicy = LogAll, UBaseType_t Index = 0>
+  class BasicNotify : public detail::StatsRecorder<StatsPolicy>, protected detail::Diagnostics<LogPolicy>
+  {
+    static_assert(!std::is_same<StatsPolicy, WithProfile>::value, "Notify: WithProfile is Mutex-only, use WithStats");
+    static_assert(Index < configTASK_NOTIFICATION_ARRAY_ENTRIES,
+                  "Notify: Index must be < configTASK_NOTIFICATION_ARRAY_ENTRIES (raise CONFIG_FREERTOS_TASK_NOTIFICATION_ARRAY_ENTRIES)");
+
   public:
-    enum class Mode
-    {
-      Unknown,
-      Counter,
-      Bits
-    };
+    using Mode = NotifyMode;
 
-    Notify() = default;
-    explicit Notify(Mode mode) : mode_(mode), modeLocked_(mode != Mode::Unknown) {}
-    explicit Notify(TaskHandle_t handle) : target_(handle) {}
-    Notify(TaskHandle_t handle, Mode mode) : target_(handle), mode_(mode), modeLocked_(mode != Mode::Unknown) {}
+    static constexpr UBaseType_t index() { return Index; }
 
-    Notify(const Notify &) = delete;
-    Notify &operator=(const Notify &) = delete;
+    BasicNotify() = default;
+    explicit BasicNotify(Mode mode) : mode_(mode), modeLocked_(mode != Mode::Unknown) {}
+    explicit BasicNotify(TaskHandle_t handle) : target_(handle) {}
+    BasicNotify(TaskHandle_t handle, Mode mode) : target_(handle), mode_(mode), modeLocked_(mode != Mode::Unknown) {}
 
-    Notify(Notify &&other) noexcept
+    BasicNotify(const BasicNotify &) = delete;
+    BasicNotify &operator=(const BasicNotify &) = delete;
+
+    BasicNotify(BasicNotify &&other) noexcept
         : target_(other.target_), mode_(other.mode_), modeLocked_(other.modeLocked_)
     {
       other.target_ = nullptr;
       other.mode_ = Mode::Unknown;
       other.modeLocked_ = false;
     }
-    Notify &operator=(Notify &&other) noexcept
+    BasicNotify &operator=(BasicNotify &&other) noexcept
     {
       if (this != &other)
       {
@@ -310,12 +1338,12 @@ namespace ESP32SyncKit
     {
       if (target_)
       {
-        ESP_LOGW(kLogTag, "[Notify] bind failed: already bound");
+        this->logWarn("[Notify] bind failed: already bound");
         return false;
       }
       if (!handle)
       {
-        ESP_LOGE(kLogTag, "[Notify] bind failed: null handle");
+        this->logError("[Notify] bind failed: null handle");
         return false;
       }
       target_ = handle;
@@ -342,26 +1370,30 @@ namespace ESP32SyncKit
       if (inIsr)
       {
         BaseType_t taskWoken = pdFALSE;
-        BaseType_t rc = xTaskNotifyFromISR(target_, 0, eIncrement, &taskWoken);
+        BaseType_t rc = xTaskNotifyIndexedFromISR(target_, Index, 0, eIncrement, &taskWoken);
         if (taskWoken == pdTRUE)
         {
           portYIELD_FROM_ISR();
         }
         if (rc != pdPASS)
         {
-          ESP_LOGW(kLogTag, "[Notify] notify ISR failed: rc=%ld", static_cast<long>(rc));
+          this->countFailure(false);
+          this->logWarn("[Notify] notify ISR failed: rc=%ld", static_cast<long>(rc));
           return false;
         }
+        this->countSend();
         return true;
       }
       else
       {
-        BaseType_t rc = xTaskNotifyGive(target_);
+        BaseType_t rc = xTaskNotifyGiveIndexed(target_, Index);
         if (rc != pdPASS)
         {
-          ESP_LOGW(kLogTag, "[Notify] notify failed: rc=%ld", static_cast<long>(rc));
+          this->countFailure(false);
+          this->logWarn("[Notify] notify failed: rc=%ld", static_cast<long>(rc));
           return false;
         }
+        this->countSend();
         return true;
       }
     }
@@ -383,11 +1415,20 @@ namespace ESP32SyncKit
       }
 
       TickType_t ticks = (timeoutMs == 0) ? 0 : (timeoutMs == WaitForever ? portMAX_DELAY : pdMS_TO_TICKS(timeoutMs));
-      uint32_t count = ulTaskNotifyTake(pdFALSE, ticks);
-      return count > 0;
+      const int64_t blockStart = this->blockBegin(ticks);
+      uint32_t count = ulTaskNotifyTakeIndexed(Index, pdFALSE, ticks);
+      this->blockEnd(blockStart);
+      if (count == 0)
+      {
+        this->countFailure(ticks != 0);
+        return false;
+      }
+      this->countReceive();
+      return true;
     }
 
     bool tryTake() { return take(0); }
+    bool take(const Deadline &deadline) { return detail::untilDeadline(deadline, [&](uint32_t ms) { return take(ms); }); }
 
     // en: Take all pending notifications at once, returning the count (clears to 0)
     // ja: 溜まった通知をすべて取得し、件数を返す（カウンタを0にクリア）
@@ -408,12 +1449,22 @@ namespace ESP32SyncKit
       }
 
       TickType_t ticks = (timeoutMs == 0) ? 0 : (timeoutMs == WaitForever ? portMAX_DELAY : pdMS_TO_TICKS(timeoutMs));
-      return ulTaskNotifyTake(pdTRUE, ticks);
+      const int64_t blockStart = this->blockBegin(ticks);
+      uint32_t count = ulTaskNotifyTakeIndexed(Index, pdTRUE, ticks);
+      this->blockEnd(blockStart);
+      if (count == 0)
+      {
+        this->countFailure(ticks != 0);
+        return 0;
+      }
+      this->countReceive(count);
+      return count;
     }
 
     // en: Non-blocking takeAll()
     // ja: ノンブロックでまとめ取り
     uint32_t tryTakeAll() { return takeAll(0); }
+    uint32_t takeAll(const Deadline &deadline) { return detail::untilDeadline(deadline, [&](uint32_t ms) { return takeAll(ms); }); }
 
     bool setBits(uint32_t mask)
     {
@@ -430,26 +1481,30 @@ namespace ESP32SyncKit
       if (inIsr)
       {
         BaseType_t taskWoken = pdFALSE;
-        BaseType_t rc = xTaskNotifyFromISR(target_, mask, eSetBits, &taskWoken);
+        BaseType_t rc = xTaskNotifyIndexedFromISR(target_, Index, mask, eSetBits, &taskWoken);
         if (taskWoken == pdTRUE)
         {
           portYIELD_FROM_ISR();
         }
         if (rc != pdPASS)
         {
-          ESP_LOGW(kLogTag, "[Notify] setBits ISR failed: rc=%ld", static_cast<long>(rc));
+          this->countFailure(false);
+          this->logWarn("[Notify] setBits ISR failed: rc=%ld", static_cast<long>(rc));
           return false;
         }
+        this->countSend();
         return true;
       }
       else
       {
-        BaseType_t rc = xTaskNotify(target_, mask, eSetBits);
+        BaseType_t rc = xTaskNotifyIndexed(target_, Index, mask, eSetBits);
         if (rc != pdPASS)
         {
-          ESP_LOGW(kLogTag, "[Notify] setBits failed: rc=%ld", static_cast<long>(rc));
+          this->countFailure(false);
+          this->logWarn("[Notify] setBits failed: rc=%ld", static_cast<long>(rc));
           return false;
         }
+        this->countSend();
         return true;
       }
     }
@@ -471,6 +1526,37 @@ namespace ESP32SyncKit
       }
 
       TickType_t totalTicks = (timeoutMs == 0) ? 0 : (timeoutMs == WaitForever ? portMAX_DELAY : pdMS_TO_TICKS(timeoutMs));
+      const int64_t blockStart = this->blockBegin(totalTicks);
+      const bool ok = waitBitsFor(mask, totalTicks, clearOnExit, waitAll);
+      this->blockEnd(blockStart);
+      if (!ok)
+      {
+        this->countFailure(totalTicks != 0);
+        return false;
+      }
+      this->countReceive();
+      return true;
+    }
+
+    bool tryWaitBits(uint32_t mask, bool clearOnExit = true, bool waitAll = false)
+    {
+      return waitBits(mask, 0, clearOnExit, waitAll);
+    }
+
+    bool waitBits(uint32_t mask, const Deadline &deadline, bool clearOnExit = true, bool waitAll = false)
+    {
+      return detail::untilDeadline(deadline, [&](uint32_t ms) { return waitBits(mask, ms, clearOnExit, waitAll); });
+    }
+
+    // Convenience overload to use defaults for timeout while specifying flags
+    bool waitBits(uint32_t mask, bool clearOnExit, bool waitAll)
+    {
+      return waitBits(mask, WaitForever, clearOnExit, waitAll);
+    }
+
+  private:
+    bool waitBitsFor(uint32_t mask, TickType_t totalTicks, bool clearOnExit, bool waitAll)
+    {
       const bool infinite = (totalTicks == portMAX_DELAY);
       TickType_t start = xTaskGetTickCount();
       TickType_t remaining = totalTicks;
@@ -479,7 +1565,8 @@ namespace ESP32SyncKit
       while (true)
       {
         uint32_t value = 0;
-        BaseType_t rc = xTaskNotifyWait(
+        BaseType_t rc = xTaskNotifyWaitIndexed(
+            Index,
             0,
             clearOnExit ? mask : 0,
             &value,
@@ -500,7 +1587,7 @@ namespace ESP32SyncKit
           if (clearOnExit)
           {
             uint32_t dummy;
-            (void)xTaskNotifyWait(0, mask, &dummy, 0); // en: clear matched bits / ja: 満たしたビットをクリア
+            (void)xTaskNotifyWaitIndexed(Index, 0, mask, &dummy, 0); // en: clear matched bits / ja: 満たしたビットをクリア
           }
           return true;
         }
@@ -522,18 +1609,6 @@ namespace ESP32SyncKit
       }
     }
 
-    bool tryWaitBits(uint32_t mask, bool clearOnExit = true, bool waitAll = false)
-    {
-      return waitBits(mask, 0, clearOnExit, waitAll);
-    }
-
-    // Convenience overload to use defaults for timeout while specifying flags
-    bool waitBits(uint32_t mask, bool clearOnExit, bool waitAll)
-    {
-      return waitBits(mask, WaitForever, clearOnExit, waitAll);
-    }
-
-  private:
     bool lockMode(Mode desired)
     {
       if (!modeLocked_ || mode_ == Mode::Unknown)
@@ -544,7 +1619,7 @@ namespace ESP32SyncKit
       }
       if (mode_ != desired)
       {
-        ESP_LOGW(kLogTag, "[Notify] mode conflict");
+        this->logWarn("[Notify] mode conflict");
         return false;
       }
       return true;
@@ -554,7 +1629,7 @@ namespace ESP32SyncKit
     {
       if (!target_)
       {
-        ESP_LOGW(kLogTag, "[Notify] send failed: not bound");
+        this->logWarn("[Notify] send failed: not bound");
         return false;
       }
       return true;
@@ -566,7 +1641,7 @@ namespace ESP32SyncKit
       {
         if (xPortInIsrContext())
         {
-          ESP_LOGW(kLogTag, "[Notify] receive failed: not bound (ISR)");
+          this->logWarn("[Notify] receive failed: not bound (ISR)");
           return false;
         }
         // en: auto-bind to current task / ja: 自タスクに自動バインド
@@ -574,7 +1649,7 @@ namespace ESP32SyncKit
       }
       if (target_ != xTaskGetCurrentTaskHandle())
       {
-        ESP_LOGW(kLogTag, "[Notify] receive failed: called from non-bound task");
+        this->logWarn("[Notify] receive failed: called from non-bound task");
         return false;
       }
       return true;
@@ -585,201 +1660,320 @@ namespace ESP32SyncKit
     bool modeLocked_ = false;
   };
 
-  class BinarySemaphore
+  using Notify = BasicNotify<>;
+
+  // en: Extra notification channel on slot Index of the receiver task
+  // ja: 受信タスクの通知スロット Index を使う追加チャネル
+  template <UBaseType_t Index, class StatsPolicy = NoStats, class LogPolicy = LogAll>
+  using IndexedNotify = BasicNotify<StatsPolicy, LogPolicy, Index>;
+
+  template <class StatsPolicy = NoStats, class LogPolicy = LogAll>
+  class BasicBinarySemaphore : public detail::StatsRecorder<StatsPolicy>, protected detail::Diagnostics<LogPolicy>
   {
+    static_assert(!std::is_same<StatsPolicy, WithProfile>::value, "BinarySemaphore: WithProfile is Mutex-only, use WithStats");
+
   public:
-    BinarySemaphore()
-        : handle_(xSemaphoreCreateBinary())
+    // en: Constant-initialized; the semaphore is created on first use, or up front by begin()
+    // ja: 定数初期化される。セマフォは初回使用時、または begin() で前もって生成される
+    constexpr BasicBinarySemaphore()
+        : handle_(nullptr)
     {
-      if (!handle_)
-      {
-        ESP_LOGE(kLogTag, "[BinarySemaphore] create failed");
-      }
     }
 
-    ~BinarySemaphore()
+    ~BasicBinarySemaphore()
     {
-      if (handle_)
+      SemaphoreHandle_t handle = handle_.exchange(nullptr, std::memory_order_acq_rel);
+      if (handle)
       {
-        vSemaphoreDelete(handle_);
-        handle_ = nullptr;
+        vSemaphoreDelete(handle);
       }
     }
 
-    BinarySemaphore(const BinarySemaphore &) = delete;
-    BinarySemaphore &operator=(const BinarySemaphore &) = delete;
+    BasicBinarySemaphore(const BasicBinarySemaphore &) = delete;
+    BasicBinarySemaphore &operator=(const BasicBinarySemaphore &) = delete;
 
-    BinarySemaphore(BinarySemaphore &&other) noexcept : handle_(other.handle_)
+    BasicBinarySemaphore(BasicBinarySemaphore &&other) noexcept
+        : handle_(other.handle_.exchange(nullptr, std::memory_order_acq_rel))
     {
-      other.handle_ = nullptr;
     }
-    BinarySemaphore &operator=(BinarySemaphore &&other) noexcept
+    BasicBinarySemaphore &operator=(BasicBinarySemaphore &&other) noexcept
     {
       if (this != &other)
       {
-        if (handle_)
+        SemaphoreHandle_t old = handle_.exchange(other.handle_.exchange(nullptr, std::memory_order_acq_rel), std::memory_order_acq_rel);
+        if (old)
         {
-          vSemaphoreDelete(handle_);
+          vSemaphoreDelete(old);
         }
-        handle_ = other.handle_;
-        other.handle_ = nullptr;
       }
       return *this;
     }
 
+    // en: A Static* variant cannot be moved out through this class: its handle points into the derived object
+    // ja: Static* 版はこのクラス経由でもムーブできない: ハンドルが派生オブジェクトの領域を指すため
+    template <class Derived, detail::EnableIfDerived<BasicBinarySemaphore, Derived> = 0>
+    BasicBinarySemaphore(Derived &&) = delete;
+    template <class Derived, detail::EnableIfDerived<BasicBinarySemaphore, Derived> = 0>
+    BasicBinarySemaphore &operator=(Derived &&) = delete;
+
+    // en: Create the semaphore now (task context) instead of on first use; same rules as Queue::begin()
+    // ja: 初回使用時ではなく今セマフォを生成する（タスク文脈）。規則は Queue::begin() と同じ
+    bool begin() { return ensureCreated() != nullptr; }
+
     bool give()
     {
-      if (!handle_)
+      SemaphoreHandle_t handle = ensureCreated();
+      if (!handle)
       {
-        ESP_LOGE(kLogTag, "[BinarySemaphore] give failed: handle null");
+        this->logError("[BinarySemaphore] give failed: handle null");
         return false;
       }
       const bool inIsr = xPortInIsrContext();
       if (inIsr)
       {
         BaseType_t taskWoken = pdFALSE;
-        BaseType_t rc = xSemaphoreGiveFromISR(handle_, &taskWoken);
+        BaseType_t rc = xSemaphoreGiveFromISR(handle, &taskWoken);
         if (taskWoken == pdTRUE)
         {
           portYIELD_FROM_ISR();
         }
         if (rc != pdPASS)
         {
-          ESP_LOGW(kLogTag, "[BinarySemaphore] give ISR failed: rc=%ld", static_cast<long>(rc));
+          this->countFailure(false);
+          this->logWarn("[BinarySemaphore] give ISR failed: rc=%ld", static_cast<long>(rc));
           return false;
         }
+        this->countSend();
         return true;
       }
       else
       {
-        BaseType_t rc = xSemaphoreGive(handle_);
+        BaseType_t rc = xSemaphoreGive(handle);
         if (rc != pdPASS)
         {
-          ESP_LOGW(kLogTag, "[BinarySemaphore] give failed: rc=%ld", static_cast<long>(rc));
+          this->countFailure(false);
+          this->logWarn("[BinarySemaphore] give failed: rc=%ld", static_cast<long>(rc));
           return false;
         }
+        this->countSend();
         return true;
       }
     }
 
     bool take(uint32_t timeoutMs = WaitForever)
     {
-      if (!handle_)
+      SemaphoreHandle_t handle = ensureCreated();
+      if (!handle)
       {
-        ESP_LOGE(kLogTag, "[BinarySemaphore] take failed: handle null");
+        this->logError("[BinarySemaphore] take failed: handle null");
         return false;
       }
       const bool inIsr = xPortInIsrContext();
       if (inIsr)
       {
-        ESP_LOGW(kLogTag, "[BinarySemaphore] take called in ISR (non-block only, not recommended)");
-        BaseType_t rc = xSemaphoreTakeFromISR(handle_, nullptr);
-        return rc == pdPASS;
+        this->logWarn("[BinarySemaphore] take called in ISR (non-block only, not recommended)");
+        BaseType_t rc = xSemaphoreTakeFromISR(handle, nullptr);
+        if (rc != pdPASS)
+        {
+          this->countFailure(false);
+          return false;
+        }
+        this->countReceive();
+        return true;
       }
 
       TickType_t ticks = (timeoutMs == 0) ? 0 : (timeoutMs == WaitForever ? portMAX_DELAY : pdMS_TO_TICKS(timeoutMs));
-      BaseType_t rc = xSemaphoreTake(handle_, ticks);
-      return rc == pdPASS;
+      const int64_t blockStart = this->blockBegin(ticks);
+      BaseType_t rc = xSemaphoreTake(handle, ticks);
+      this->blockEnd(blockStart);
+      if (rc != pdPASS)
+      {
+        this->countFailure(ticks != 0);
+        return false;
+      }
+      this->countReceive();
+      return true;
     }
 
     bool tryTake() { return take(0); }
+    bool take(const Deadline &deadline) { return detail::untilDeadline(deadline, [&](uint32_t ms) { return take(ms); }); }
+
+  protected:
+    // en: Adopt a handle created by a Static* variant
+    // ja: Static* 版で生成したハンドルを引き取る
+    BasicBinarySemaphore(detail::AdoptHandle, SemaphoreHandle_t handle)
+        : handle_(handle)
+    {
+      if (!handle)
+      {
+        this->logError("[BinarySemaphore] create failed");
+      }
+    }
 
   private:
-    SemaphoreHandle_t handle_;
+    // en: First-use creation with the same CAS publication as Queue; refused in an ISR
+    // ja: Queue と同じ CAS による公開で初回使用時に生成する。ISR では拒否する
+    SemaphoreHandle_t ensureCreated()
+    {
+      SemaphoreHandle_t handle = handle_.load(std::memory_order_acquire);
+      if (handle)
+      {
+        return handle;
+      }
+      if (xPortInIsrContext())
+      {
+        this->logError("[BinarySemaphore] create failed: first use in ISR, call begin() first");
+        return nullptr;
+      }
+      SemaphoreHandle_t created = xSemaphoreCreateBinary();
+      if (!created)
+      {
+        this->logError("[BinarySemaphore] create failed");
+        return nullptr;
+      }
+      if (!handle_.compare_exchange_strong(handle, created, std::memory_order_acq_rel, std::memory_order_acquire))
+      {
+        vSemaphoreDelete(created); // en: another task won / ja: 他タスクが先に生成した
+        return handle;
+      }
+      return created;
+    }
+
+    friend struct detail::HandleAccess;
+
+    std::atomic<SemaphoreHandle_t> handle_;
   };
 
-  class Mutex
+  using BinarySemaphore = BasicBinarySemaphore<>;
+
+  template <class StatsPolicy = NoStats, class LogPolicy = LogAll>
+  class BasicMutex : public detail::StatsRecorder<StatsPolicy>, protected detail::Diagnostics<LogPolicy>
   {
   public:
-    Mutex()
-        : handle_(xSemaphoreCreateMutex())
+    // en: Constant-initialized; the semaphore is created on first use, or up front by begin()
+    // ja: 定数初期化される。セマフォは初回使用時、または begin() で前もって生成される
+    constexpr BasicMutex()
+        : handle_(nullptr)
     {
-      if (!handle_)
-      {
-        ESP_LOGE(kLogTag, "[Mutex] create failed");
-      }
     }
 
-    ~Mutex()
+    ~BasicMutex()
     {
-      if (handle_)
+      SemaphoreHandle_t handle = handle_.exchange(nullptr, std::memory_order_acq_rel);
+      if (handle)
       {
-        vSemaphoreDelete(handle_);
-        handle_ = nullptr;
+        vSemaphoreDelete(handle);
       }
     }
 
-    Mutex(const Mutex &) = delete;
-    Mutex &operator=(const Mutex &) = delete;
+    BasicMutex(const BasicMutex &) = delete;
+    BasicMutex &operator=(const BasicMutex &) = delete;
 
-    Mutex(Mutex &&other) noexcept : handle_(other.handle_)
+    BasicMutex(BasicMutex &&other) noexcept
+        : handle_(other.handle_.exchange(nullptr, std::memory_order_acq_rel))
     {
-      other.handle_ = nullptr;
     }
-    Mutex &operator=(Mutex &&other) noexcept
+    BasicMutex &operator=(BasicMutex &&other) noexcept
     {
       if (this != &other)
       {
-        if (handle_)
+        SemaphoreHandle_t old = handle_.exchange(other.handle_.exchange(nullptr, std::memory_order_acq_rel), std::memory_order_acq_rel);
+        if (old)
         {
-          vSemaphoreDelete(handle_);
+          vSemaphoreDelete(old);
         }
-        handle_ = other.handle_;
-        other.handle_ = nullptr;
       }
       return *this;
     }
 
+    // en: A Static* variant cannot be moved out through this class: its handle points into the derived object
+    // ja: Static* 版はこのクラス経由でもムーブできない: ハンドルが派生オブジェクトの領域を指すため
+    template <class Derived, detail::EnableIfDerived<BasicMutex, Derived> = 0>
+    BasicMutex(Derived &&) = delete;
+    template <class Derived, detail::EnableIfDerived<BasicMutex, Derived> = 0>
+    BasicMutex &operator=(Derived &&) = delete;
+
+    // en: Create the semaphore now (task context) instead of on first use; same rules as Queue::begin()
+    // ja: 初回使用時ではなく今セマフォを生成する（タスク文脈）。規則は Queue::begin() と同じ
+    bool begin() { return ensureCreated() != nullptr; }
+
     bool lock(uint32_t timeoutMs = WaitForever)
     {
-      if (!handle_)
+      SemaphoreHandle_t handle = ensureCreated();
+      if (!handle)
       {
-        ESP_LOGE(kLogTag, "[Mutex] lock failed: handle null");
+        this->logError("[Mutex] lock failed: handle null");
         return false;
       }
       if (xPortInIsrContext())
       {
-        ESP_LOGE(kLogTag, "[Mutex] lock called in ISR");
+        this->logError("[Mutex] lock called in ISR");
         return false;
       }
 
       TickType_t ticks = (timeoutMs == 0) ? 0 : (timeoutMs == WaitForever ? portMAX_DELAY : pdMS_TO_TICKS(timeoutMs));
-      BaseType_t rc = xSemaphoreTake(handle_, ticks);
+      const int64_t blockStart = this->blockBegin(ticks);
+      const detail::LockProbe probe = this->lockBegin(handle, ticks);
+      BaseType_t rc = xSemaphoreTake(handle, ticks);
+      this->blockEnd(blockStart);
       if (rc != pdPASS)
       {
-        ESP_LOGW(kLogTag, "[Mutex] lock timeout");
+        this->countFailure(ticks != 0);
+        if (ticks != 0)
+        {
+          this->logTimeout("[Mutex] lock timeout");
+        }
         return false;
       }
+      this->countReceive();
+      this->lockAcquired(probe);
       return true;
     }
 
     bool tryLock() { return lock(0); }
+    bool lock(const Deadline &deadline) { return detail::untilDeadline(deadline, [&](uint32_t ms) { return lock(ms); }); }
 
+    // en: Never creates the semaphore: a mutex that was never locked cannot be held, so that is logged as misuse
+    // ja: セマフォを生成しない。一度もロックされていない Mutex は保持されえないため誤用としてログに出す
     bool unlock()
     {
-      if (!handle_)
+      SemaphoreHandle_t handle = handle_.load(std::memory_order_acquire);
+      if (!handle)
       {
-        ESP_LOGE(kLogTag, "[Mutex] unlock failed: handle null");
+        this->countFailure(false);
+        this->logError("[Mutex] unlock failed: not locked (handle null)");
         return false;
       }
-      BaseType_t rc = xSemaphoreGive(handle_);
+      this->lockReleasing(handle);
+      BaseType_t rc = xSemaphoreGive(handle);
       if (rc != pdPASS)
       {
-        ESP_LOGW(kLogTag, "[Mutex] unlock failed");
+        this->countFailure(false);
+        this->logWarn("[Mutex] unlock failed");
         return false;
       }
+      this->countSend();
       return true;
     }
 
     class LockGuard
     {
     public:
-      explicit LockGuard(Mutex &m, uint32_t timeoutMs = WaitForever)
+      explicit LockGuard(BasicMutex &m, uint32_t timeoutMs = WaitForever)
           : mutex_(&m), locked_(m.lock(timeoutMs))
       {
         if (!locked_)
         {
-          ESP_LOGW(kLogTag, "[Mutex] LockGuard lock failed");
+          m.logTimeout("[Mutex] LockGuard lock failed");
+        }
+      }
+
+      explicit LockGuard(BasicMutex &m, const Deadline &deadline)
+          : mutex_(&m), locked_(m.lock(deadline))
+      {
+        if (!locked_)
+        {
+          m.logTimeout("[Mutex] LockGuard lock failed");
         }
       }
 
@@ -820,12 +2014,72 @@ namespace ESP32SyncKit
       bool locked() const { return locked_; }
 
     private:
-      Mutex *mutex_;
+      BasicMutex *mutex_;
       bool locked_;
     };
 
+  protected:
+    // en: Adopt a handle created by a Static* variant
+    // ja: Static* 版で生成したハンドルを引き取る
+    BasicMutex(detail::AdoptHandle, SemaphoreHandle_t handle)
+        : handle_(handle)
+    {
+      if (!handle)
+      {
+        this->logError("[Mutex] create failed");
+      }
+    }
+
   private:
-    SemaphoreHandle_t handle_;
+    // en: First-use creation with the same CAS publication as Queue; refused in an ISR
+    // ja: Queue と同じ CAS による公開で初回使用時に生成する。ISR では拒否する
+    SemaphoreHandle_t ensureCreated()
+    {
+      SemaphoreHandle_t handle = handle_.load(std::memory_order_acquire);
+      if (handle)
+      {
+        return handle;
+      }
+      if (xPortInIsrContext())
+      {
+        this->logError("[Mutex] create failed: first use in ISR, call begin() first");
+        return nullptr;
+      }
+      SemaphoreHandle_t created = xSemaphoreCreateMutex();
+      if (!created)
+      {
+        this->logError("[Mutex] create failed");
+        return nullptr;
+      }
+      if (!handle_.compare_exchange_strong(handle, created, std::memory_order_acq_rel, std::memory_order_acquire))
+      {
+        vSemaphoreDelete(created); // en: another task won / ja: 他タスクが先に生成した
+        return handle;
+      }
+      return created;
+    }
+
+    std::atomic<SemaphoreHandle_t> handle_;
   };
 
+  using Mutex = BasicMutex<>;
+
 } // namespace ESP32SyncKit
+
+#include "ESP32SyncKitSpscQueue.h"
+#include "ESP32SyncKitStatic.h"
+#include "ESP32SyncKitBufferPool.h"
+#include "ESP32SyncKitObjectQueue.h"
+#include "ESP32SyncKitMutexProfile.h"
+#include "ESP32SyncKitEventFlags.h"
+#include "ESP32SyncKitSelect.h"
+#include "ESP32SyncKitStreamBuffer.h"
+#include "ESP32SyncKitLatest.h"
+#include "ESP32SyncKitSharedMutex.h"
+#include "ESP32SyncKitHybridMutex.h"
+#include "ESP32SyncKitMpscQueue.h"
+#include "ESP32SyncKitPriorityQueue.h"
+#include "ESP32SyncKitDeferredExecutor.h"
+#include "ESP32SyncKitWorkPool.h"
+#include "ESP32SyncKitTopic.h"
+#include "ESP32SyncKitFuture.h"
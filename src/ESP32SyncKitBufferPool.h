@@ -0,0 +1,277 @@
+#pragma once
+
+#include "ESP32SyncKit.h"
+
+namespace ESP32SyncKit
+{
+
+  template <class T, uint32_t N, class LogPolicy>
+  class BufferPool;
+
+  namespace detail
+  {
+    // en: What a Loan needs from its pool: the free list, and an error hook that goes through the pool's LogPolicy
+    // ja: Loan がプールから必要とするもの: フリーリストと、プールのログポリシーを通るエラー出力
+    struct PoolLink
+    {
+      QueueHandle_t freeList;
+      const void *pool;
+      void (*logError)(const void *pool, const char *message);
+    };
+
+    template <class T>
+    struct PoolSlot
+    {
+      T value;
+      const PoolLink *link; // en: owning pool / ja: 所属プール
+    };
+  } // namespace detail
+
+  // en: Move-only handle to a pooled buffer. Returns the buffer to its pool when dropped.
+  // ja: プールのバッファを指すムーブ専用ハンドル。破棄時に自動でプールへ返却する
+  template <class T>
+  class Loan
+  {
+  public:
+    // en: Opaque single-pointer token used to pass a loan through a queue
+    // ja: キューで受け渡すための不透明なポインタ1個分のトークン
+    using Raw = detail::PoolSlot<T> *;
+
+    Loan() = default;
+
+    ~Loan() { reset(); }
+
+    Loan(const Loan &) = delete;
+    Loan &operator=(const Loan &) = delete;
+
+    Loan(Loan &&other) noexcept : slot_(other.slot_)
+    {
+      other.slot_ = nullptr;
+    }
+    Loan &operator=(Loan &&other) noexcept
+    {
+      if (this != &other)
+      {
+        reset();
+        slot_ = other.slot_;
+        other.slot_ = nullptr;
+      }
+      return *this;
+    }
+
+    T *get() const { return slot_ ? &slot_->value : nullptr; }
+    T &operator*() const { return slot_->value; }
+    T *operator->() const { return &slot_->value; }
+    explicit operator bool() const { return slot_ != nullptr; }
+
+    // en: Return the buffer to the pool now (ISR-safe)
+    // ja: バッファを今すぐプールへ返却（ISR 可）
+    void reset()
+    {
+      if (!slot_)
+      {
+        return;
+      }
+      Raw slot = slot_;
+      slot_ = nullptr;
+
+      BaseType_t rc;
+      const bool inIsr = xPortInIsrContext();
+      if (inIsr)
+      {
+        BaseType_t taskWoken = pdFALSE;
+        rc = xQueueSendFromISR(slot->link->freeList, &slot, &taskWoken);
+        if (taskWoken == pdTRUE)
+        {
+          portYIELD_FROM_ISR();
+        }
+      }
+      else
+      {
+        rc = xQueueSend(slot->link->freeList, &slot, 0);
+      }
+      if (rc != pdPASS)
+      {
+        slot->link->logError(slot->link->pool, "[BufferPool] release failed: free list full (double release?)");
+      }
+    }
+
+    // en: Give up ownership without returning the buffer; re-wrap it later with adopt()
+    // ja: 返却せずに所有権を手放す。後で adopt() で包み直すこと
+    Raw detach()
+    {
+      Raw slot = slot_;
+      slot_ = nullptr;
+      return slot;
+    }
+
+    static Loan adopt(Raw raw) { return Loan(raw); }
+
+    // en: Send the token through a queue of Raw; ownership moves only on success. An empty loan returns false
+    // en: silently: it has no pool, and the acquire or receive that left it empty already reported.
+    // ja: Raw のキューへトークンを送る。成功時のみ所有権が移る。空の Loan は黙って false を返す: 所属プールがなく、
+    // ja: 空になった原因の取得・受信がすでに報告しているため
+    template <class Q>
+    bool sendTo(Q &queue, uint32_t timeoutMs = WaitForever)
+    {
+      if (!slot_)
+      {
+        return false;
+      }
+      if (!queue.send(slot_, timeoutMs))
+      {
+        return false;
+      }
+      slot_ = nullptr;
+      return true;
+    }
+
+    template <class Q>
+    bool trySendTo(Q &queue) { return sendTo(queue, 0); }
+
+    template <class Q>
+    bool sendTo(Q &queue, const Deadline &deadline) { return detail::untilDeadline(deadline, [&](uint32_t ms) { return sendTo(queue, ms); }); }
+
+    // en: Receive a token from a queue of Raw; returns an empty loan on timeout
+    // ja: Raw のキューからトークンを受け取る。タイムアウト時は空の Loan を返す
+    template <class Q>
+    static Loan receiveFrom(Q &queue, uint32_t timeoutMs = WaitForever)
+    {
+      Raw raw = nullptr;
+      if (!queue.receive(raw, timeoutMs))
+      {
+        return Loan();
+      }
+      return Loan(raw);
+    }
+
+    template <class Q>
+    static Loan tryReceiveFrom(Q &queue) { return receiveFrom(queue, 0); }
+
+    template <class Q>
+    static Loan receiveFrom(Q &queue, const Deadline &deadline) { return detail::untilDeadline(deadline, [&](uint32_t ms) { return receiveFrom(queue, ms); }); }
+
+  private:
+    template <class, uint32_t, class>
+    friend class BufferPool;
+
+    explicit Loan(Raw slot) : slot_(slot) {}
+
+    Raw slot_ = nullptr;
+  };
+
+  // en: Fixed-capacity pool of N buffers of T. O(1) acquire/release via a static free-list queue.
+  // ja: T のバッファを N 個持つ固定容量プール。静的なフリーリストキューで O(1) の取得/返却
+  template <class T, uint32_t N, class LogPolicy = LogAll>
+  class BufferPool : protected detail::Diagnostics<LogPolicy>
+  {
+    static_assert(N > 0, "BufferPool: N must be > 0");
+
+  public:
+    BufferPool()
+        : freeList_(xQueueCreateStatic(N, sizeof(detail::PoolSlot<T> *), freeListStorage_, &freeListBuffer_)),
+          link_{freeList_, this, &BufferPool::logLoanError}
+    {
+      if (!freeList_)
+      {
+        this->logError("[BufferPool] create failed: xQueueCreateStatic");
+        return;
+      }
+      for (uint32_t i = 0; i < N; ++i)
+      {
+        detail::PoolSlot<T> *slot = &slots_[i];
+        slot->link = &link_;
+        (void)xQueueSend(freeList_, &slot, 0);
+      }
+    }
+
+    ~BufferPool()
+    {
+      if (freeList_)
+      {
+        if (uxQueueMessagesWaiting(freeList_) != N)
+        {
+          this->logError("[BufferPool] destroyed with outstanding loans");
+        }
+        vQueueDelete(freeList_);
+        freeList_ = nullptr;
+      }
+    }
+
+    // en: Slots point back to this pool, so it cannot be copied or moved
+    // ja: スロットがこのプールを参照するため、コピー・ムーブ不可
+    BufferPool(const BufferPool &) = delete;
+    BufferPool &operator=(const BufferPool &) = delete;
+    BufferPool(BufferPool &&) = delete;
+    BufferPool &operator=(BufferPool &&) = delete;
+
+    Loan<T> tryAcquire() { return acquire(0); }
+    Loan<T> acquire(const Deadline &deadline) { return detail::untilDeadline(deadline, [&](uint32_t ms) { return acquire(ms); }); }
+
+    Loan<T> acquire(uint32_t timeoutMs = WaitForever)
+    {
+      if (!freeList_)
+      {
+        this->logError("[BufferPool] acquire failed: handle null");
+        return Loan<T>();
+      }
+
+      const bool inIsr = xPortInIsrContext();
+      TickType_t ticks = (inIsr || timeoutMs == 0) ? 0 : (timeoutMs == WaitForever ? portMAX_DELAY : pdMS_TO_TICKS(timeoutMs));
+      const bool nonBlocking = (ticks == 0);
+      detail::PoolSlot<T> *slot = nullptr;
+
+      if (inIsr)
+      {
+        BaseType_t taskWoken = pdFALSE;
+        BaseType_t rc = xQueueReceiveFromISR(freeList_, &slot, &taskWoken);
+        if (taskWoken == pdTRUE)
+        {
+          portYIELD_FROM_ISR();
+        }
+        if (rc != pdPASS)
+        {
+          this->logWarn("[BufferPool] acquire ISR failed: exhausted");
+          return Loan<T>();
+        }
+        return Loan<T>(slot);
+      }
+      else
+      {
+        BaseType_t rc = xQueueReceive(freeList_, &slot, ticks);
+        if (rc != pdPASS)
+        {
+          if (!nonBlocking)
+          {
+            this->logTimeout("[BufferPool] acquire timeout/exhausted");
+          }
+          return Loan<T>();
+        }
+        return Loan<T>(slot);
+      }
+    }
+
+    uint32_t available() const
+    {
+      if (!freeList_)
+      {
+        return 0;
+      }
+      return xPortInIsrContext() ? uxQueueMessagesWaitingFromISR(freeList_) : uxQueueMessagesWaiting(freeList_);
+    }
+
+    static constexpr uint32_t capacity() { return N; }
+
+  private:
+    // en: Loan errors reach the pool's Diagnostics through its link, which also defers them in an ISR
+    // ja: Loan のエラーはリンク経由でプールの Diagnostics に届く（ISR では後回しの出力にもなる）
+    static void logLoanError(const void *pool, const char *message) { static_cast<const BufferPool *>(pool)->logError(message); }
+
+    StaticQueue_t freeListBuffer_;
+    uint8_t freeListStorage_[N * sizeof(detail::PoolSlot<T> *)];
+    QueueHandle_t freeList_;
+    detail::PoolLink link_;
+    detail::PoolSlot<T> slots_[N];
+  };
+
+} // namespace ESP32SyncKit
@@ -0,0 +1,316 @@
+#pragma once
+
+#include "ESP32SyncKit.h"
+
+#include <cstddef>
+#include <new>
+#include <stdio.h>
+#include <type_traits>
+#include <utility>
+
+namespace ESP32SyncKit
+{
+
+  // en: Worker tasks started by DeferredExecutor::begin()
+  // ja: DeferredExecutor::begin() が起動するワーカタスクの設定
+  struct ExecutorConfig
+  {
+    const char *name = "deferred";     // en: task name prefix, worker index appended / ja: タスク名の接頭辞（ワーカ番号を付加）
+    uint32_t stackSize = 4096;         // en: per worker / ja: ワーカごと
+    UBaseType_t priority = 2;          // en: above loop() / ja: loop() より上
+    uint8_t workers = 1;               // en: 1..kMaxExecutorWorkers / ja: 1..kMaxExecutorWorkers
+    BaseType_t core = tskNO_AFFINITY;  // en: core for every worker / ja: 全ワーカのコア
+    bool pinPerCore = false;           // en: pin worker i to core i % portNUM_PROCESSORS (core ignored) / ja: ワーカ i をコア i % portNUM_PROCESSORS に固定（core は無視）
+  };
+
+  inline constexpr uint8_t kMaxExecutorWorkers = 8;
+
+  // en: Snapshot returned by DeferredExecutor::stats()
+  // ja: DeferredExecutor::stats() が返すスナップショット
+  struct ExecutorStats
+  {
+    uint32_t posted = 0;      // en: callables accepted / ja: 受け付けた関数の数
+    uint32_t rejected = 0;    // en: posts refused (full, or ISR before begin) / ja: 拒否した post（満杯、または begin 前の ISR）
+    uint32_t executed = 0;    // en: callables run to completion / ja: 実行を終えた関数の数
+    uint32_t peakPending = 0; // en: deepest backlog seen at post time / ja: post 時点で見た最大の滞留数
+    uint64_t execUsTotal = 0; // en: cumulative execution time / ja: 実行時間の累計
+    uint32_t execUsMax = 0;   // en: longest single callable / ja: 1回あたりの最長実行時間
+  };
+
+  // en: Runs callables posted from ISRs or tasks on a few shared worker tasks, so one executor replaces
+  // en: a dispatch task (and its stack) per interrupt source. Callables are stored inline in the queue item:
+  // en: no heap, no std::function. Jobs are dequeued in FIFO order; with one worker they also run in order.
+  // ja: ISR やタスクから post した関数を共有のワーカタスクで実行する。割り込み源ごとのディスパッチタスク
+  // ja: （とそのスタック）を1つのエグゼキュータにまとめられる。関数はキュー要素の中にそのまま格納する:
+  // ja: ヒープも std::function も使わない。取り出しは FIFO 順で、ワーカが1つなら実行も順番どおり
+  template <size_t InlineSize = 24, class LogPolicy = LogAll>
+  class DeferredExecutor : protected detail::Diagnostics<LogPolicy>
+  {
+    static_assert(InlineSize >= sizeof(void *), "DeferredExecutor: InlineSize must hold at least a pointer");
+
+  public:
+    // en: Constant-initialized like Queue<T>; the job queue is created on first post() or begin()
+    // ja: Queue<T> と同様に定数初期化される。ジョブキューは最初の post() または begin() で生成される
+    constexpr explicit DeferredExecutor(uint32_t depth) : queue_(depth) {}
+
+    ~DeferredExecutor()
+    {
+      if (workerCount_ != 0)
+      {
+        (void)end();
+      }
+      if (exited_)
+      {
+        vSemaphoreDelete(exited_);
+      }
+    }
+
+    // en: Worker tasks point back at this object, so it cannot be copied or moved
+    // ja: ワーカタスクがこのオブジェクトを参照するため、コピー・ムーブ不可
+    DeferredExecutor(const DeferredExecutor &) = delete;
+    DeferredExecutor &operator=(const DeferredExecutor &) = delete;
+    DeferredExecutor(DeferredExecutor &&) = delete;
+    DeferredExecutor &operator=(DeferredExecutor &&) = delete;
+
+    // en: Create the job queue and start the workers (task context). Posts made earlier wait in the queue.
+    // ja: ジョブキューを生成してワーカを起動する（タスク文脈）。それ以前の post はキューで待つ
+    bool begin(const ExecutorConfig &config = ExecutorConfig())
+    {
+      if (xPortInIsrContext())
+      {
+        this->logError("[DeferredExecutor] begin called in ISR");
+        return false;
+      }
+      if (workerCount_ != 0)
+      {
+        this->logWarn("[DeferredExecutor] begin failed: already started");
+        return false;
+      }
+      if (config.workers == 0 || config.workers > kMaxExecutorWorkers)
+      {
+        this->logError("[DeferredExecutor] begin failed: workers=%ld out of range", static_cast<long>(config.workers));
+        return false;
+      }
+      if (!queue_.begin())
+      {
+        this->logError("[DeferredExecutor] begin failed: queue create");
+        return false;
+      }
+      if (!exited_)
+      {
+        exited_ = xSemaphoreCreateCountingStatic(kMaxExecutorWorkers, 0, &exitedBuffer_);
+      }
+
+      for (uint8_t i = 0; i < config.workers; ++i)
+      {
+        char name[configMAX_TASK_NAME_LEN];
+        snprintf(name, sizeof(name), "%s%u", config.name ? config.name : "deferred", i);
+        const BaseType_t core = config.pinPerCore ? static_cast<BaseType_t>(i % portNUM_PROCESSORS) : config.core;
+        if (xTaskCreatePinnedToCore(&DeferredExecutor::workerMain, name, config.stackSize, this, config.priority, &workers_[i], core) != pdPASS)
+        {
+          workers_[i] = nullptr;
+          this->logError("[DeferredExecutor] begin failed: worker %ld create", static_cast<long>(i));
+          (void)end();
+          return false;
+        }
+        ++workerCount_;
+      }
+      return true;
+    }
+
+    // en: Stop the workers after they finish every job posted before this call. Task only, not from a worker.
+    // ja: この呼び出し以前に post されたジョブをすべて終えてからワーカを止める。タスク専用、ワーカからは不可
+    bool end(uint32_t timeoutMs = WaitForever)
+    {
+      if (xPortInIsrContext())
+      {
+        this->logError("[DeferredExecutor] end called in ISR");
+        return false;
+      }
+      const TaskHandle_t self = xTaskGetCurrentTaskHandle();
+      for (uint8_t i = 0; i < workerCount_; ++i)
+      {
+        if (workers_[i] == self)
+        {
+          this->logError("[DeferredExecutor] end called from a worker");
+          return false;
+        }
+      }
+
+      // en: One stop request per worker, queued behind the pending jobs; counted so a retry after a timeout
+      // en: does not leave extra requests for the next begin()
+      // ja: ワーカごとに1つの停止要求を、滞留中のジョブの後ろに積む。タイムアウト後の再試行で
+      // ja: 余分な要求が次の begin() に残らないよう数えておく
+      const Deadline deadline = Deadline::after(timeoutMs);
+      const Job stop{};
+      while (stopsSent_ < workerCount_)
+      {
+        if (!queue_.send(stop, deadline))
+        {
+          this->logTimeout("[DeferredExecutor] end timeout");
+          return false;
+        }
+        ++stopsSent_;
+      }
+      while (workerCount_ != 0)
+      {
+        const uint32_t ms = deadline.timeoutMs();
+        TickType_t ticks = (ms == WaitForever) ? portMAX_DELAY : pdMS_TO_TICKS(ms);
+        if (xSemaphoreTake(exited_, ticks) != pdPASS)
+        {
+          this->logTimeout("[DeferredExecutor] end timeout");
+          return false;
+        }
+        --workerCount_;
+        --stopsSent_;
+      }
+      for (TaskHandle_t &worker : workers_)
+      {
+        worker = nullptr;
+      }
+      return true;
+    }
+
+    // en: Queue fn() for a worker. Any task or ISR; blocks only in a task while the queue is full.
+    // en: fn must fit in InlineSize and be trivially copyable: capture values and pointers, not String or std::function.
+    // ja: fn() をワーカに積む。任意のタスク・ISR から呼べ、キューが満杯のときタスクからの呼び出しだけブロックする。
+    // ja: fn は InlineSize に収まりトリビアルコピー可能であること: 値やポインタをキャプチャし、String や std::function は不可
+    template <class F>
+    bool post(F &&fn, uint32_t timeoutMs = WaitForever) { return postJob(makeJob(std::forward<F>(fn)), timeoutMs); }
+
+    template <class F>
+    bool tryPost(F &&fn) { return post(std::forward<F>(fn), 0); }
+
+    template <class F>
+    bool post(F &&fn, const Deadline &deadline)
+    {
+      const Job job = makeJob(std::forward<F>(fn));
+      return detail::untilDeadline(deadline, [&](uint32_t ms) { return postJob(job, ms); });
+    }
+
+    // en: Jobs waiting for a worker (snapshot; ISR-safe)
+    // ja: ワーカを待っているジョブ数（スナップショット。ISR 可）
+    uint32_t pending() const { return queue_.count(); }
+
+    uint8_t workers() const { return workerCount_; }
+
+    ExecutorStats stats() const
+    {
+      ExecutorStats snap;
+      snap.posted = stats_.posted.load(std::memory_order_relaxed);
+      snap.rejected = stats_.rejected.load(std::memory_order_relaxed);
+      snap.executed = stats_.executed.load(std::memory_order_relaxed);
+      snap.peakPending = stats_.peakPending.load(std::memory_order_relaxed);
+      snap.execUsTotal = stats_.execUsTotal.load(std::memory_order_relaxed);
+      snap.execUsMax = stats_.execUsMax.load(std::memory_order_relaxed);
+      return snap;
+    }
+
+    void resetStats()
+    {
+      stats_.posted.store(0, std::memory_order_relaxed);
+      stats_.rejected.store(0, std::memory_order_relaxed);
+      stats_.executed.store(0, std::memory_order_relaxed);
+      stats_.peakPending.store(0, std::memory_order_relaxed);
+      stats_.execUsTotal.store(0, std::memory_order_relaxed);
+      stats_.execUsMax.store(0, std::memory_order_relaxed);
+    }
+
+  private:
+    // en: invoke == nullptr is the stop request sent by end()
+    // ja: invoke == nullptr は end() が送る停止要求
+    struct Job
+    {
+      void (*invoke)(void *storage);
+      alignas(std::max_align_t) unsigned char storage[InlineSize];
+    };
+
+    struct Counters
+    {
+      std::atomic<uint32_t> posted{0};
+      std::atomic<uint32_t> rejected{0};
+      std::atomic<uint32_t> executed{0};
+      std::atomic<uint32_t> peakPending{0};
+      std::atomic<uint64_t> execUsTotal{0};
+      std::atomic<uint32_t> execUsMax{0};
+    };
+
+    template <class F>
+    static Job makeJob(F &&fn)
+    {
+      using Fn = typename std::decay<F>::type;
+      static_assert(sizeof(Fn) <= InlineSize, "DeferredExecutor: callable does not fit in InlineSize; capture less or raise InlineSize");
+      static_assert(alignof(Fn) <= alignof(std::max_align_t), "DeferredExecutor: callable is over-aligned");
+      static_assert(std::is_trivially_copyable<Fn>::value && std::is_trivially_destructible<Fn>::value,
+                    "DeferredExecutor: callable must be trivially copyable (capture values or pointers)");
+
+      Job job;
+      job.invoke = [](void *storage) { (*static_cast<Fn *>(storage))(); };
+      ::new (static_cast<void *>(job.storage)) Fn(std::forward<F>(fn));
+      return job;
+    }
+
+    bool postJob(const Job &job, uint32_t timeoutMs)
+    {
+      const bool inIsr = xPortInIsrContext();
+      if (!queue_.send(job, timeoutMs))
+      {
+        stats_.rejected.fetch_add(1, std::memory_order_relaxed);
+        if (inIsr)
+        {
+          this->logWarn("[DeferredExecutor] post ISR failed: full");
+        }
+        else if (timeoutMs != 0)
+        {
+          this->logTimeout("[DeferredExecutor] post timeout/full");
+        }
+        return false;
+      }
+      stats_.posted.fetch_add(1, std::memory_order_relaxed);
+      raise(stats_.peakPending, queue_.count());
+      return true;
+    }
+
+    static void workerMain(void *pv)
+    {
+      static_cast<DeferredExecutor *>(pv)->run();
+      vTaskDelete(nullptr);
+    }
+
+    void run()
+    {
+      Job job;
+      while (queue_.receive(job))
+      {
+        if (!job.invoke)
+        {
+          break;
+        }
+        const int64_t start = esp_timer_get_time();
+        job.invoke(job.storage);
+        const uint32_t us = static_cast<uint32_t>(esp_timer_get_time() - start);
+        stats_.executed.fetch_add(1, std::memory_order_relaxed);
+        stats_.execUsTotal.fetch_add(us, std::memory_order_relaxed);
+        raise(stats_.execUsMax, us);
+      }
+      (void)xSemaphoreGive(exited_);
+    }
+
+    static void raise(std::atomic<uint32_t> &target, uint32_t value)
+    {
+      uint32_t cur = target.load(std::memory_order_relaxed);
+      while (value > cur && !target.compare_exchange_weak(cur, value, std::memory_order_relaxed))
+      {
+      }
+    }
+
+    Queue<Job, NoStats, LogNone> queue_;
+    Counters stats_;
+    uint8_t workerCount_ = 0;
+    uint8_t stopsSent_ = 0;
+    TaskHandle_t workers_[kMaxExecutorWorkers] = {};
+    SemaphoreHandle_t exited_ = nullptr;
+    StaticSemaphore_t exitedBuffer_ = {};
+  };
+
+} // namespace ESP32SyncKit
@@ -0,0 +1,309 @@
+#pragma once
+
+#include "ESP32SyncKit.h"
+
+#include <freertos/event_groups.h>
+
+namespace ESP32SyncKit
+{
+
+  // en: Bits usable by EventFlags (the top byte of an event group is reserved by FreeRTOS)
+  // ja: EventFlags で使えるビット（イベントグループの最上位バイトは FreeRTOS が予約）
+  inline constexpr EventBits_t kEventFlagsMask = 0x00ffffffUL;
+
+  // en: Event group wrapper: any number of tasks can wait on the same bits, and one set() wakes every
+  // en: matching waiter. sync() is a rendezvous barrier built on xEventGroupSync.
+  // ja: イベントグループのラッパー。複数タスクが同じビットを待て、set() 1回で条件を満たす待機者を全員起こす。
+  // ja: sync() は xEventGroupSync によるランデブー（バリア）
+  template <class StatsPolicy = NoStats, class LogPolicy = LogAll>
+  class BasicEventFlags : public detail::StatsRecorder<StatsPolicy>, protected detail::Diagnostics<LogPolicy>
+  {
+    static_assert(!std::is_same<StatsPolicy, WithProfile>::value, "EventFlags: WithProfile is Mutex-only, use WithStats");
+
+  public:
+    BasicEventFlags()
+        : handle_(xEventGroupCreate())
+    {
+      if (!handle_)
+      {
+        this->logError("[EventFlags] create failed");
+      }
+    }
+
+    ~BasicEventFlags()
+    {
+      if (handle_)
+      {
+        vEventGroupDelete(handle_);
+        handle_ = nullptr;
+      }
+    }
+
+    BasicEventFlags(const BasicEventFlags &) = delete;
+    BasicEventFlags &operator=(const BasicEventFlags &) = delete;
+
+    BasicEventFlags(BasicEventFlags &&other) noexcept : handle_(other.handle_)
+    {
+      other.handle_ = nullptr;
+    }
+    BasicEventFlags &operator=(BasicEventFlags &&other) noexcept
+    {
+      if (this != &other)
+      {
+        if (handle_)
+        {
+          vEventGroupDelete(handle_);
+        }
+        handle_ = other.handle_;
+        other.handle_ = nullptr;
+      }
+      return *this;
+    }
+
+    // en: A Static* variant cannot be moved out through this class: its handle points into the derived object
+    // ja: Static* 版はこのクラス経由でもムーブできない: ハンドルが派生オブジェクトの領域を指すため
+    template <class Derived, detail::EnableIfDerived<BasicEventFlags, Derived> = 0>
+    BasicEventFlags(Derived &&) = delete;
+    template <class Derived, detail::EnableIfDerived<BasicEventFlags, Derived> = 0>
+    BasicEventFlags &operator=(Derived &&) = delete;
+
+    // en: OR bits in and wake every waiter they satisfy. From an ISR the update is deferred to the timer daemon task.
+    // ja: ビットを OR で立て、条件を満たす待機者を全員起こす。ISR からはタイマーデーモンタスクへ委譲される
+    bool set(EventBits_t bits)
+    {
+      if (!checkBits(bits))
+      {
+        return false;
+      }
+
+      if (xPortInIsrContext())
+      {
+        BaseType_t taskWoken = pdFALSE;
+        BaseType_t rc = xEventGroupSetBitsFromISR(handle_, bits, &taskWoken);
+        if (taskWoken == pdTRUE)
+        {
+          portYIELD_FROM_ISR();
+        }
+        if (rc != pdPASS)
+        {
+          this->countFailure(false);
+          this->logWarn("[EventFlags] set ISR failed: timer queue full");
+          return false;
+        }
+        this->countSend();
+        return true;
+      }
+
+      (void)xEventGroupSetBits(handle_, bits);
+      this->countSend();
+      return true;
+    }
+
+    bool clear(EventBits_t bits)
+    {
+      if (!checkBits(bits))
+      {
+        return false;
+      }
+
+      if (xPortInIsrContext())
+      {
+        if (xEventGroupClearBitsFromISR(handle_, bits) != pdPASS)
+        {
+          this->countFailure(false);
+          this->logWarn("[EventFlags] clear ISR failed: timer queue full");
+          return false;
+        }
+        return true;
+      }
+
+      (void)xEventGroupClearBits(handle_, bits);
+      return true;
+    }
+
+    EventBits_t get() const
+    {
+      if (!handle_)
+      {
+        this->logError("[EventFlags] get failed: handle null");
+        return 0;
+      }
+      return (xPortInIsrContext() ? xEventGroupGetBitsFromISR(handle_) : xEventGroupGetBits(handle_)) & kEventFlagsMask;
+    }
+
+    // en: Wait until any (or all) of mask is set. Bits stay set by default so every waiter sees the broadcast.
+    // en: observed (optional) receives the bits as they were when the wait ended, before clearing.
+    // ja: mask のいずれか（または全部）が立つまで待つ。既定ではビットを残し、全待機者がブロードキャストを受け取れる。
+    // ja: observed（省略可）には待ち終了時点（クリア前）のビットが入る
+    bool wait(EventBits_t mask, uint32_t timeoutMs = WaitForever, bool clearOnExit = false, bool waitAll = false, EventBits_t *observed = nullptr)
+    {
+      if (!checkBits(mask))
+      {
+        return false;
+      }
+
+      if (xPortInIsrContext())
+      {
+        // en: An ISR clear is only queued to the timer daemon, so it cannot consume the bits atomically: other
+        // en: waiters and a second ISR poll would still see them
+        // ja: ISR からのクリアはタイマーデーモンに積まれるだけで、ビットをアトミックに消費できない: 他の待機者や
+        // ja: 2回目の ISR での確認にはまだ見えてしまう
+        if (clearOnExit)
+        {
+          this->countFailure(false);
+          this->logError("[EventFlags] wait with clearOnExit not allowed in ISR");
+          return false;
+        }
+        // en: xEventGroupWaitBits is task-only; fall back to a non-blocking check
+        // ja: xEventGroupWaitBits はタスク専用のため、ノンブロックの確認で代用
+        const EventBits_t bits = xEventGroupGetBitsFromISR(handle_) & kEventFlagsMask;
+        if (observed)
+        {
+          *observed = bits;
+        }
+        if (!satisfied(bits, mask, waitAll))
+        {
+          this->countFailure(false);
+          return false;
+        }
+        this->countReceive();
+        return true;
+      }
+
+      TickType_t ticks = (timeoutMs == 0) ? 0 : (timeoutMs == WaitForever ? portMAX_DELAY : pdMS_TO_TICKS(timeoutMs));
+      const int64_t blockStart = this->blockBegin(ticks);
+      const EventBits_t bits = xEventGroupWaitBits(handle_, mask, clearOnExit ? pdTRUE : pdFALSE, waitAll ? pdTRUE : pdFALSE, ticks) & kEventFlagsMask;
+      this->blockEnd(blockStart);
+      if (observed)
+      {
+        *observed = bits;
+      }
+      if (!satisfied(bits, mask, waitAll))
+      {
+        this->countFailure(ticks != 0);
+        if (ticks != 0)
+        {
+          this->logTimeout("[EventFlags] wait timeout");
+        }
+        return false;
+      }
+      this->countReceive();
+      return true;
+    }
+
+    bool tryWait(EventBits_t mask, bool clearOnExit = false, bool waitAll = false, EventBits_t *observed = nullptr)
+    {
+      return wait(mask, 0, clearOnExit, waitAll, observed);
+    }
+
+    bool wait(EventBits_t mask, const Deadline &deadline, bool clearOnExit = false, bool waitAll = false, EventBits_t *observed = nullptr)
+    {
+      return detail::untilDeadline(deadline, [&](uint32_t ms) { return wait(mask, ms, clearOnExit, waitAll, observed); });
+    }
+
+    // en: Rendezvous: set own bit(s), then wait until every bit in waitMask is set. All participants are
+    // en: released together and waitMask is cleared for the next round (task only).
+    // ja: ランデブー: 自分のビットを立て、waitMask の全ビットが揃うまで待つ。参加者は同時に解放され、
+    // ja: 次の周回のため waitMask はクリアされる（タスクのみ）
+    bool sync(EventBits_t bitsToSet, EventBits_t waitMask, uint32_t timeoutMs = WaitForever)
+    {
+      if (!checkBits(waitMask) || (bitsToSet & ~kEventFlagsMask) != 0)
+      {
+        return false;
+      }
+      if (xPortInIsrContext())
+      {
+        this->logError("[EventFlags] sync called in ISR");
+        return false;
+      }
+
+      TickType_t ticks = (timeoutMs == 0) ? 0 : (timeoutMs == WaitForever ? portMAX_DELAY : pdMS_TO_TICKS(timeoutMs));
+      const int64_t blockStart = this->blockBegin(ticks);
+      const EventBits_t bits = xEventGroupSync(handle_, bitsToSet, waitMask, ticks);
+      this->blockEnd(blockStart);
+      this->countSend();
+      if ((bits & waitMask) != waitMask)
+      {
+        this->countFailure(ticks != 0);
+        if (ticks != 0)
+        {
+          this->logTimeout("[EventFlags] sync timeout");
+        }
+        return false;
+      }
+      this->countReceive();
+      return true;
+    }
+
+    // en: Forwarded once (not retried for a precise deadline), since every call sets bitsToSet again
+    // ja: 呼び出すたびに bitsToSet を立て直すため、precise な期限でも再試行せず1回だけ転送する
+    bool sync(EventBits_t bitsToSet, EventBits_t waitMask, const Deadline &deadline)
+    {
+      return sync(bitsToSet, waitMask, deadline.timeoutMs());
+    }
+
+  protected:
+    // en: Adopt a handle created by a Static* variant
+    // ja: Static* 版で生成したハンドルを引き取る
+    BasicEventFlags(detail::AdoptHandle, EventGroupHandle_t handle)
+        : handle_(handle)
+    {
+      if (!handle_)
+      {
+        this->logError("[EventFlags] create failed");
+      }
+    }
+
+  private:
+    static bool satisfied(EventBits_t bits, EventBits_t mask, bool waitAll)
+    {
+      return waitAll ? ((bits & mask) == mask) : ((bits & mask) != 0);
+    }
+
+    bool checkBits(EventBits_t bits) const
+    {
+      if (!handle_)
+      {
+        this->logError("[EventFlags] failed: handle null");
+        return false;
+      }
+      if (bits == 0 || (bits & ~kEventFlagsMask) != 0)
+      {
+        this->logError("[EventFlags] invalid bits (use 0x00ffffff)");
+        return false;
+      }
+      return true;
+    }
+
+    EventGroupHandle_t handle_;
+  };
+
+  using EventFlags = BasicEventFlags<>;
+
+  namespace detail
+  {
+    struct StaticEventGroupStorage
+    {
+      StaticEventGroup_t eventGroupBuffer_;
+    };
+  } // namespace detail
+
+  // en: EventFlags backed by xEventGroupCreateStatic
+  // ja: xEventGroupCreateStatic で生成する EventFlags
+  template <class StatsPolicy = NoStats, class LogPolicy = LogAll>
+  class BasicStaticEventFlags : private detail::StaticEventGroupStorage, public BasicEventFlags<StatsPolicy, LogPolicy>
+  {
+  public:
+    BasicStaticEventFlags()
+        : BasicEventFlags<StatsPolicy, LogPolicy>(detail::AdoptHandle{},
+                                                  xEventGroupCreateStatic(&this->eventGroupBuffer_))
+    {
+    }
+
+    BasicStaticEventFlags(BasicStaticEventFlags &&) = delete;
+    BasicStaticEventFlags &operator=(BasicStaticEventFlags &&) = delete;
+  };
+
+  using StaticEventFlags = BasicStaticEventFlags<>;
+
+} // namespace ESP32SyncKit
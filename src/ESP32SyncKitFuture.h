@@ -0,0 +1,316 @@
+#pragma once
+
+#include "ESP32SyncKit.h"
+
+#include <type_traits>
+
+namespace ESP32SyncKit
+{
+
+  // en: Futures waiting for a value at the same time, across all types (8 bytes of RAM each)
+  // ja: 同時に値を待てる Future の数。全型で共有（1件あたり RAM 8 バイト）
+  inline constexpr size_t kMaxPendingPromises = 32;
+
+  template <class T, class LogPolicy, UBaseType_t NotifyIndex>
+  class Future;
+
+  namespace detail
+  {
+    // en: Ticket table linking Promises to their Future. A Promise holds only a ticket, so once the Future
+    // en: is destroyed or re-armed the ticket no longer matches and set() never touches the old memory.
+    // en: One short critical section per operation; no kernel objects.
+    // ja: Promise と Future を結ぶチケット表。Promise はチケットしか持たないため、Future が破棄・再設定されると
+    // ja: チケットが一致しなくなり、set() が古いメモリに触れることはない。操作ごとに短いクリティカルセクション1回。
+    // ja: カーネルオブジェクトは使わない
+    class PromiseRegistry
+    {
+    public:
+      // en: Returns 0 when every slot is taken
+      // ja: 全スロット使用中なら 0 を返す
+      uint32_t attach(void *future)
+      {
+        portENTER_CRITICAL_SAFE(&mux_);
+        for (uint32_t i = 0; i < kMaxPendingPromises; ++i)
+        {
+          Slot &slot = slots_[i];
+          if (slot.ticket == 0)
+          {
+            // en: 24 bits survive the shift; skipping generation 0 keeps every ticket non-zero, slot 0 included
+            // ja: シフト後に残るのは 24 ビット。世代 0 を飛ばすことで、スロット 0 を含めてチケットは常に非ゼロ
+            generation_ = (generation_ + 1) & kGenerationMask;
+            if (generation_ == 0)
+            {
+              generation_ = 1;
+            }
+            slot.ticket = (generation_ << 8) | i;
+            slot.future = future;
+            const uint32_t ticket = slot.ticket;
+            portEXIT_CRITICAL_SAFE(&mux_);
+            return ticket;
+          }
+        }
+        portEXIT_CRITICAL_SAFE(&mux_);
+        return 0;
+      }
+
+      // en: The following are called inside lock()/unlock()
+      // ja: 以下は lock()/unlock() の内側で呼ぶ
+      void lock() { portENTER_CRITICAL_SAFE(&mux_); }
+      void unlock() { portEXIT_CRITICAL_SAFE(&mux_); }
+
+      // en: Future the ticket belongs to, or nullptr once it was used or revoked
+      // ja: チケットが属する Future。使用済み・無効化済みなら nullptr
+      void *find(uint32_t ticket) const
+      {
+        const Slot &slot = slots_[ticket & 0xff];
+        return (ticket != 0 && slot.ticket == ticket) ? slot.future : nullptr;
+      }
+
+      // en: Revoke a ticket; harmless if it was already used
+      // ja: チケットを無効にする。使用済みでも無害
+      void release(uint32_t ticket)
+      {
+        Slot &slot = slots_[ticket & 0xff];
+        if (ticket != 0 && slot.ticket == ticket)
+        {
+          slot.ticket = 0;
+          slot.future = nullptr;
+        }
+      }
+
+    private:
+      static_assert(kMaxPendingPromises >= 1 && kMaxPendingPromises <= 256, "kMaxPendingPromises must be 1..256 (8-bit slot index)");
+
+      struct Slot
+      {
+        uint32_t ticket; // en: generation << 8 | index, 0 = free / ja: 世代 << 8 | 番号。0 = 空き
+        void *future;
+      };
+
+      static constexpr uint32_t kGenerationMask = 0x00ffffffu;
+
+      portMUX_TYPE mux_ = portMUX_INITIALIZER_UNLOCKED;
+      uint32_t generation_ = 0;
+      Slot slots_[kMaxPendingPromises] = {};
+    };
+
+    // en: Constant-initialized, so a Promise may be set from an ISR before any task touched it
+    // ja: 定数初期化されるため、どのタスクより先に ISR から Promise を設定しても安全
+    inline PromiseRegistry promiseRegistry;
+
+    // en: A Promise must stay trivially copyable, so it logs through the policy's static timeout hook:
+    // en: a dropped set() is reported like a timeout (LogAll only)
+    // ja: Promise はトリビアルコピー可能である必要があるため、ポリシーの static なタイムアウト出力を使う:
+    // ja: 捨てられた set() はタイムアウトと同じ扱いで報告する（LogAll のみ）
+    template <class LogPolicy>
+    struct PromiseLog : Diagnostics<LogPolicy>
+    {
+      using Diagnostics<LogPolicy>::logTimeout;
+    };
+  } // namespace detail
+
+  // en: Write side of a one-shot result: a small handle (ticket + pointer) that may be copied into a Queue
+  // en: message or a DeferredExecutor capture. The first set() wins; copies share the same ticket.
+  // ja: 1回限りの結果の書き込み側: Queue のメッセージや DeferredExecutor のキャプチャにコピーできる小さな
+  // ja: ハンドル（チケット + ポインタ）。最初の set() だけが有効で、コピーは同じチケットを共有する
+  template <class T, class LogPolicy = LogAll, UBaseType_t NotifyIndex = kSyncKitNotifyIndex>
+  class Promise
+  {
+  public:
+    Promise() = default;
+
+    // en: False for a default-constructed Promise or when Future::promise() found no free slot
+    // ja: デフォルト構築した Promise、または Future::promise() が空きスロットを得られなかったときは false
+    bool valid() const { return ticket_ != 0; }
+
+    // en: Store value in the Future and wake its waiter (task or ISR). False if the Promise was already set,
+    // en: or the Future was destroyed, re-armed or cancelled; the value is then discarded.
+    // ja: value を Future に格納し、待機者を起こす（タスク・ISR 両対応）。すでに設定済み、または Future が
+    // ja: 破棄・再設定・取り消しされていたら false を返し、値は捨てる
+    bool set(const T &value)
+    {
+      const bool inIsr = xPortInIsrContext();
+      TaskHandle_t waiter = nullptr;
+
+      detail::promiseRegistry.lock();
+      void *target = detail::promiseRegistry.find(ticket_);
+      if (target == nullptr || target != future_)
+      {
+        detail::promiseRegistry.unlock();
+        detail::PromiseLog<LogPolicy>::logTimeout(inIsr ? "[Promise] set ISR dropped: future gone or already set"
+                                                        : "[Promise] set dropped: future gone or already set");
+        return false;
+      }
+      future_->value_ = value;
+      future_->ready_ = true;
+      future_->ticket_ = 0;
+      waiter = future_->waiter_;
+      future_->waiter_ = nullptr;
+      detail::promiseRegistry.release(ticket_);
+      detail::promiseRegistry.unlock();
+
+      if (waiter)
+      {
+        detail::NotifyChannel<NotifyIndex>::give(waiter, inIsr);
+      }
+      return true;
+    }
+
+  private:
+    friend class Future<T, LogPolicy, NotifyIndex>;
+
+    Promise(Future<T, LogPolicy, NotifyIndex> *future, uint32_t ticket) : future_(future), ticket_(ticket) {}
+
+    Future<T, LogPolicy, NotifyIndex> *future_ = nullptr; // en: only dereferenced while the ticket matches / ja: チケットが一致する間だけ参照する
+    uint32_t ticket_ = 0;
+  };
+
+  // en: Read side of a one-shot result. The value is stored inside this object and the waiter sleeps on its own
+  // en: task notification (slot NotifyIndex, reserved: do not use it with Notify), so a request/response needs no
+  // en: Queue, semaphore or heap. Reusable: each promise() starts a new round. Destroying it (e.g. after a timeout)
+  // en: safely orphans the outstanding Promise.
+  // ja: 1回限りの結果の読み取り側。値はこのオブジェクト内に格納され、待機者は自身のタスク通知（NotifyIndex 番の
+  // ja: スロット。専有のため Notify とは併用しない）で眠るため、要求/応答に Queue・セマフォ・ヒープが要らない。
+  // ja: 再利用可能で、promise() ごとに新しい回が始まる。破棄しても（タイムアウト後など）未設定の Promise は安全に切り離される
+  template <class T, class LogPolicy = LogAll, UBaseType_t NotifyIndex = kSyncKitNotifyIndex>
+  class Future : protected detail::Diagnostics<LogPolicy>
+  {
+    using Channel = detail::NotifyChannel<NotifyIndex>;
+
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "Future: T must be trivially copyable; the value is copied inside a critical section");
+
+  public:
+    Future() = default;
+
+    ~Future()
+    {
+      cancel();
+    }
+
+    // en: The outstanding Promise refers to this object's address, so it cannot be copied or moved
+    // ja: 未設定の Promise がこのオブジェクトのアドレスを参照するため、コピー・ムーブ不可
+    Future(const Future &) = delete;
+    Future &operator=(const Future &) = delete;
+    Future(Future &&) = delete;
+    Future &operator=(Future &&) = delete;
+
+    // en: Start a new round and return its Promise; any earlier Promise and value are discarded.
+    // en: Returns an invalid Promise when kMaxPendingPromises are already outstanding.
+    // ja: 新しい回を始めてその Promise を返す。以前の Promise と値は破棄する。
+    // ja: 未設定の Promise がすでに kMaxPendingPromises 件あれば無効な Promise を返す
+    Promise<T, LogPolicy, NotifyIndex> promise()
+    {
+      cancel();
+      const uint32_t ticket = detail::promiseRegistry.attach(this);
+      if (ticket == 0)
+      {
+        this->logError("[Future] promise failed: %ld pending promises", static_cast<long>(kMaxPendingPromises));
+        return Promise<T, LogPolicy, NotifyIndex>();
+      }
+      detail::promiseRegistry.lock();
+      ticket_ = ticket;
+      ready_ = false;
+      detail::promiseRegistry.unlock();
+      return Promise<T, LogPolicy, NotifyIndex>(this, ticket);
+    }
+
+    // en: Orphan the outstanding Promise (its set() returns false) and clear the value. A task asleep in get()
+    // en: keeps its registration, so only set() ever claims it.
+    // ja: 未設定の Promise を切り離し（その set() は false を返す）、値を消す。get() で眠っているタスクの登録は
+    // ja: 残すため、それを確保するのは set() だけ
+    void cancel()
+    {
+      detail::promiseRegistry.lock();
+      detail::promiseRegistry.release(ticket_);
+      ticket_ = 0;
+      ready_ = false;
+      detail::promiseRegistry.unlock();
+    }
+
+    bool tryGet(T &out) { return get(out, 0); }
+    bool get(T &out, const Deadline &deadline) { return detail::untilDeadline(deadline, [&](uint32_t ms) { return get(out, ms); }); }
+
+    // en: Copy the value once set. Does not consume it: get() keeps returning it until the next promise()/cancel().
+    // en: One waiting task at a time; it sleeps on its notification slot NotifyIndex.
+    // ja: 値が設定されたらコピーする。消費はしない: 次の promise()/cancel() まで get() は同じ値を返す。
+    // ja: 待てるのは同時に1タスク。そのタスクの NotifyIndex 番の通知スロットで眠る
+    bool get(T &out, uint32_t timeoutMs = WaitForever)
+    {
+      const bool inIsr = xPortInIsrContext();
+      TickType_t ticks = (inIsr || timeoutMs == 0) ? 0 : (timeoutMs == WaitForever ? portMAX_DELAY : pdMS_TO_TICKS(timeoutMs));
+      const bool infinite = (ticks == portMAX_DELAY);
+      const TickType_t start = inIsr ? 0 : xTaskGetTickCount();
+      TickType_t remaining = ticks;
+
+      while (true)
+      {
+        detail::promiseRegistry.lock();
+        waiter_ = nullptr;
+        if (ready_)
+        {
+          out = value_;
+          detail::promiseRegistry.unlock();
+          return true;
+        }
+        if (remaining == 0 || ticket_ == 0)
+        {
+          const bool armed = (ticket_ != 0);
+          detail::promiseRegistry.unlock();
+          if (!armed)
+          {
+            this->logError("[Future] get failed: no promise outstanding");
+          }
+          else if (ticks != 0)
+          {
+            this->logTimeout("[Future] get timeout");
+          }
+          return false;
+        }
+        // en: Registered under the same lock set() takes, so the wakeup cannot slip between check and sleep
+        // ja: set() と同じロックの中で登録するため、確認と眠りの間に通知を取りこぼさない
+        waiter_ = xTaskGetCurrentTaskHandle();
+        detail::promiseRegistry.unlock();
+
+        // en: set() clears waiter_ before its give; take that give unless it is what woke us
+        // ja: set() は give の前に waiter_ を消す。それで起きたのでなければその give を受け取っておく
+        const uint32_t taken = Channel::wait(remaining);
+        detail::promiseRegistry.lock();
+        const bool claimed = (waiter_ == nullptr);
+        waiter_ = nullptr;
+        detail::promiseRegistry.unlock();
+        if (claimed && taken == 0)
+        {
+          Channel::absorb();
+        }
+
+        if (!infinite)
+        {
+          TickType_t elapsed = xTaskGetTickCount() - start;
+          remaining = (elapsed >= ticks) ? 0 : ticks - elapsed;
+        }
+      }
+    }
+
+    // en: True once the Promise of the current round has been set
+    // ja: 現在の回の Promise が設定されたら true
+    bool ready() const
+    {
+      detail::promiseRegistry.lock();
+      const bool r = ready_;
+      detail::promiseRegistry.unlock();
+      return r;
+    }
+
+  private:
+    friend class Promise<T, LogPolicy, NotifyIndex>;
+
+    // en: All fields are guarded by the registry lock
+    // ja: すべてのフィールドはレジストリのロックで保護する
+    T value_{};
+    bool ready_ = false;
+    uint32_t ticket_ = 0; // en: 0 = no promise outstanding / ja: 0 = 未設定の Promise なし
+    TaskHandle_t waiter_ = nullptr;
+  };
+
+} // namespace ESP32SyncKit
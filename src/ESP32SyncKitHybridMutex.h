@@ -0,0 +1,240 @@
+#pragma once
+
+#include "ESP32SyncKit.h"
+
+#include <atomic>
+
+namespace ESP32SyncKit
+{
+
+  // en: Default number of polls of the lock word before HybridMutex blocks (roughly a few microseconds on ESP32)
+  // ja: HybridMutex がブロックする前にロック語をポーリングする既定回数（ESP32 でおよそ数マイクロ秒）
+  inline constexpr uint32_t kHybridSpinDefault = 200;
+
+  // en: Mutex for very short cross-core critical sections: an atomic fast path, then a bounded spin while
+  // en: the holder (typically on the other core) finishes, then a blocking wait on a binary semaphore.
+  // en: No priority inheritance; use Mutex when a low-priority holder may be preempted. Task only.
+  // ja: ごく短いコア間クリティカルセクション向けのミューテックス。アトミックな高速パス、保持者（通常は別コア）が
+  // ja: 終わるまでの上限付きスピン、その後バイナリセマフォでブロック待ち。
+  // ja: 優先度継承はない。低優先度の保持者が横取りされうる場合は Mutex を使う。タスク専用
+  template <class StatsPolicy = NoStats, class LogPolicy = LogAll>
+  class BasicHybridMutex : public detail::StatsRecorder<StatsPolicy>, protected detail::Diagnostics<LogPolicy>
+  {
+    static_assert(!std::is_same<StatsPolicy, WithProfile>::value, "HybridMutex: WithProfile is Mutex-only, use WithStats");
+
+  public:
+    explicit BasicHybridMutex(uint32_t spinCount = kHybridSpinDefault)
+        : spinCount_(portNUM_PROCESSORS > 1 ? spinCount : 0),
+          wakeup_(xSemaphoreCreateBinaryStatic(&wakeupBuffer_))
+    {
+    }
+
+    ~BasicHybridMutex()
+    {
+      if (state_.load(std::memory_order_relaxed) != kUnlocked)
+      {
+        this->logError("[HybridMutex] destroyed while locked");
+      }
+      vSemaphoreDelete(wakeup_);
+    }
+
+    // en: Waiters refer to the lock word and semaphore inside the object, so it cannot be copied or moved
+    // ja: 待機者はオブジェクト内のロック語とセマフォを参照するため、コピー・ムーブ不可
+    BasicHybridMutex(const BasicHybridMutex &) = delete;
+    BasicHybridMutex &operator=(const BasicHybridMutex &) = delete;
+    BasicHybridMutex(BasicHybridMutex &&) = delete;
+    BasicHybridMutex &operator=(BasicHybridMutex &&) = delete;
+
+    bool lock(uint32_t timeoutMs = WaitForever)
+    {
+      if (xPortInIsrContext())
+      {
+        this->logError("[HybridMutex] lock called in ISR");
+        return false;
+      }
+
+      TaskHandle_t self = xTaskGetCurrentTaskHandle();
+      if (owner_.load(std::memory_order_relaxed) == self)
+      {
+        this->logError("[HybridMutex] lock failed: already held by this task (not recursive)");
+        return false;
+      }
+
+      // en: Fast path and spin: no kernel call while the holder releases within spinCount polls
+      // ja: 高速パスとスピン: 保持者が spinCount 回のポーリング内に解放すればカーネル呼び出しなし
+      uint32_t expected = kUnlocked;
+      if (state_.compare_exchange_strong(expected, kLocked, std::memory_order_acquire, std::memory_order_relaxed))
+      {
+        return acquired(self);
+      }
+      if (timeoutMs == 0)
+      {
+        // en: Try-lock: the single CAS above, no spin, and the word is never marked contended
+        // ja: トライロック: 上の CAS 1回のみ。スピンせず、ロック語を待機者ありにもしない
+        this->countFailure(false);
+        return false;
+      }
+      for (uint32_t i = 0; i < spinCount_; ++i)
+      {
+        if (state_.load(std::memory_order_relaxed) == kUnlocked)
+        {
+          expected = kUnlocked;
+          if (state_.compare_exchange_weak(expected, kLocked, std::memory_order_acquire, std::memory_order_relaxed))
+          {
+            return acquired(self);
+          }
+        }
+      }
+
+      TickType_t ticks = (timeoutMs == WaitForever) ? portMAX_DELAY : pdMS_TO_TICKS(timeoutMs);
+      if (ticks == 0)
+      {
+        // en: Shorter than a tick: nothing to block on, so leave without the exchange that would make the holder's
+        // en: unlock() give a token nobody takes
+        // ja: 1ティック未満: ブロックできないため、保持者の unlock() に誰も受け取らないトークンを give させる
+        // ja: exchange をせずに抜ける
+        this->countFailure(false);
+        return false;
+      }
+      const bool infinite = (ticks == portMAX_DELAY);
+      const TickType_t start = xTaskGetTickCount();
+      TickType_t remaining = ticks;
+      const int64_t blockStart = this->blockBegin(ticks);
+
+      // en: Slow path: mark the word "locked, waiters present" so unlock() gives the semaphore.
+      // en: A wakeup is only a hint; the exchange decides who owns the lock.
+      // ja: 低速パス: ロック語を「ロック中・待機者あり」にして unlock() にセマフォを give させる。
+      // ja: 起床はヒントにすぎず、所有者は exchange で決まる
+      while (state_.exchange(kContended, std::memory_order_acquire) != kUnlocked)
+      {
+        if (remaining == 0 || xSemaphoreTake(wakeup_, remaining) != pdPASS)
+        {
+          this->blockEnd(blockStart);
+          this->countFailure(true);
+          this->logTimeout("[HybridMutex] lock timeout");
+          return false;
+        }
+        if (!infinite)
+        {
+          TickType_t elapsed = xTaskGetTickCount() - start;
+          remaining = (elapsed >= ticks) ? 0 : ticks - elapsed;
+        }
+      }
+      this->blockEnd(blockStart);
+      return acquired(self);
+    }
+
+    bool tryLock() { return lock(0); }
+    bool lock(const Deadline &deadline) { return detail::untilDeadline(deadline, [&](uint32_t ms) { return lock(ms); }); }
+
+    // en: Owner only
+    // ja: 所有者のみ
+    bool unlock()
+    {
+      if (owner_.load(std::memory_order_relaxed) != xTaskGetCurrentTaskHandle())
+      {
+        this->countFailure(false);
+        this->logWarn("[HybridMutex] unlock failed: not the owner");
+        return false;
+      }
+      owner_.store(nullptr, std::memory_order_relaxed);
+      if (state_.exchange(kUnlocked, std::memory_order_release) == kContended)
+      {
+        (void)xSemaphoreGive(wakeup_);
+      }
+      this->countSend();
+      return true;
+    }
+
+    uint32_t spinCount() const { return spinCount_; }
+
+    // en: Number of polls before blocking (forced to 0 on single-core builds, where spinning cannot help)
+    // ja: ブロック前のポーリング回数（シングルコア構成ではスピンが無意味なので常に 0）
+    void setSpinCount(uint32_t spinCount) { spinCount_ = portNUM_PROCESSORS > 1 ? spinCount : 0; }
+
+    // en: Same shape as Mutex::LockGuard
+    // ja: Mutex::LockGuard と同じ形
+    class LockGuard
+    {
+    public:
+      explicit LockGuard(BasicHybridMutex &m, uint32_t timeoutMs = WaitForever)
+          : mutex_(&m), locked_(m.lock(timeoutMs))
+      {
+        if (!locked_)
+        {
+          m.logTimeout("[HybridMutex] LockGuard lock failed");
+        }
+      }
+
+      explicit LockGuard(BasicHybridMutex &m, const Deadline &deadline)
+          : mutex_(&m), locked_(m.lock(deadline))
+      {
+        if (!locked_)
+        {
+          m.logTimeout("[HybridMutex] LockGuard lock failed");
+        }
+      }
+
+      ~LockGuard()
+      {
+        if (locked_ && mutex_)
+        {
+          mutex_->unlock();
+        }
+      }
+
+      LockGuard(const LockGuard &) = delete;
+      LockGuard &operator=(const LockGuard &) = delete;
+
+      LockGuard(LockGuard &&other) noexcept
+          : mutex_(other.mutex_), locked_(other.locked_)
+      {
+        other.mutex_ = nullptr;
+        other.locked_ = false;
+      }
+
+      LockGuard &operator=(LockGuard &&other) noexcept
+      {
+        if (this != &other)
+        {
+          if (locked_ && mutex_)
+          {
+            mutex_->unlock();
+          }
+          mutex_ = other.mutex_;
+          locked_ = other.locked_;
+          other.mutex_ = nullptr;
+          other.locked_ = false;
+        }
+        return *this;
+      }
+
+      bool locked() const { return locked_; }
+
+    private:
+      BasicHybridMutex *mutex_;
+      bool locked_;
+    };
+
+  private:
+    static constexpr uint32_t kUnlocked = 0;
+    static constexpr uint32_t kLocked = 1;    // en: held, nobody blocked / ja: 保持中、ブロック中の待機者なし
+    static constexpr uint32_t kContended = 2; // en: held, someone may sleep on wakeup_ / ja: 保持中、wakeup_ で眠る待機者あり得る
+
+    bool acquired(TaskHandle_t self)
+    {
+      owner_.store(self, std::memory_order_relaxed);
+      this->countReceive();
+      return true;
+    }
+
+    std::atomic<uint32_t> state_{kUnlocked};
+    std::atomic<TaskHandle_t> owner_{nullptr};
+    uint32_t spinCount_;
+    StaticSemaphore_t wakeupBuffer_;
+    SemaphoreHandle_t wakeup_;
+  };
+
+  using HybridMutex = BasicHybridMutex<>;
+
+} // namespace ESP32SyncKit
@@ -0,0 +1,244 @@
+#pragma once
+
+#include "ESP32SyncKit.h"
+
+#include <atomic>
+#include <string.h>
+#include <type_traits>
+
+namespace ESP32SyncKit
+{
+
+  // en: Values up to this size use the two-slot seqlock, larger ones the triple buffer
+  // ja: このサイズ以下の値は2スロットの seqlock、それより大きい値はトリプルバッファを使う
+  inline constexpr size_t kLatestSeqlockMaxBytes = 32;
+
+  // en: Latest update policies: readers poll only, or one reader may block in waitNewer()
+  // ja: Latest の更新ポリシー: 読み手はポーリングのみ、または1つの読み手が waitNewer() でブロックできる
+  struct PollOnly
+  {
+  };
+  struct WakeOnUpdate
+  {
+  };
+
+  // en: Most-recent-value cell: one writer (task or ISR) never blocks, any number of readers on either core
+  // en: get a consistent copy without kernel calls. Reading does not consume the value.
+  // en: waitNewer() sleeps on notification slot NotifyIndex of the reader (reserved: do not use it with Notify).
+  // ja: 最新値セル: 1つの書き手（タスクまたは ISR）は決してブロックせず、両コアの任意個の読み手が
+  // ja: カーネル呼び出しなしで一貫したコピーを得る。読んでも値は消費されない。
+  // ja: waitNewer() は読み手タスクの NotifyIndex 番の通知スロットで眠る（専有: Notify とは併用しない）
+  template <class T, class UpdatePolicy = PollOnly, class LogPolicy = LogAll, UBaseType_t NotifyIndex = kSyncKitNotifyIndex>
+  class Latest : protected detail::Diagnostics<LogPolicy>
+  {
+    static_assert(std::is_trivially_copyable<T>::value, "Latest: T must be trivially copyable");
+    static_assert(std::is_same<UpdatePolicy, PollOnly>::value || std::is_same<UpdatePolicy, WakeOnUpdate>::value,
+                  "Latest: UpdatePolicy must be PollOnly or WakeOnUpdate");
+
+  public:
+    // en: Two slots let a reader that preempts the writer on the same core still find a complete copy;
+    // en: a third gives long copies one more write period before the writer laps them.
+    // ja: 2スロットあれば同じコアで書き手を割り込んだ読み手も完成済みのコピーを読める。
+    // ja: 3スロット目はコピーが長い場合に、書き手に追い越されるまで書き込み1回分の猶予を与える
+    static constexpr size_t kSlots = sizeof(T) <= kLatestSeqlockMaxBytes ? 2 : 3;
+
+    Latest() = default;
+
+    explicit Latest(const T &initial)
+    {
+      write(initial);
+    }
+
+    // en: Readers and the waiter refer to this object's address, so it cannot be copied or moved
+    // ja: 読み手と待機者はこのオブジェクトのアドレスを参照するため、コピー・ムーブ不可
+    Latest(const Latest &) = delete;
+    Latest &operator=(const Latest &) = delete;
+    Latest(Latest &&) = delete;
+    Latest &operator=(Latest &&) = delete;
+
+    // en: Publish a new value (single writer; task or ISR). Never blocks.
+    // ja: 新しい値を公開する（書き手は1つ。タスクまたは ISR）。ブロックしない
+    void write(const T &value)
+    {
+      const size_t next = (latest_.load(std::memory_order_relaxed) + 1) % kSlots;
+      uint32_t version = version_.load(std::memory_order_relaxed) + 1;
+      if (version == 0)
+      {
+        version = 1; // en: 0 means "never written" / ja: 0 は「未書き込み」を表す
+      }
+
+      Slot &slot = slots_[next];
+      const uint32_t seq = slot.seq.load(std::memory_order_relaxed);
+      slot.seq.store(seq + 1, std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_release);
+      slot.version.store(version, std::memory_order_relaxed);
+      const unsigned char *src = reinterpret_cast<const unsigned char *>(&value);
+      for (size_t i = 0; i < kWords; ++i)
+      {
+        uint32_t word = 0;
+        memcpy(&word, src + i * 4, chunk(i));
+        slot.words[i].store(word, std::memory_order_relaxed);
+      }
+      slot.seq.store(seq + 2, std::memory_order_release);
+
+      latest_.store(next, std::memory_order_release);
+      version_.store(version, std::memory_order_release);
+      wakeReader();
+    }
+
+    // en: Copy the latest value into out; false if nothing has been written yet. Any context.
+    // ja: 最新値を out へコピーする。まだ書き込みがなければ false。どの文脈からでも可
+    bool read(T &out) const
+    {
+      if (version_.load(std::memory_order_acquire) == 0)
+      {
+        return false;
+      }
+      (void)load(out);
+      return true;
+    }
+
+    // en: Copy only if the value changed since seenVersion, then update seenVersion (start from 0)
+    // ja: seenVersion 以降に値が変わった場合だけコピーし、seenVersion を更新する（初期値は 0）
+    bool readIfNewer(T &out, uint32_t &seenVersion) const
+    {
+      const uint32_t version = version_.load(std::memory_order_acquire);
+      if (version == 0 || version == seenVersion)
+      {
+        return false;
+      }
+      seenVersion = load(out);
+      return true;
+    }
+
+    // en: Block until the value changes from seenVersion (WakeOnUpdate only; one waiting task at a time).
+    // en: In an ISR this behaves like readIfNewer().
+    // ja: 値が seenVersion から変わるまでブロックする（WakeOnUpdate のみ。同時に待てるタスクは1つ）。
+    // ja: ISR では readIfNewer() と同じ動作
+    bool waitNewer(T &out, uint32_t &seenVersion, uint32_t timeoutMs = WaitForever)
+    {
+      static_assert(std::is_same<UpdatePolicy, WakeOnUpdate>::value, "Latest: waitNewer() needs Latest<T, WakeOnUpdate>");
+
+      const bool inIsr = xPortInIsrContext();
+      TickType_t ticks = (inIsr || timeoutMs == 0) ? 0 : (timeoutMs == WaitForever ? portMAX_DELAY : pdMS_TO_TICKS(timeoutMs));
+      if (readIfNewer(out, seenVersion))
+      {
+        return true;
+      }
+      if (ticks == 0)
+      {
+        return false;
+      }
+
+      TaskHandle_t self = xTaskGetCurrentTaskHandle();
+      TaskHandle_t expected = nullptr;
+      if (!waiter_.compare_exchange_strong(expected, self, std::memory_order_acq_rel) && expected != self)
+      {
+        this->logError("[Latest] waitNewer failed: another task is already waiting");
+        return false;
+      }
+
+      const bool infinite = (ticks == portMAX_DELAY);
+      const TickType_t start = xTaskGetTickCount();
+      TickType_t remaining = ticks;
+
+      while (true)
+      {
+        waiter_.store(self, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (readIfNewer(out, seenVersion))
+        {
+          Channel::leave(waiter_, 0);
+          return true;
+        }
+
+        Channel::leave(waiter_, Channel::wait(remaining));
+        if (readIfNewer(out, seenVersion))
+        {
+          return true;
+        }
+
+        if (!infinite)
+        {
+          TickType_t elapsed = xTaskGetTickCount() - start;
+          if (elapsed >= ticks)
+          {
+            this->logTimeout("[Latest] waitNewer timeout");
+            return false;
+          }
+          remaining = ticks - elapsed;
+        }
+      }
+    }
+
+    bool waitNewer(T &out, uint32_t &seenVersion, const Deadline &deadline)
+    {
+      return detail::untilDeadline(deadline, [&](uint32_t ms) { return waitNewer(out, seenVersion, ms); });
+    }
+
+    // en: Number of writes so far (wraps, skipping 0); 0 = never written
+    // ja: これまでの書き込み回数（0 を飛ばして一周する）。0 = 未書き込み
+    uint32_t version() const { return version_.load(std::memory_order_acquire); }
+
+    bool hasValue() const { return version() != 0; }
+
+  private:
+    using Channel = detail::NotifyChannel<NotifyIndex>;
+
+    static constexpr size_t kWords = (sizeof(T) + 3) / 4;
+
+    struct Slot
+    {
+      std::atomic<uint32_t> seq{0}; // en: odd while the writer is copying / ja: 書き手がコピー中は奇数
+      std::atomic<uint32_t> version{0};
+      std::atomic<uint32_t> words[kWords] = {};
+    };
+
+    static constexpr size_t chunk(size_t word)
+    {
+      return (word + 1) * 4 <= sizeof(T) ? 4 : sizeof(T) - word * 4;
+    }
+
+    // en: Seqlock read of the newest slot; retries only if the writer lapped it mid-copy. Returns its version.
+    // ja: 最新スロットの seqlock 読み出し。コピー中に書き手に追い越された場合だけやり直す。そのバージョンを返す
+    uint32_t load(T &out) const
+    {
+      unsigned char *dst = reinterpret_cast<unsigned char *>(&out);
+      while (true)
+      {
+        const Slot &slot = slots_[latest_.load(std::memory_order_acquire)];
+        const uint32_t seq = slot.seq.load(std::memory_order_acquire);
+        if (seq & 1)
+        {
+          continue;
+        }
+        const uint32_t version = slot.version.load(std::memory_order_relaxed);
+        for (size_t i = 0; i < kWords; ++i)
+        {
+          const uint32_t word = slot.words[i].load(std::memory_order_relaxed);
+          memcpy(dst + i * 4, &word, chunk(i));
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.seq.load(std::memory_order_relaxed) == seq)
+        {
+          return version;
+        }
+      }
+    }
+
+    void wakeReader()
+    {
+      if (!std::is_same<UpdatePolicy, WakeOnUpdate>::value)
+      {
+        return;
+      }
+      Channel::wake(waiter_, xPortInIsrContext());
+    }
+
+    Slot slots_[kSlots];
+    std::atomic<size_t> latest_{0};
+    std::atomic<uint32_t> version_{0};
+    std::atomic<TaskHandle_t> waiter_{nullptr};
+  };
+
+} // namespace ESP32SyncKit
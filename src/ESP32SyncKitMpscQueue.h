@@ -0,0 +1,224 @@
+#pragma once
+
+#include "ESP32SyncKit.h"
+
+#include <atomic>
+#include <type_traits>
+
+namespace ESP32SyncKit
+{
+
+  // en: Lock-free multi-producer/single-consumer ring for ISRs on both cores feeding one task.
+  // en: Producers claim a slot with a CAS and never block or enter a critical section; the consumer
+  // en: sleeps on its task notification and is woken once per burst, not once per item. It uses slot NotifyIndex
+  // en: (reserved, as for SpscQueue).
+  // ja: 両コアの ISR から1つのタスクへ送るための、ロックフリーの多生産者/単一消費者リング。
+  // ja: 生産者は CAS でスロットを確保し、ブロックもクリティカルセクションも使わない。消費者はタスク通知で眠り、
+  // ja: 1件ごとではなくバーストごとに1回だけ起こされる。使うのは NotifyIndex 番のスロット（SpscQueue と同じく専有）
+  template <class T, size_t N, class LogPolicy = LogAll, UBaseType_t NotifyIndex = kSyncKitNotifyIndex>
+  class MpscQueue : protected detail::Diagnostics<LogPolicy>
+  {
+    static_assert(N >= 2 && (N & (N - 1)) == 0, "MpscQueue: N must be a power of two >= 2");
+    static_assert(std::is_trivially_copyable<T>::value, "MpscQueue: T must be trivially copyable");
+
+  public:
+    // en: All-zero initial state, so a global MpscQueue is constant-initialized and usable from an ISR at once
+    // ja: 初期状態はすべて 0 なので、グローバルな MpscQueue は定数初期化され、すぐに ISR から使える
+    MpscQueue() = default;
+
+    MpscQueue(const MpscQueue &) = delete;
+    MpscQueue &operator=(const MpscQueue &) = delete;
+    MpscQueue(MpscQueue &&) = delete;
+    MpscQueue &operator=(MpscQueue &&) = delete;
+
+    // en: Any task or ISR, any core. Never blocks; false when full (counted in dropped()).
+    // ja: 任意のタスク・ISR・コアから呼べる。ブロックしない。満杯なら false（dropped() に計上）
+    bool trySend(const T &value)
+    {
+      const bool inIsr = xPortInIsrContext();
+      uint32_t pos = tail_.load(std::memory_order_relaxed);
+      Cell *cell = nullptr;
+      while (true)
+      {
+        cell = &cells_[pos & kMask];
+        const int32_t diff = static_cast<int32_t>(cell->stamp.load(std::memory_order_acquire) - lap(pos));
+        if (diff == 0)
+        {
+          if (tail_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed, std::memory_order_relaxed))
+          {
+            break;
+          }
+        }
+        else if (diff < 0)
+        {
+          // en: The slot still holds the item from the previous lap: full
+          // ja: スロットに前の周回の要素が残っている: 満杯
+          dropped_.fetch_add(1, std::memory_order_relaxed);
+          if (inIsr)
+          {
+            this->logWarn("[MpscQueue] send ISR failed: full");
+          }
+          return false;
+        }
+        else
+        {
+          pos = tail_.load(std::memory_order_relaxed); // en: another producer took it / ja: 他の生産者が確保済み
+        }
+      }
+
+      cell->value = value;
+      cell->stamp.store(lap(pos) + 1, std::memory_order_release);
+      Channel::wake(consumerWaiter_, inIsr);
+      return true;
+    }
+
+    bool tryReceive(T &out) { return receive(out, 0); }
+    bool receive(T &out, const Deadline &deadline) { return detail::untilDeadline(deadline, [&](uint32_t ms) { return receive(out, ms); }); }
+
+    // en: Single consumer (one task, or an ISR non-blocking)
+    // ja: 消費者は1つ（1タスク、または ISR からノンブロック）
+    bool receive(T &out, uint32_t timeoutMs = WaitForever)
+    {
+      const bool inIsr = xPortInIsrContext();
+      TickType_t ticks = (inIsr || timeoutMs == 0) ? 0 : (timeoutMs == WaitForever ? portMAX_DELAY : pdMS_TO_TICKS(timeoutMs));
+
+      while (!pop(out))
+      {
+        if (ticks == 0)
+        {
+          return false;
+        }
+        if (!waitForData(ticks))
+        {
+          this->logTimeout("[MpscQueue] receive timeout");
+          return false;
+        }
+      }
+      return true;
+    }
+
+    uint32_t tryReceiveMany(T *out, uint32_t maxN) { return receiveMany(out, maxN, 0); }
+    uint32_t receiveMany(T *out, uint32_t maxN, const Deadline &deadline)
+    {
+      return detail::untilDeadline(deadline, [&](uint32_t ms) { return receiveMany(out, maxN, ms); });
+    }
+
+    // en: Wait for the first item, then drain up to maxN without blocking. Pairs with the once-per-burst wakeup.
+    // ja: 最初の1件を待ち、残りは maxN 件までノンブロックで取り出す。バーストごとに1回の起床と組み合わせて使う
+    uint32_t receiveMany(T *out, uint32_t maxN, uint32_t timeoutMs = WaitForever)
+    {
+      if (!out || maxN == 0)
+      {
+        return 0;
+      }
+      if (!receive(out[0], timeoutMs))
+      {
+        return 0;
+      }
+      uint32_t received = 1;
+      while (received < maxN && pop(out[received]))
+      {
+        ++received;
+      }
+      return received;
+    }
+
+    // en: Items claimed by producers and not yet received (snapshot; ISR-safe)
+    // ja: 生産者が確保し、まだ受信されていない件数（スナップショット。ISR 可）
+    uint32_t count() const
+    {
+      return tail_.load(std::memory_order_acquire) - head_.load(std::memory_order_acquire);
+    }
+
+    // en: Sends rejected because the ring was full (never reset)
+    // ja: 満杯のため拒否された送信の数（リセットしない）
+    uint32_t dropped() const { return dropped_.load(std::memory_order_relaxed); }
+
+    static constexpr uint32_t capacity() { return N; }
+
+  private:
+    using Channel = detail::NotifyChannel<NotifyIndex>;
+
+    static constexpr uint32_t kMask = N - 1;
+
+    // en: Each slot carries a stamp relative to the lap base (pos & ~kMask): base = free for the producer
+    // en: of this lap, base + 1 = holds that producer's item, base + N = free for the next lap.
+    // en: Starting from 0 keeps the initial state all-zero.
+    // ja: 各スロットは周回の基準値（pos & ~kMask）からのスタンプを持つ: base = この周回の生産者が使える、
+    // ja: base + 1 = その生産者の要素がある、base + N = 次の周回で使える。0 から始まるので初期状態はすべて 0
+    struct Cell
+    {
+      std::atomic<uint32_t> stamp{0};
+      T value{};
+    };
+
+    static constexpr uint32_t lap(uint32_t pos) { return pos & ~kMask; }
+
+    bool pop(T &out)
+    {
+      const uint32_t pos = head_.load(std::memory_order_relaxed);
+      Cell &cell = cells_[pos & kMask];
+      if (cell.stamp.load(std::memory_order_acquire) != lap(pos) + 1)
+      {
+        return false; // en: empty, or the next producer has not finished copying / ja: 空、または次の生産者がコピー中
+      }
+      out = cell.value;
+      cell.stamp.store(lap(pos) + N, std::memory_order_release);
+      head_.store(pos + 1, std::memory_order_release);
+      return true;
+    }
+
+    bool hasData() const
+    {
+      const uint32_t pos = head_.load(std::memory_order_relaxed);
+      return cells_[pos & kMask].stamp.load(std::memory_order_acquire) == lap(pos) + 1;
+    }
+
+    // en: Same waiter protocol as SpscQueue: publish, re-check, sleep on the task notification
+    // ja: SpscQueue と同じ待機手順: 登録し、再確認してからタスク通知で眠る
+    bool waitForData(TickType_t ticks)
+    {
+      const bool infinite = (ticks == portMAX_DELAY);
+      const TickType_t start = xTaskGetTickCount();
+      TickType_t remaining = ticks;
+
+      while (true)
+      {
+        consumerWaiter_.store(xTaskGetCurrentTaskHandle(), std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (hasData())
+        {
+          Channel::leave(consumerWaiter_, 0);
+          return true;
+        }
+
+        Channel::leave(consumerWaiter_, Channel::wait(remaining));
+        if (hasData())
+        {
+          return true;
+        }
+
+        if (!infinite)
+        {
+          TickType_t elapsed = xTaskGetTickCount() - start;
+          if (elapsed >= ticks)
+          {
+            return false;
+          }
+          remaining = ticks - elapsed;
+        }
+      }
+    }
+
+    // en: consumer-owned line / ja: 消費者側が書くライン
+    alignas(kCacheLineSize) std::atomic<uint32_t> head_{0};
+    std::atomic<TaskHandle_t> consumerWaiter_{nullptr};
+
+    // en: producer-shared line / ja: 生産者が共有するライン
+    alignas(kCacheLineSize) std::atomic<uint32_t> tail_{0};
+    std::atomic<uint32_t> dropped_{0};
+
+    alignas(kCacheLineSize) Cell cells_[N];
+  };
+
+} // namespace ESP32SyncKit
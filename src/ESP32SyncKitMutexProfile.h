@@ -0,0 +1,176 @@
+#pragma once
+
+#include "ESP32SyncKit.h"
+
+#include <string.h>
+
+namespace ESP32SyncKit
+{
+
+  // en: Histogram buckets: 0 = under 1 us, k = [2^(k-1), 2^k) us, last = everything above
+  // ja: ヒストグラムのバケット: 0 = 1 us 未満、k = [2^(k-1), 2^k) us、最後 = それ以上すべて
+  inline constexpr size_t kProfileBuckets = 20;
+
+  // en: Snapshot returned by BasicMutex<WithProfile>::profile()
+  // ja: BasicMutex<WithProfile>::profile() が返すスナップショット
+  struct MutexProfile
+  {
+    uint32_t acquires = 0;                       // en: successful lock() calls / ja: lock() 成功数
+    uint32_t contended = 0;                      // en: lock() calls that found another task holding it / ja: 他タスク保持中に呼ばれた lock() の数
+    uint32_t inheritances = 0;                   // en: blocking waits that outranked the holder (holder boosted) / ja: 保持者より高優先度で待った回数（保持者が昇格）
+    uint32_t waitUsMax = 0;                      // en: longest successful acquire wait / ja: 取得成功までの最長待ち
+    uint32_t holdUsMax = 0;                      // en: longest hold / ja: 最長保持時間
+    uint64_t holdUsTotal = 0;                    // en: cumulative hold time / ja: 保持時間の累計
+    char longestHolder[configMAX_TASK_NAME_LEN] = {}; // en: task that produced holdUsMax / ja: holdUsMax を記録したタスク名
+    uint32_t waitHistogram[kProfileBuckets] = {};
+    uint32_t holdHistogram[kProfileBuckets] = {};
+
+    // en: Lower bound of bucket i in microseconds
+    // ja: バケット i の下限（マイクロ秒）
+    static constexpr uint32_t bucketFloorUs(size_t i) { return i == 0 ? 0 : (1u << (i - 1)); }
+  };
+
+  namespace detail
+  {
+    // en: Profiling recorder. All updates except contention happen while the caller owns the mutex,
+    // en: so a short critical section is enough to keep profile() consistent.
+    // ja: プロファイル記録。競合の記録以外はすべて呼び出し側がミューテックスを保持している間に行うため、
+    // ja: profile() の整合性は短いクリティカルセクションで足りる
+    template <>
+    class StatsRecorder<WithProfile> : public StatsRecorder<WithStats>
+    {
+    public:
+      MutexProfile profile() const
+      {
+        portENTER_CRITICAL(&mux_);
+        MutexProfile snap = profile_;
+        portEXIT_CRITICAL(&mux_);
+        return snap;
+      }
+
+      void resetProfile()
+      {
+        portENTER_CRITICAL(&mux_);
+        profile_ = MutexProfile{};
+        portEXIT_CRITICAL(&mux_);
+      }
+
+      // en: Print a human-readable report (only non-empty buckets)
+      // ja: 人が読む形式でレポートを出力（空でないバケットのみ）
+      void printProfile(Print &out, const char *name = "Mutex") const
+      {
+        const MutexProfile p = profile();
+        out.printf("[%s] acquires=%lu contended=%lu inheritances=%lu\n",
+                   name,
+                   static_cast<unsigned long>(p.acquires),
+                   static_cast<unsigned long>(p.contended),
+                   static_cast<unsigned long>(p.inheritances));
+        out.printf("[%s] hold max=%lu us by \"%s\" avg=%lu us, wait max=%lu us\n",
+                   name,
+                   static_cast<unsigned long>(p.holdUsMax),
+                   p.longestHolder,
+                   static_cast<unsigned long>(p.acquires ? p.holdUsTotal / p.acquires : 0),
+                   static_cast<unsigned long>(p.waitUsMax));
+        printHistogram(out, name, "wait", p.waitHistogram);
+        printHistogram(out, name, "hold", p.holdHistogram);
+      }
+
+    protected:
+      LockProbe lockBegin(SemaphoreHandle_t handle, TickType_t ticks)
+      {
+        LockProbe probe;
+        probe.startUs = esp_timer_get_time();
+
+        TaskHandle_t holder = xSemaphoreGetMutexHolder(handle);
+        if (holder == nullptr || holder == xTaskGetCurrentTaskHandle())
+        {
+          return probe;
+        }
+        // en: FreeRTOS boosts the holder when a higher-priority task blocks on the mutex
+        // ja: 高優先度タスクがブロックすると FreeRTOS は保持者の優先度を引き上げる
+        const bool inherits = (ticks != 0) && uxTaskPriorityGet(nullptr) > uxTaskPriorityGet(holder);
+        portENTER_CRITICAL(&mux_);
+        ++profile_.contended;
+        if (inherits)
+        {
+          ++profile_.inheritances;
+        }
+        portEXIT_CRITICAL(&mux_);
+        return probe;
+      }
+
+      void lockAcquired(const LockProbe &probe)
+      {
+        const int64_t now = esp_timer_get_time();
+        const uint32_t waitUs = static_cast<uint32_t>(now - probe.startUs);
+        acquiredAtUs_ = now;
+
+        portENTER_CRITICAL(&mux_);
+        ++profile_.acquires;
+        ++profile_.waitHistogram[bucketOf(waitUs)];
+        if (waitUs > profile_.waitUsMax)
+        {
+          profile_.waitUsMax = waitUs;
+        }
+        portEXIT_CRITICAL(&mux_);
+      }
+
+      void lockReleasing(SemaphoreHandle_t handle)
+      {
+        if (xSemaphoreGetMutexHolder(handle) != xTaskGetCurrentTaskHandle())
+        {
+          return; // en: not the owner, unlock() will fail / ja: 所有者ではないので unlock() は失敗する
+        }
+        const uint32_t holdUs = static_cast<uint32_t>(esp_timer_get_time() - acquiredAtUs_);
+        const bool longest = holdUs > profile_.holdUsMax;
+        char taskName[configMAX_TASK_NAME_LEN] = {};
+        if (longest)
+        {
+          strncpy(taskName, pcTaskGetName(nullptr), sizeof(taskName) - 1);
+        }
+
+        portENTER_CRITICAL(&mux_);
+        ++profile_.holdHistogram[bucketOf(holdUs)];
+        profile_.holdUsTotal += holdUs;
+        if (longest)
+        {
+          profile_.holdUsMax = holdUs;
+          memcpy(profile_.longestHolder, taskName, sizeof(taskName));
+        }
+        portEXIT_CRITICAL(&mux_);
+      }
+
+    private:
+      static size_t bucketOf(uint32_t us)
+      {
+        if (us == 0)
+        {
+          return 0;
+        }
+        const size_t bits = 32 - __builtin_clz(us);
+        return bits < kProfileBuckets ? bits : kProfileBuckets - 1;
+      }
+
+      static void printHistogram(Print &out, const char *name, const char *label, const uint32_t (&histogram)[kProfileBuckets])
+      {
+        out.printf("[%s] %s us:", name, label);
+        for (size_t i = 0; i < kProfileBuckets; ++i)
+        {
+          if (histogram[i] != 0)
+          {
+            out.printf(" %s%lu=%lu",
+                       (i == kProfileBuckets - 1) ? ">=" : "",
+                       static_cast<unsigned long>(MutexProfile::bucketFloorUs(i)),
+                       static_cast<unsigned long>(histogram[i]));
+          }
+        }
+        out.printf("\n");
+      }
+
+      mutable portMUX_TYPE mux_ = portMUX_INITIALIZER_UNLOCKED;
+      int64_t acquiredAtUs_ = 0; // en: written only by the current owner / ja: 現在の所有者だけが書く
+      MutexProfile profile_;
+    };
+  } // namespace detail
+
+} // namespace ESP32SyncKit
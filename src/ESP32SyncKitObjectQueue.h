@@ -0,0 +1,318 @@
+#pragma once
+
+#include "ESP32SyncKit.h"
+
+#include <new>
+
+namespace ESP32SyncKit
+{
+
+  // en: Queue for move-only / non-trivially-copyable T. Objects live in placement-new slots;
+  // en: only slot indices go through FreeRTOS queues, so the payload is moved, never memcpy'd.
+  // ja: ムーブ専用/非トリビアルな T 向けのキュー。オブジェクトは placement-new のスロットに置き、
+  // ja: FreeRTOS キューにはスロット番号だけを流すため、中身は memcpy ではなくムーブされる
+  // en: From an ISR only a trivially destructible T is accepted; otherwise send/receive log a warning and fail
+  // ja: ISR から扱えるのはトリビアル破棄可能な T だけ。それ以外では送受信が警告を出して失敗する
+  template <class T, class LogPolicy = LogAll>
+  class ObjectQueue : protected detail::Diagnostics<LogPolicy>
+  {
+  public:
+    explicit ObjectQueue(uint32_t depth)
+        : free_(nullptr), used_(nullptr), slots_(nullptr)
+    {
+      if (depth == 0 || depth > 0xffff)
+      {
+        this->logError("[ObjectQueue] create failed: depth must be 1..65535");
+        return;
+      }
+      slots_ = new (std::nothrow) Slot[depth];
+      free_ = xQueueCreate(depth, sizeof(uint16_t));
+      used_ = xQueueCreate(depth, sizeof(uint16_t));
+      if (!slots_ || !free_ || !used_)
+      {
+        this->logError("[ObjectQueue] create failed: out of memory");
+        release();
+        return;
+      }
+      for (uint32_t i = 0; i < depth; ++i)
+      {
+        uint16_t index = static_cast<uint16_t>(i);
+        (void)xQueueSend(free_, &index, 0);
+      }
+    }
+
+    ~ObjectQueue()
+    {
+      release();
+    }
+
+    ObjectQueue(const ObjectQueue &) = delete;
+    ObjectQueue &operator=(const ObjectQueue &) = delete;
+
+    ObjectQueue(ObjectQueue &&other) noexcept
+        : free_(other.free_), used_(other.used_), slots_(other.slots_)
+    {
+      other.free_ = nullptr;
+      other.used_ = nullptr;
+      other.slots_ = nullptr;
+    }
+    ObjectQueue &operator=(ObjectQueue &&other) noexcept
+    {
+      if (this != &other)
+      {
+        release();
+        free_ = other.free_;
+        used_ = other.used_;
+        slots_ = other.slots_;
+        other.free_ = nullptr;
+        other.used_ = nullptr;
+        other.slots_ = nullptr;
+      }
+      return *this;
+    }
+
+    bool trySend(T &&value) { return send(std::move(value), 0); }
+    bool send(T &&value, const Deadline &deadline) { return detail::untilDeadline(deadline, [&](uint32_t ms) { return send(std::move(value), ms); }); }
+
+    bool send(T &&value, uint32_t timeoutMs = WaitForever)
+    {
+      return put(timeoutMs, false, std::move(value));
+    }
+
+    bool trySend(const T &value) { return send(value, 0); }
+    bool send(const T &value, const Deadline &deadline) { return detail::untilDeadline(deadline, [&](uint32_t ms) { return send(value, ms); }); }
+
+    bool send(const T &value, uint32_t timeoutMs = WaitForever)
+    {
+      return put(timeoutMs, false, value);
+    }
+
+    // en: Construct T in place from args (blocks until a slot is free)
+    // ja: 引数から T をスロット内で直接構築（空きスロットができるまでブロック）
+    template <class... Args>
+    bool emplace(Args &&...args)
+    {
+      return put(WaitForever, true, std::forward<Args>(args)...);
+    }
+
+    template <class... Args>
+    bool tryEmplace(Args &&...args)
+    {
+      return put(0, true, std::forward<Args>(args)...);
+    }
+
+    bool tryReceive(T &out) { return receive(out, 0); }
+    bool receive(T &out, const Deadline &deadline) { return detail::untilDeadline(deadline, [&](uint32_t ms) { return receive(out, ms); }); }
+
+    // en: Move-assigns the oldest object into out and destroys the slot copy
+    // ja: 最も古いオブジェクトを out へムーブ代入し、スロット側を破棄する
+    bool receive(T &out, uint32_t timeoutMs = WaitForever)
+    {
+      if (!used_)
+      {
+        this->logError("[ObjectQueue] receive failed: handle null");
+        return false;
+      }
+
+      const bool inIsr = xPortInIsrContext();
+      TickType_t ticks = (inIsr || timeoutMs == 0) ? 0 : (timeoutMs == WaitForever ? portMAX_DELAY : pdMS_TO_TICKS(timeoutMs));
+      const bool nonBlocking = (ticks == 0);
+      uint16_t index = 0;
+
+      if (inIsr)
+      {
+        if constexpr (!kIsrSafe)
+        {
+          this->logWarn("[ObjectQueue] receive not allowed in ISR: T is not trivially destructible");
+          return false;
+        }
+        BaseType_t taskWoken = pdFALSE;
+        if (xQueueReceiveFromISR(used_, &index, &taskWoken) != pdPASS)
+        {
+          return false;
+        }
+        T *obj = slots_[index].get();
+        out = std::move(*obj);
+        obj->~T();
+        (void)xQueueSendFromISR(free_, &index, &taskWoken);
+        if (taskWoken == pdTRUE)
+        {
+          portYIELD_FROM_ISR();
+        }
+        return true;
+      }
+      else
+      {
+        if (xQueueReceive(used_, &index, ticks) != pdPASS)
+        {
+          if (!nonBlocking)
+          {
+            this->logTimeout("[ObjectQueue] receive timeout");
+          }
+          return false;
+        }
+        T *obj = slots_[index].get();
+        out = std::move(*obj);
+        obj->~T();
+        (void)xQueueSend(free_, &index, 0);
+        return true;
+      }
+    }
+
+    uint32_t count() const
+    {
+      if (!used_)
+      {
+        this->logError("[ObjectQueue] count failed: handle null");
+        return 0;
+      }
+      return xPortInIsrContext() ? uxQueueMessagesWaitingFromISR(used_) : uxQueueMessagesWaiting(used_);
+    }
+
+    // en: Destroy all queued objects (task only)
+    // ja: キュー内のオブジェクトをすべて破棄（タスクのみ）
+    bool clear()
+    {
+      if (!used_)
+      {
+        this->logError("[ObjectQueue] clear failed: handle null");
+        return false;
+      }
+      if (xPortInIsrContext())
+      {
+        this->logWarn("[ObjectQueue] clear not allowed in ISR");
+        return false;
+      }
+      uint16_t index = 0;
+      while (xQueueReceive(used_, &index, 0) == pdPASS)
+      {
+        slots_[index].get()->~T();
+        (void)xQueueSend(free_, &index, 0);
+      }
+      return true;
+    }
+
+  private:
+    // en: A non-trivial destructor (std::string, std::function, ...) may free to the heap, which an ISR must not do
+    // ja: 非トリビアルなデストラクタ（std::string、std::function など）はヒープを解放しうるため ISR では使えない
+    static constexpr bool kIsrSafe = std::is_trivially_destructible<T>::value;
+
+    struct Slot
+    {
+      alignas(T) unsigned char bytes[sizeof(T)];
+      T *get() { return std::launder(reinterpret_cast<T *>(bytes)); }
+    };
+
+    // en: Hands a taken index back to free_ unless dismissed, so a throwing T constructor does not leak the slot
+    // ja: 取り出した番号を dismiss されない限り free_ に戻す。T のコンストラクタが例外を投げてもスロットを失わない
+    struct FreeIndexReturn
+    {
+      QueueHandle_t free;
+      uint16_t index;
+      bool inIsr;
+      bool armed = true;
+
+      ~FreeIndexReturn()
+      {
+        if (!armed)
+        {
+          return;
+        }
+        if (inIsr)
+        {
+          BaseType_t taskWoken = pdFALSE;
+          (void)xQueueSendFromISR(free, &index, &taskWoken);
+        }
+        else
+        {
+          (void)xQueueSend(free, &index, 0);
+        }
+      }
+    };
+
+    template <class... Args>
+    bool put(uint32_t timeoutMs, bool emplacing, Args &&...args)
+    {
+      if (!free_)
+      {
+        this->logError(emplacing ? "[ObjectQueue] emplace failed: handle null" : "[ObjectQueue] send failed: handle null");
+        return false;
+      }
+
+      const bool inIsr = xPortInIsrContext();
+      TickType_t ticks = (inIsr || timeoutMs == 0) ? 0 : (timeoutMs == WaitForever ? portMAX_DELAY : pdMS_TO_TICKS(timeoutMs));
+      const bool nonBlocking = (ticks == 0);
+      uint16_t index = 0;
+
+      if (inIsr)
+      {
+        if constexpr (!kIsrSafe)
+        {
+          this->logWarn(emplacing ? "[ObjectQueue] emplace not allowed in ISR: T is not trivially destructible"
+                                  : "[ObjectQueue] send not allowed in ISR: T is not trivially destructible");
+          return false;
+        }
+        BaseType_t taskWoken = pdFALSE;
+        if (xQueueReceiveFromISR(free_, &index, &taskWoken) != pdPASS)
+        {
+          this->logWarn(emplacing ? "[ObjectQueue] emplace ISR failed: full" : "[ObjectQueue] send ISR failed: full");
+          return false;
+        }
+        FreeIndexReturn taken{free_, index, true};
+        ::new (static_cast<void *>(slots_[index].bytes)) T(std::forward<Args>(args)...);
+        taken.armed = false;
+        (void)xQueueSendFromISR(used_, &index, &taskWoken);
+        if (taskWoken == pdTRUE)
+        {
+          portYIELD_FROM_ISR();
+        }
+        return true;
+      }
+      else
+      {
+        if (xQueueReceive(free_, &index, ticks) != pdPASS)
+        {
+          if (!nonBlocking)
+          {
+            this->logTimeout(emplacing ? "[ObjectQueue] emplace timeout/full" : "[ObjectQueue] send timeout/full");
+          }
+          return false;
+        }
+        FreeIndexReturn taken{free_, index, false};
+        ::new (static_cast<void *>(slots_[index].bytes)) T(std::forward<Args>(args)...);
+        taken.armed = false;
+        (void)xQueueSend(used_, &index, 0);
+        return true;
+      }
+    }
+
+    void release()
+    {
+      if (used_ && free_ && slots_)
+      {
+        uint16_t index = 0;
+        while (xQueueReceive(used_, &index, 0) == pdPASS)
+        {
+          slots_[index].get()->~T();
+        }
+      }
+      if (used_)
+      {
+        vQueueDelete(used_);
+        used_ = nullptr;
+      }
+      if (free_)
+      {
+        vQueueDelete(free_);
+        free_ = nullptr;
+      }
+      delete[] slots_;
+      slots_ = nullptr;
+    }
+
+    QueueHandle_t free_; // en: indices of empty slots / ja: 空きスロット番号
+    QueueHandle_t used_; // en: indices of filled slots in FIFO order / ja: 使用中スロット番号（FIFO 順）
+    Slot *slots_;
+  };
+
+} // namespace ESP32SyncKit
@@ -0,0 +1,258 @@
+#pragma once
+
+#include "ESP32SyncKit.h"
+
+#include <functional>
+#include <type_traits>
+
+namespace ESP32SyncKit
+{
+
+  // en: Bounded priority queue: a binary heap in static storage, so send/receive cost O(log N) regardless
+  // en: of how many priority levels there are. The highest item by Compare comes out first (std::less
+  // en: gives the largest, like std::priority_queue); equal priorities keep FIFO order.
+  // en: Any task or ISR on either core may send or receive; tasks block like Queue<T>.
+  // ja: 有界の優先度キュー: 静的領域上の二分ヒープ。優先度の段数に関係なく送受信は O(log N)。
+  // ja: Compare で最も高い要素から出てくる（std::less なら最大値。std::priority_queue と同じ）。同じ優先度は FIFO 順。
+  // ja: 両コアの任意のタスク・ISR から送受信でき、タスクは Queue<T> と同様にブロックする
+  template <class T, size_t N, class Compare = std::less<T>, class StatsPolicy = NoStats, class LogPolicy = LogAll>
+  class PriorityQueue : public detail::StatsRecorder<StatsPolicy>, protected detail::Diagnostics<LogPolicy>
+  {
+    static_assert(!std::is_same<StatsPolicy, WithProfile>::value, "PriorityQueue: WithProfile is Mutex-only, use WithStats");
+    static_assert(N >= 1, "PriorityQueue: N must be >= 1");
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "PriorityQueue: T must be trivially copyable; items are copied inside a critical section");
+
+  public:
+    // en: Semaphores are created in the constructor from static buffers inside the object (no heap, cannot fail)
+    // ja: セマフォはオブジェクト内の静的バッファからコンストラクタで生成する（ヒープ不使用、失敗しない）
+    explicit PriorityQueue(const Compare &compare = Compare())
+        : compare_(compare),
+          items_(xSemaphoreCreateCountingStatic(N, 0, &itemsBuffer_)),
+          spaces_(xSemaphoreCreateCountingStatic(N, N, &spacesBuffer_))
+    {
+    }
+
+    ~PriorityQueue()
+    {
+      vSemaphoreDelete(items_);
+      vSemaphoreDelete(spaces_);
+    }
+
+    // en: Heap and semaphore storage live in the object, so it cannot be copied or moved
+    // ja: ヒープとセマフォの領域はオブジェクト内にあるため、コピー・ムーブ不可
+    PriorityQueue(const PriorityQueue &) = delete;
+    PriorityQueue &operator=(const PriorityQueue &) = delete;
+    PriorityQueue(PriorityQueue &&) = delete;
+    PriorityQueue &operator=(PriorityQueue &&) = delete;
+
+    bool trySend(const T &value) { return send(value, 0); }
+    bool send(const T &value, const Deadline &deadline) { return detail::untilDeadline(deadline, [&](uint32_t ms) { return send(value, ms); }); }
+
+    bool send(const T &value, uint32_t timeoutMs = WaitForever)
+    {
+      const bool inIsr = xPortInIsrContext();
+      TickType_t ticks = (inIsr || timeoutMs == 0) ? 0 : (timeoutMs == WaitForever ? portMAX_DELAY : pdMS_TO_TICKS(timeoutMs));
+      const bool nonBlocking = (ticks == 0);
+
+      // en: A slot is reserved before touching the heap, so push() always fits
+      // ja: ヒープに触れる前に空きを確保するので、push() は必ず収まる
+      if (inIsr)
+      {
+        if (xSemaphoreTakeFromISR(spaces_, nullptr) != pdPASS)
+        {
+          this->countFailure(false);
+          this->logWarn("[PriorityQueue] send ISR failed: full");
+          return false;
+        }
+      }
+      else
+      {
+        const int64_t blockStart = this->blockBegin(ticks);
+        BaseType_t rc = xSemaphoreTake(spaces_, ticks);
+        this->blockEnd(blockStart);
+        if (rc != pdPASS)
+        {
+          this->countFailure(!nonBlocking);
+          if (!nonBlocking)
+          {
+            this->logTimeout("[PriorityQueue] send timeout/full");
+          }
+          return false;
+        }
+      }
+
+      portENTER_CRITICAL_SAFE(&mux_);
+      push(value);
+      const uint32_t size = size_;
+      portEXIT_CRITICAL_SAFE(&mux_);
+
+      give(items_, inIsr);
+      this->countSend();
+      this->observeCount(size);
+      return true;
+    }
+
+    bool tryReceive(T &out) { return receive(out, 0); }
+    bool receive(T &out, const Deadline &deadline) { return detail::untilDeadline(deadline, [&](uint32_t ms) { return receive(out, ms); }); }
+
+    // en: Receives the highest-priority item. Consumers sleep on one counting semaphore, so each send wakes
+    // en: exactly one waiting receiver, and only after its item is already in the heap.
+    // ja: 最も優先度の高い要素を受信する。消費者は1つのカウンティングセマフォで眠るため、送信1回で
+    // ja: 待機中の受信者がちょうど1つ、その要素がヒープに入った後で起こされる
+    bool receive(T &out, uint32_t timeoutMs = WaitForever)
+    {
+      const bool inIsr = xPortInIsrContext();
+      TickType_t ticks = (inIsr || timeoutMs == 0) ? 0 : (timeoutMs == WaitForever ? portMAX_DELAY : pdMS_TO_TICKS(timeoutMs));
+      const bool nonBlocking = (ticks == 0);
+
+      if (inIsr)
+      {
+        if (xSemaphoreTakeFromISR(items_, nullptr) != pdPASS)
+        {
+          this->countFailure(false);
+          return false;
+        }
+      }
+      else
+      {
+        const int64_t blockStart = this->blockBegin(ticks);
+        BaseType_t rc = xSemaphoreTake(items_, ticks);
+        this->blockEnd(blockStart);
+        if (rc != pdPASS)
+        {
+          this->countFailure(!nonBlocking);
+          if (!nonBlocking)
+          {
+            this->logTimeout("[PriorityQueue] receive timeout");
+          }
+          return false;
+        }
+      }
+
+      portENTER_CRITICAL_SAFE(&mux_);
+      pop(out);
+      portEXIT_CRITICAL_SAFE(&mux_);
+
+      give(spaces_, inIsr);
+      this->countReceive();
+      return true;
+    }
+
+    // en: Items in the heap (snapshot; ISR-safe)
+    // ja: ヒープ内の件数（スナップショット。ISR 可）
+    uint32_t count() const
+    {
+      portENTER_CRITICAL_SAFE(&mux_);
+      const uint32_t size = size_;
+      portEXIT_CRITICAL_SAFE(&mux_);
+      return size;
+    }
+
+    static constexpr uint32_t capacity() { return N; }
+
+  private:
+    // en: seq is the send order; it breaks ties between equal priorities so they leave FIFO
+    // ja: seq は送信順。同じ優先度の要素を FIFO で取り出すための比較に使う
+    struct Entry
+    {
+      T value;
+      uint32_t seq;
+    };
+
+    // en: True when a leaves before b. The seq difference is wrap-safe while fewer than 2^31 items are in flight.
+    // ja: a が b より先に出るなら true。滞留が 2^31 件未満なら seq の差はラップしても正しい
+    bool before(const Entry &a, const Entry &b) const
+    {
+      if (compare_(b.value, a.value))
+      {
+        return true;
+      }
+      if (compare_(a.value, b.value))
+      {
+        return false;
+      }
+      return static_cast<int32_t>(a.seq - b.seq) < 0;
+    }
+
+    // en: Called inside mux_ with a reserved slot
+    // ja: mux_ 内で、空きを確保済みの状態で呼ぶ
+    void push(const T &value)
+    {
+      const Entry moving{value, nextSeq_++};
+      uint32_t i = size_++;
+      while (i > 0)
+      {
+        const uint32_t parent = (i - 1) / 2;
+        if (!before(moving, heap_[parent]))
+        {
+          break;
+        }
+        heap_[i] = heap_[parent];
+        i = parent;
+      }
+      heap_[i] = moving;
+    }
+
+    // en: Called inside mux_ with a reserved item
+    // ja: mux_ 内で、要素を確保済みの状態で呼ぶ
+    void pop(T &out)
+    {
+      out = heap_[0].value;
+      if (--size_ == 0)
+      {
+        return;
+      }
+      const Entry moving = heap_[size_];
+      uint32_t i = 0;
+      while (true)
+      {
+        uint32_t child = 2 * i + 1;
+        if (child >= size_)
+        {
+          break;
+        }
+        if (child + 1 < size_ && before(heap_[child + 1], heap_[child]))
+        {
+          ++child;
+        }
+        if (!before(heap_[child], moving))
+        {
+          break;
+        }
+        heap_[i] = heap_[child];
+        i = child;
+      }
+      heap_[i] = moving;
+    }
+
+    static void give(SemaphoreHandle_t sem, bool inIsr)
+    {
+      if (inIsr)
+      {
+        BaseType_t taskWoken = pdFALSE;
+        (void)xSemaphoreGiveFromISR(sem, &taskWoken);
+        if (taskWoken == pdTRUE)
+        {
+          portYIELD_FROM_ISR();
+        }
+      }
+      else
+      {
+        (void)xSemaphoreGive(sem);
+      }
+    }
+
+    Compare compare_;
+    mutable portMUX_TYPE mux_ = portMUX_INITIALIZER_UNLOCKED;
+    uint32_t size_ = 0;
+    uint32_t nextSeq_ = 0;
+    Entry heap_[N];
+
+    StaticSemaphore_t itemsBuffer_;
+    StaticSemaphore_t spacesBuffer_;
+    SemaphoreHandle_t items_;
+    SemaphoreHandle_t spaces_;
+  };
+
+} // namespace ESP32SyncKit
@@ -0,0 +1,246 @@
+#pragma once
+
+#include "ESP32SyncKit.h"
+
+#include <new>
+
+namespace ESP32SyncKit
+{
+
+  // en: Inline storage for one Select handler (e.g. a lambda capturing a few references)
+  // ja: Select のハンドラ1個分のインライン領域（参照を数個キャプチャするラムダ程度）
+  inline constexpr size_t kSelectHandlerBytes = 4 * sizeof(void *);
+
+  // en: Block once on several Queue / BinarySemaphore objects (FreeRTOS queue set) and run the
+  // en: handler of whichever became ready. Task only. Members must outlive the Select.
+  // ja: 複数の Queue / BinarySemaphore を1回のブロックで待ち（FreeRTOS キューセット）、
+  // ja: 準備できたものに対応するハンドラを実行する。タスク専用。メンバーは Select より長く生存すること
+  template <size_t MaxMembers, class LogPolicy = LogAll>
+  class Select : protected detail::Diagnostics<LogPolicy>
+  {
+    static_assert(MaxMembers > 0, "Select: MaxMembers must be > 0");
+
+  public:
+    Select() = default;
+
+    ~Select()
+    {
+      if (!set_)
+      {
+        return;
+      }
+      for (size_t i = 0; i < count_; ++i)
+      {
+        if (xQueueRemoveFromSet(members_[i].handle, set_) != pdPASS)
+        {
+          this->logError("[Select] destroyed while member %ld still has data", static_cast<long>(i));
+        }
+      }
+      vQueueDelete(set_);
+      set_ = nullptr;
+    }
+
+    // en: Members are registered with this set's address, so it cannot be copied or moved
+    // ja: メンバーはこのセットのアドレスで登録されるため、コピー・ムーブ不可
+    Select(const Select &) = delete;
+    Select &operator=(const Select &) = delete;
+    Select(Select &&) = delete;
+    Select &operator=(Select &&) = delete;
+
+    // en: Register a queue; handler(const T&) runs for each received item
+    // ja: キューを登録。受信した各要素について handler(const T&) を実行する
+    template <class T, class QueueStats, class QueueLog, class QueueBatch, class F>
+    bool add(Queue<T, QueueStats, QueueLog, QueueBatch> &queue, F handler)
+    {
+      QueueHandle_t handle = detail::HandleAccess::get(queue);
+      if (!handle)
+      {
+        this->logError("[Select] add failed: handle null");
+        return false;
+      }
+      const UBaseType_t length = uxQueueSpacesAvailable(handle) + uxQueueMessagesWaiting(handle);
+      return addMember<F>(handle, length, &queue, &invokeQueue<T, QueueStats, QueueLog, QueueBatch, F>, handler);
+    }
+
+    // en: Register a binary semaphore; handler() runs after each successful take
+    // ja: バイナリセマフォを登録。take 成功ごとに handler() を実行する
+    template <class SemaphoreStats, class SemaphoreLog, class F>
+    bool add(BasicBinarySemaphore<SemaphoreStats, SemaphoreLog> &semaphore, F handler)
+    {
+      SemaphoreHandle_t handle = detail::HandleAccess::get(semaphore);
+      if (!handle)
+      {
+        this->logError("[Select] add failed: handle null");
+        return false;
+      }
+      return addMember<F>(handle, 1, &semaphore, &invokeSemaphore<SemaphoreStats, SemaphoreLog, F>, handler);
+    }
+
+    // en: Create the queue set and attach every member. Members must be empty at this point.
+    // en: Called automatically by the first dispatch(); call it earlier if producers may start first.
+    // ja: キューセットを生成して全メンバーを登録する。この時点でメンバーは空でなければならない。
+    // ja: 最初の dispatch() で自動的に呼ばれる。生産者が先に動く場合は事前に呼ぶこと
+    bool begin()
+    {
+      if (set_)
+      {
+        return true;
+      }
+      if (count_ == 0)
+      {
+        this->logError("[Select] begin failed: no members");
+        return false;
+      }
+
+      UBaseType_t total = 0;
+      for (size_t i = 0; i < count_; ++i)
+      {
+        total += members_[i].length;
+      }
+      set_ = xQueueCreateSet(total);
+      if (!set_)
+      {
+        this->logError("[Select] begin failed: xQueueCreateSet");
+        return false;
+      }
+
+      for (size_t i = 0; i < count_; ++i)
+      {
+        if (xQueueAddToSet(members_[i].handle, set_) != pdPASS)
+        {
+          this->logError("[Select] begin failed: member %ld is not empty or already in a set", static_cast<long>(i));
+          while (i-- > 0)
+          {
+            (void)xQueueRemoveFromSet(members_[i].handle, set_);
+          }
+          vQueueDelete(set_);
+          set_ = nullptr;
+          return false;
+        }
+      }
+      return true;
+    }
+
+    // en: Wait until any member is ready, run its handler once and return its index (registration order).
+    // en: Returns -1 on timeout or error.
+    // ja: いずれかのメンバーが準備できるまで待ち、そのハンドラを1回実行して番号（登録順）を返す。
+    // ja: タイムアウトまたはエラー時は -1
+    int dispatch(uint32_t timeoutMs = WaitForever)
+    {
+      if (xPortInIsrContext())
+      {
+        this->logError("[Select] dispatch called in ISR");
+        return -1;
+      }
+      if (!begin())
+      {
+        return -1;
+      }
+
+      TickType_t ticks = (timeoutMs == 0) ? 0 : (timeoutMs == WaitForever ? portMAX_DELAY : pdMS_TO_TICKS(timeoutMs));
+      QueueSetMemberHandle_t ready = xQueueSelectFromSet(set_, ticks);
+      if (!ready)
+      {
+        return -1;
+      }
+
+      for (size_t i = 0; i < count_; ++i)
+      {
+        Member &member = members_[i];
+        if (member.handle != ready)
+        {
+          continue;
+        }
+        if (!member.invoke(member.source, member.handler))
+        {
+          this->logError("[Select] member %ld was consumed outside the set", static_cast<long>(i));
+          return -1;
+        }
+        return static_cast<int>(i);
+      }
+      this->logError("[Select] unknown member selected");
+      return -1;
+    }
+
+    int tryDispatch() { return dispatch(0); }
+    int dispatch(const Deadline &deadline) { return detail::untilDeadline(deadline, [&](uint32_t ms) { return dispatch(ms); }); }
+
+    size_t size() const { return count_; }
+    static constexpr size_t capacity() { return MaxMembers; }
+
+  private:
+    struct Member
+    {
+      QueueSetMemberHandle_t handle;
+      UBaseType_t length;
+      void *source;
+      bool (*invoke)(void *source, void *handler);
+      alignas(void *) unsigned char handler[kSelectHandlerBytes];
+    };
+
+    template <class F>
+    bool addMember(QueueSetMemberHandle_t handle, UBaseType_t length, void *source, bool (*invoke)(void *, void *), F &handler)
+    {
+      static_assert(sizeof(F) <= kSelectHandlerBytes, "Select: handler too large (capture fewer values or use a pointer)");
+      static_assert(alignof(F) <= alignof(void *), "Select: handler over-aligned");
+      static_assert(std::is_trivially_copyable<F>::value && std::is_trivially_destructible<F>::value,
+                    "Select: handler must be trivially copyable (capture by reference or pointer)");
+
+      if (set_)
+      {
+        this->logError("[Select] add failed: already started");
+        return false;
+      }
+      if (count_ >= MaxMembers)
+      {
+        this->logError("[Select] add failed: full (MaxMembers=%ld)", static_cast<long>(MaxMembers));
+        return false;
+      }
+      for (size_t i = 0; i < count_; ++i)
+      {
+        if (members_[i].handle == handle)
+        {
+          this->logError("[Select] add failed: already registered");
+          return false;
+        }
+      }
+
+      Member &member = members_[count_];
+      member.handle = handle;
+      member.length = length;
+      member.source = source;
+      member.invoke = invoke;
+      ::new (static_cast<void *>(member.handler)) F(handler);
+      ++count_;
+      return true;
+    }
+
+    template <class T, class QueueStats, class QueueLog, class QueueBatch, class F>
+    static bool invokeQueue(void *source, void *handler)
+    {
+      T value;
+      if (!static_cast<Queue<T, QueueStats, QueueLog, QueueBatch> *>(source)->tryReceive(value))
+      {
+        return false;
+      }
+      (*std::launder(reinterpret_cast<F *>(handler)))(static_cast<const T &>(value));
+      return true;
+    }
+
+    template <class SemaphoreStats, class SemaphoreLog, class F>
+    static bool invokeSemaphore(void *source, void *handler)
+    {
+      if (!static_cast<BasicBinarySemaphore<SemaphoreStats, SemaphoreLog> *>(source)->tryTake())
+      {
+        return false;
+      }
+      (*std::launder(reinterpret_cast<F *>(handler)))();
+      return true;
+    }
+
+    QueueSetHandle_t set_ = nullptr;
+    size_t count_ = 0;
+    Member members_[MaxMembers];
+  };
+
+} // namespace ESP32SyncKit
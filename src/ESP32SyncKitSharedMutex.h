@@ -0,0 +1,398 @@
+#pragma once
+
+#include "ESP32SyncKit.h"
+
+namespace ESP32SyncKit
+{
+
+  // en: SharedMutex fairness: a waiting writer stops new readers (default), or readers keep entering while any reader holds it
+  // ja: SharedMutex の公平性: 待機中の書き手が新しい読み手を止める（既定）、または読み手がいる間は読み手が入り続ける
+  struct PreferWriters
+  {
+  };
+  struct PreferReaders
+  {
+  };
+
+  // en: Reader-writer lock: any number of tasks hold it shared at once, or one task holds it exclusively.
+  // en: Writers serialize on an internal priority-inheritance mutex, which readers also pass through
+  // en: while a writer is pending, so a low-priority writer is boosted by the tasks it blocks. Task only.
+  // ja: 読み書きロック: 任意個のタスクが共有で同時に保持するか、1つのタスクが排他で保持する。
+  // ja: 書き手は内部の優先度継承ミューテックスで直列化され、書き手の保留中は読み手もそこを通るため、
+  // ja: 低優先度の書き手はブロックしたタスクによって昇格される。タスク専用
+  template <class StatsPolicy = NoStats, class LogPolicy = LogAll, class Preference = PreferWriters>
+  class BasicSharedMutex : public detail::StatsRecorder<StatsPolicy>, protected detail::Diagnostics<LogPolicy>
+  {
+    static_assert(!std::is_same<StatsPolicy, WithProfile>::value, "SharedMutex: WithProfile is Mutex-only, use WithStats");
+    static_assert(std::is_same<Preference, PreferWriters>::value || std::is_same<Preference, PreferReaders>::value,
+                  "SharedMutex: Preference must be PreferWriters or PreferReaders");
+
+  public:
+    BasicSharedMutex()
+        : gate_(xSemaphoreCreateMutexStatic(&gateBuffer_)),
+          drained_(xSemaphoreCreateBinaryStatic(&drainedBuffer_))
+    {
+    }
+
+    ~BasicSharedMutex()
+    {
+      if (readers_ != 0 || writerActive_)
+      {
+        this->logError("[SharedMutex] destroyed while held");
+      }
+      vSemaphoreDelete(gate_);
+      vSemaphoreDelete(drained_);
+    }
+
+    // en: State and semaphore storage live in the object, so it cannot be copied or moved
+    // ja: 状態とセマフォの領域はオブジェクト内にあるため、コピー・ムーブ不可
+    BasicSharedMutex(const BasicSharedMutex &) = delete;
+    BasicSharedMutex &operator=(const BasicSharedMutex &) = delete;
+    BasicSharedMutex(BasicSharedMutex &&) = delete;
+    BasicSharedMutex &operator=(BasicSharedMutex &&) = delete;
+
+    // en: Shared (read) lock. Not recursive: with PreferWriters a nested lockShared() behind a waiting writer deadlocks.
+    // ja: 共有（読み）ロック。再帰不可: PreferWriters では待機中の書き手がいると入れ子の lockShared() はデッドロックする
+    bool lockShared(uint32_t timeoutMs = WaitForever)
+    {
+      if (xPortInIsrContext())
+      {
+        this->logError("[SharedMutex] lockShared called in ISR");
+        return false;
+      }
+
+      TickType_t ticks = (timeoutMs == 0) ? 0 : (timeoutMs == WaitForever ? portMAX_DELAY : pdMS_TO_TICKS(timeoutMs));
+      const bool infinite = (ticks == portMAX_DELAY);
+      const TickType_t start = xTaskGetTickCount();
+      TickType_t remaining = ticks;
+      const int64_t blockStart = this->blockBegin(ticks);
+
+      while (!enterShared())
+      {
+        // en: A writer owns the gate; queue behind it (boosting it), then retry
+        // ja: 書き手がゲートを保持している。その後ろに並び（昇格させ）、再試行する
+        if (remaining == 0 || xSemaphoreTake(gate_, remaining) != pdPASS)
+        {
+          this->blockEnd(blockStart);
+          this->countFailure(ticks != 0);
+          if (ticks != 0)
+          {
+            this->logTimeout("[SharedMutex] lockShared timeout");
+          }
+          return false;
+        }
+        (void)xSemaphoreGive(gate_);
+
+        if (!infinite)
+        {
+          TickType_t elapsed = xTaskGetTickCount() - start;
+          remaining = (elapsed >= ticks) ? 0 : ticks - elapsed;
+        }
+      }
+      this->blockEnd(blockStart);
+      this->countReceive();
+      return true;
+    }
+
+    bool tryLockShared() { return lockShared(0); }
+    bool lockShared(const Deadline &deadline) { return detail::untilDeadline(deadline, [&](uint32_t ms) { return lockShared(ms); }); }
+
+    bool unlockShared()
+    {
+      bool wakeWriter = false;
+      portENTER_CRITICAL(&mux_);
+      if (readers_ == 0)
+      {
+        portEXIT_CRITICAL(&mux_);
+        this->countFailure(false);
+        this->logWarn("[SharedMutex] unlockShared failed: not held shared");
+        return false;
+      }
+      --readers_;
+      if (readers_ == 0 && writerWaiting_)
+      {
+        writerWaiting_ = false;
+        wakeWriter = true;
+      }
+      portEXIT_CRITICAL(&mux_);
+
+      if (wakeWriter)
+      {
+        (void)xSemaphoreGive(drained_);
+      }
+      this->countSend();
+      return true;
+    }
+
+    // en: Exclusive (write) lock: take the gate (priority inheritance among writers and gated readers),
+    // en: then wait for the current readers to leave
+    // ja: 排他（書き）ロック: ゲートを取り（書き手同士とゲートで待つ読み手の間で優先度継承）、
+    // ja: 続いて現在の読み手が抜けるのを待つ
+    bool lock(uint32_t timeoutMs = WaitForever)
+    {
+      if (xPortInIsrContext())
+      {
+        this->logError("[SharedMutex] lock called in ISR");
+        return false;
+      }
+
+      TickType_t ticks = (timeoutMs == 0) ? 0 : (timeoutMs == WaitForever ? portMAX_DELAY : pdMS_TO_TICKS(timeoutMs));
+      const bool infinite = (ticks == portMAX_DELAY);
+      const TickType_t start = xTaskGetTickCount();
+      const int64_t blockStart = this->blockBegin(ticks);
+
+      if (xSemaphoreTake(gate_, ticks) != pdPASS)
+      {
+        this->blockEnd(blockStart);
+        this->countFailure(ticks != 0);
+        if (ticks != 0)
+        {
+          this->logTimeout("[SharedMutex] lock timeout (writer)");
+        }
+        return false;
+      }
+
+      portENTER_CRITICAL(&mux_);
+      writerPending_ = true;
+      portEXIT_CRITICAL(&mux_);
+
+      while (!enterExclusive())
+      {
+        TickType_t remaining = ticks;
+        if (!infinite)
+        {
+          TickType_t elapsed = xTaskGetTickCount() - start;
+          remaining = (elapsed >= ticks) ? 0 : ticks - elapsed;
+        }
+        // en: drained_ is only a hint (a stale give may be left over); enterExclusive() re-checks the count
+        // ja: drained_ はヒントにすぎない（古い give が残っている場合がある）。enterExclusive() で数を再確認する
+        if (remaining == 0 || xSemaphoreTake(drained_, remaining) != pdPASS)
+        {
+          if (enterExclusive())
+          {
+            break;
+          }
+          portENTER_CRITICAL(&mux_);
+          writerPending_ = false;
+          writerWaiting_ = false;
+          portEXIT_CRITICAL(&mux_);
+          (void)xSemaphoreGive(gate_);
+          this->blockEnd(blockStart);
+          this->countFailure(ticks != 0);
+          if (ticks != 0)
+          {
+            this->logTimeout("[SharedMutex] lock timeout (readers)");
+          }
+          return false;
+        }
+      }
+      this->blockEnd(blockStart);
+      this->countReceive();
+      return true;
+    }
+
+    bool tryLock() { return lock(0); }
+    bool lock(const Deadline &deadline) { return detail::untilDeadline(deadline, [&](uint32_t ms) { return lock(ms); }); }
+
+    // en: Owner only (the task that called lock())
+    // ja: 所有者のみ（lock() を呼んだタスク）
+    bool unlock()
+    {
+      if (xSemaphoreGetMutexHolder(gate_) != xTaskGetCurrentTaskHandle() || !writerActive_)
+      {
+        this->countFailure(false);
+        this->logWarn("[SharedMutex] unlock failed: not the exclusive owner");
+        return false;
+      }
+      portENTER_CRITICAL(&mux_);
+      writerActive_ = false;
+      writerPending_ = false;
+      portEXIT_CRITICAL(&mux_);
+      (void)xSemaphoreGive(gate_);
+      this->countSend();
+      return true;
+    }
+
+    // en: Current number of shared holders (snapshot)
+    // ja: 現在の共有保持者数（スナップショット）
+    uint32_t readers() const
+    {
+      portENTER_CRITICAL(&mux_);
+      const uint32_t n = readers_;
+      portEXIT_CRITICAL(&mux_);
+      return n;
+    }
+
+    // en: RAII shared lock; check locked() when a timeout is given
+    // ja: RAII の共有ロック。タイムアウトを指定した場合は locked() を確認する
+    class SharedLockGuard
+    {
+    public:
+      explicit SharedLockGuard(BasicSharedMutex &m, uint32_t timeoutMs = WaitForever)
+          : mutex_(&m), locked_(m.lockShared(timeoutMs))
+      {
+        if (!locked_)
+        {
+          m.logTimeout("[SharedMutex] SharedLockGuard lock failed");
+        }
+      }
+
+      explicit SharedLockGuard(BasicSharedMutex &m, const Deadline &deadline)
+          : mutex_(&m), locked_(m.lockShared(deadline))
+      {
+        if (!locked_)
+        {
+          m.logTimeout("[SharedMutex] SharedLockGuard lock failed");
+        }
+      }
+
+      ~SharedLockGuard()
+      {
+        if (locked_ && mutex_)
+        {
+          mutex_->unlockShared();
+        }
+      }
+
+      SharedLockGuard(const SharedLockGuard &) = delete;
+      SharedLockGuard &operator=(const SharedLockGuard &) = delete;
+
+      SharedLockGuard(SharedLockGuard &&other) noexcept
+          : mutex_(other.mutex_), locked_(other.locked_)
+      {
+        other.mutex_ = nullptr;
+        other.locked_ = false;
+      }
+
+      SharedLockGuard &operator=(SharedLockGuard &&other) noexcept
+      {
+        if (this != &other)
+        {
+          if (locked_ && mutex_)
+          {
+            mutex_->unlockShared();
+          }
+          mutex_ = other.mutex_;
+          locked_ = other.locked_;
+          other.mutex_ = nullptr;
+          other.locked_ = false;
+        }
+        return *this;
+      }
+
+      bool locked() const { return locked_; }
+
+    private:
+      BasicSharedMutex *mutex_;
+      bool locked_;
+    };
+
+    // en: RAII exclusive lock (same shape as Mutex::LockGuard)
+    // ja: RAII の排他ロック（Mutex::LockGuard と同じ形）
+    class LockGuard
+    {
+    public:
+      explicit LockGuard(BasicSharedMutex &m, uint32_t timeoutMs = WaitForever)
+          : mutex_(&m), locked_(m.lock(timeoutMs))
+      {
+        if (!locked_)
+        {
+          m.logTimeout("[SharedMutex] LockGuard lock failed");
+        }
+      }
+
+      explicit LockGuard(BasicSharedMutex &m, const Deadline &deadline)
+          : mutex_(&m), locked_(m.lock(deadline))
+      {
+        if (!locked_)
+        {
+          m.logTimeout("[SharedMutex] LockGuard lock failed");
+        }
+      }
+
+      ~LockGuard()
+      {
+        if (locked_ && mutex_)
+        {
+          mutex_->unlock();
+        }
+      }
+
+      LockGuard(const LockGuard &) = delete;
+      LockGuard &operator=(const LockGuard &) = delete;
+
+      LockGuard(LockGuard &&other) noexcept
+          : mutex_(other.mutex_), locked_(other.locked_)
+      {
+        other.mutex_ = nullptr;
+        other.locked_ = false;
+      }
+
+      LockGuard &operator=(LockGuard &&other) noexcept
+      {
+        if (this != &other)
+        {
+          if (locked_ && mutex_)
+          {
+            mutex_->unlock();
+          }
+          mutex_ = other.mutex_;
+          locked_ = other.locked_;
+          other.mutex_ = nullptr;
+          other.locked_ = false;
+        }
+        return *this;
+      }
+
+      bool locked() const { return locked_; }
+
+    private:
+      BasicSharedMutex *mutex_;
+      bool locked_;
+    };
+
+  private:
+    bool enterShared()
+    {
+      portENTER_CRITICAL(&mux_);
+      const bool blocked = writerActive_ || (std::is_same<Preference, PreferWriters>::value && writerPending_);
+      if (!blocked)
+      {
+        ++readers_;
+      }
+      portEXIT_CRITICAL(&mux_);
+      return !blocked;
+    }
+
+    bool enterExclusive()
+    {
+      portENTER_CRITICAL(&mux_);
+      const bool drained = (readers_ == 0);
+      if (drained)
+      {
+        writerActive_ = true;
+        writerWaiting_ = false;
+      }
+      else
+      {
+        writerWaiting_ = true;
+      }
+      portEXIT_CRITICAL(&mux_);
+      return drained;
+    }
+
+    StaticSemaphore_t gateBuffer_;
+    StaticSemaphore_t drainedBuffer_;
+    SemaphoreHandle_t gate_;    // en: held by the writer from lock() to unlock() / ja: lock() から unlock() まで書き手が保持
+    SemaphoreHandle_t drained_; // en: last reader out wakes the waiting writer / ja: 最後の読み手が待機中の書き手を起こす
+
+    mutable portMUX_TYPE mux_ = portMUX_INITIALIZER_UNLOCKED;
+    uint32_t readers_ = 0;
+    bool writerPending_ = false; // en: a writer holds the gate / ja: 書き手がゲートを保持中
+    bool writerWaiting_ = false; // en: that writer sleeps on drained_ / ja: その書き手が drained_ で待機中
+    bool writerActive_ = false;  // en: that writer owns the lock / ja: その書き手がロックを所有
+  };
+
+  using SharedMutex = BasicSharedMutex<>;
+
+} // namespace ESP32SyncKit
@@ -0,0 +1,184 @@
+#pragma once
+
+#include "ESP32SyncKit.h"
+
+#include <atomic>
+#include <type_traits>
+
+namespace ESP32SyncKit
+{
+
+  // en: Lock-free single-producer/single-consumer ring. Blocks via task notification only when empty/full,
+  // en: on slot NotifyIndex of the waiting task (reserved: do not use it with Notify in either mode).
+  // ja: ロックフリーの単一生産者/単一消費者リング。空/満杯のときだけタスク通知でブロックする。
+  // ja: 使うのは待機タスクの NotifyIndex 番のスロット（専有: どちらのモードの Notify とも併用しない）
+  template <class T, size_t N, class LogPolicy = LogAll, UBaseType_t NotifyIndex = kSyncKitNotifyIndex>
+  class SpscQueue : protected detail::Diagnostics<LogPolicy>
+  {
+    static_assert(N > 0 && (N & (N - 1)) == 0, "SpscQueue: N must be a power of two");
+    static_assert(std::is_trivially_copyable<T>::value, "SpscQueue: T must be trivially copyable");
+
+  public:
+    SpscQueue() = default;
+
+    SpscQueue(const SpscQueue &) = delete;
+    SpscQueue &operator=(const SpscQueue &) = delete;
+    SpscQueue(SpscQueue &&) = delete;
+    SpscQueue &operator=(SpscQueue &&) = delete;
+
+    bool trySend(const T &value) { return send(value, 0); }
+    bool send(const T &value, const Deadline &deadline) { return detail::untilDeadline(deadline, [&](uint32_t ms) { return send(value, ms); }); }
+
+    bool send(const T &value, uint32_t timeoutMs = WaitForever)
+    {
+      const bool inIsr = xPortInIsrContext();
+      TickType_t ticks = (inIsr || timeoutMs == 0) ? 0 : (timeoutMs == WaitForever ? portMAX_DELAY : pdMS_TO_TICKS(timeoutMs));
+
+      while (!push(value))
+      {
+        if (ticks == 0)
+        {
+          if (inIsr)
+          {
+            this->logWarn("[SpscQueue] send ISR failed: full");
+          }
+          return false;
+        }
+        if (!waitUntil(producerWaiter_, ticks, &SpscQueue::hasSpace))
+        {
+          this->logTimeout("[SpscQueue] send timeout/full");
+          return false;
+        }
+      }
+      Channel::wake(consumerWaiter_, inIsr);
+      return true;
+    }
+
+    bool tryReceive(T &out) { return receive(out, 0); }
+    bool receive(T &out, const Deadline &deadline) { return detail::untilDeadline(deadline, [&](uint32_t ms) { return receive(out, ms); }); }
+
+    bool receive(T &out, uint32_t timeoutMs = WaitForever)
+    {
+      const bool inIsr = xPortInIsrContext();
+      TickType_t ticks = (inIsr || timeoutMs == 0) ? 0 : (timeoutMs == WaitForever ? portMAX_DELAY : pdMS_TO_TICKS(timeoutMs));
+
+      while (!pop(out))
+      {
+        if (ticks == 0)
+        {
+          return false;
+        }
+        if (!waitUntil(consumerWaiter_, ticks, &SpscQueue::hasData))
+        {
+          this->logTimeout("[SpscQueue] receive timeout");
+          return false;
+        }
+      }
+      Channel::wake(producerWaiter_, inIsr);
+      return true;
+    }
+
+    uint32_t count() const
+    {
+      return tail_.load(std::memory_order_acquire) - head_.load(std::memory_order_acquire);
+    }
+
+    static constexpr uint32_t capacity() { return N; }
+
+  private:
+    using Channel = detail::NotifyChannel<NotifyIndex>;
+
+    static constexpr uint32_t kMask = N - 1;
+
+    bool push(const T &value)
+    {
+      const uint32_t tail = tail_.load(std::memory_order_relaxed);
+      if (tail - headCache_ >= N)
+      {
+        headCache_ = head_.load(std::memory_order_acquire);
+        if (tail - headCache_ >= N)
+        {
+          return false;
+        }
+      }
+      buffer_[tail & kMask] = value;
+      tail_.store(tail + 1, std::memory_order_release);
+      return true;
+    }
+
+    bool pop(T &out)
+    {
+      const uint32_t head = head_.load(std::memory_order_relaxed);
+      if (head == tailCache_)
+      {
+        tailCache_ = tail_.load(std::memory_order_acquire);
+        if (head == tailCache_)
+        {
+          return false;
+        }
+      }
+      out = buffer_[head & kMask];
+      head_.store(head + 1, std::memory_order_release);
+      return true;
+    }
+
+    bool hasSpace() const
+    {
+      return tail_.load(std::memory_order_relaxed) - head_.load(std::memory_order_acquire) < N;
+    }
+
+    bool hasData() const
+    {
+      return head_.load(std::memory_order_relaxed) != tail_.load(std::memory_order_acquire);
+    }
+
+    // en: Publish the waiter, re-check, then sleep on the task notification until ready or timeout
+    // ja: 待機者を登録して再確認し、準備完了かタイムアウトまでタスク通知で眠る
+    bool waitUntil(std::atomic<TaskHandle_t> &waiter, TickType_t ticks, bool (SpscQueue::*ready)() const)
+    {
+      const bool infinite = (ticks == portMAX_DELAY);
+      const TickType_t start = xTaskGetTickCount();
+      TickType_t remaining = ticks;
+
+      while (true)
+      {
+        waiter.store(xTaskGetCurrentTaskHandle(), std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if ((this->*ready)())
+        {
+          Channel::leave(waiter, 0);
+          return true;
+        }
+
+        Channel::leave(waiter, Channel::wait(remaining));
+        if ((this->*ready)())
+        {
+          return true;
+        }
+
+        if (!infinite)
+        {
+          TickType_t elapsed = xTaskGetTickCount() - start;
+          if (elapsed >= ticks)
+          {
+            return false;
+          }
+          remaining = ticks - elapsed;
+        }
+      }
+    }
+
+    // en: consumer-owned line / ja: 消費者側が書くライン
+    alignas(kCacheLineSize) std::atomic<uint32_t> head_{0};
+    uint32_t tailCache_ = 0;
+    std::atomic<TaskHandle_t> consumerWaiter_{nullptr};
+
+    // en: producer-owned line / ja: 生産者側が書くライン
+    alignas(kCacheLineSize) std::atomic<uint32_t> tail_{0};
+    uint32_t headCache_ = 0;
+    std::atomic<TaskHandle_t> producerWaiter_{nullptr};
+
+    alignas(kCacheLineSize) T buffer_[N];
+  };
+
+} // namespace ESP32SyncKit
@@ -0,0 +1,81 @@
+#pragma once
+
+#include "ESP32SyncKit.h"
+
+namespace ESP32SyncKit
+{
+
+  namespace detail
+  {
+    template <class T, uint32_t Depth>
+    struct StaticQueueStorage
+    {
+      StaticQueue_t queueBuffer_;
+      uint8_t itemStorage_[Depth * sizeof(T)];
+    };
+
+    struct StaticSemaphoreStorage
+    {
+      StaticSemaphore_t semaphoreBuffer_;
+    };
+  } // namespace detail
+
+  // en: Queue<T> with compile-time depth; control block and item storage live inside the object (no heap)
+  // ja: 深さをコンパイル時に決める Queue<T>。制御ブロックと格納領域をオブジェクト内に持つ（ヒープ不使用）
+  template <class T, uint32_t Depth, class StatsPolicy = NoStats, class LogPolicy = LogAll, class BatchPolicy = NoBatch>
+  class StaticQueue : private detail::StaticQueueStorage<T, Depth>, public Queue<T, StatsPolicy, LogPolicy, BatchPolicy>
+  {
+    static_assert(Depth > 0, "StaticQueue: Depth must be > 0");
+
+  public:
+    StaticQueue()
+        : Queue<T, StatsPolicy, LogPolicy, BatchPolicy>(
+              detail::AdoptHandle{}, xQueueCreateStatic(Depth, sizeof(T), this->itemStorage_, &this->queueBuffer_))
+    {
+    }
+
+    // en: The handle points into this object, so it cannot be moved (moving into a Queue is rejected as well)
+    // ja: ハンドルが自身の領域を指すためムーブ不可（Queue へのムーブも拒否される）
+    StaticQueue(StaticQueue &&) = delete;
+    StaticQueue &operator=(StaticQueue &&) = delete;
+
+    static constexpr uint32_t depth() { return Depth; }
+  };
+
+  // en: BinarySemaphore backed by xSemaphoreCreateBinaryStatic
+  // ja: xSemaphoreCreateBinaryStatic で生成する BinarySemaphore
+  template <class StatsPolicy = NoStats, class LogPolicy = LogAll>
+  class BasicStaticBinarySemaphore : private detail::StaticSemaphoreStorage,
+                                     public BasicBinarySemaphore<StatsPolicy, LogPolicy>
+  {
+  public:
+    BasicStaticBinarySemaphore()
+        : BasicBinarySemaphore<StatsPolicy, LogPolicy>(detail::AdoptHandle{},
+                                                       xSemaphoreCreateBinaryStatic(&this->semaphoreBuffer_))
+    {
+    }
+
+    BasicStaticBinarySemaphore(BasicStaticBinarySemaphore &&) = delete;
+    BasicStaticBinarySemaphore &operator=(BasicStaticBinarySemaphore &&) = delete;
+  };
+
+  using StaticBinarySemaphore = BasicStaticBinarySemaphore<>;
+
+  // en: Mutex backed by xSemaphoreCreateMutexStatic (priority inheritance, non-recursive)
+  // ja: xSemaphoreCreateMutexStatic で生成する Mutex（優先度継承・非再帰）
+  template <class StatsPolicy = NoStats, class LogPolicy = LogAll>
+  class BasicStaticMutex : private detail::StaticSemaphoreStorage, public BasicMutex<StatsPolicy, LogPolicy>
+  {
+  public:
+    BasicStaticMutex()
+        : BasicMutex<StatsPolicy, LogPolicy>(detail::AdoptHandle{}, xSemaphoreCreateMutexStatic(&this->semaphoreBuffer_))
+    {
+    }
+
+    BasicStaticMutex(BasicStaticMutex &&) = delete;
+    BasicStaticMutex &operator=(BasicStaticMutex &&) = delete;
+  };
+
+  using StaticMutex = BasicStaticMutex<>;
+
+} // namespace ESP32SyncKit
@@ -0,0 +1,552 @@
+#pragma once
+
+#include "ESP32SyncKit.h"
+
+#include <freertos/stream_buffer.h>
+#include <freertos/message_buffer.h>
+
+namespace ESP32SyncKit
+{
+
+  // en: Byte stream between one writer and one reader (FreeRTOS stream buffer). The reader wakes once
+  // en: triggerLevel bytes are available. Serialize access yourself if there are several writers or readers.
+  // ja: 1 書き手・1 読み手のバイトストリーム（FreeRTOS ストリームバッファ）。triggerLevel バイト溜まると
+  // ja: 読み手が起きる。書き手/読み手が複数なら呼び出し側で排他すること
+  template <class StatsPolicy = NoStats, class LogPolicy = LogAll>
+  class BasicStreamBuffer : public detail::StatsRecorder<StatsPolicy>, protected detail::Diagnostics<LogPolicy>
+  {
+    static_assert(!std::is_same<StatsPolicy, WithProfile>::value, "StreamBuffer: WithProfile is Mutex-only, use WithStats");
+
+  public:
+    explicit BasicStreamBuffer(size_t capacityBytes, size_t triggerLevel = 1)
+        : handle_(nullptr)
+    {
+      if (capacityBytes == 0 || triggerLevel == 0 || triggerLevel > capacityBytes)
+      {
+        this->logError("[StreamBuffer] create failed: need 1 <= triggerLevel <= capacity");
+        return;
+      }
+      handle_ = xStreamBufferCreate(capacityBytes, triggerLevel);
+      if (!handle_)
+      {
+        this->logError("[StreamBuffer] create failed: xStreamBufferCreate");
+      }
+    }
+
+    ~BasicStreamBuffer()
+    {
+      if (handle_)
+      {
+        vStreamBufferDelete(handle_);
+        handle_ = nullptr;
+      }
+    }
+
+    BasicStreamBuffer(const BasicStreamBuffer &) = delete;
+    BasicStreamBuffer &operator=(const BasicStreamBuffer &) = delete;
+
+    BasicStreamBuffer(BasicStreamBuffer &&other) noexcept : handle_(other.handle_)
+    {
+      other.handle_ = nullptr;
+    }
+    BasicStreamBuffer &operator=(BasicStreamBuffer &&other) noexcept
+    {
+      if (this != &other)
+      {
+        if (handle_)
+        {
+          vStreamBufferDelete(handle_);
+        }
+        handle_ = other.handle_;
+        other.handle_ = nullptr;
+      }
+      return *this;
+    }
+
+    // en: A Static* variant cannot be moved out through this class: its handle points into the derived object
+    // ja: Static* 版はこのクラス経由でもムーブできない: ハンドルが派生オブジェクトの領域を指すため
+    template <class Derived, detail::EnableIfDerived<BasicStreamBuffer, Derived> = 0>
+    BasicStreamBuffer(Derived &&) = delete;
+    template <class Derived, detail::EnableIfDerived<BasicStreamBuffer, Derived> = 0>
+    BasicStreamBuffer &operator=(Derived &&) = delete;
+
+    size_t trySend(const void *data, size_t len) { return send(data, len, 0); }
+    size_t send(const void *data, size_t len, const Deadline &deadline) { return detail::untilDeadline(deadline, [&](uint32_t ms) { return send(data, len, ms); }); }
+
+    // en: Copy up to len bytes from data. Blocks until everything fits or the timeout expires;
+    // en: returns the number of bytes written (may be partial, 0 on timeout/full).
+    // ja: data から最大 len バイトをコピー。全量が入るかタイムアウトまでブロックし、
+    // ja: 書き込んだバイト数を返す（一部のみの場合あり、タイムアウト/満杯なら 0）
+    size_t send(const void *data, size_t len, uint32_t timeoutMs = WaitForever)
+    {
+      if (!handle_)
+      {
+        this->logError("[StreamBuffer] send failed: handle null");
+        return 0;
+      }
+      if (!data || len == 0)
+      {
+        return 0;
+      }
+
+      const bool inIsr = xPortInIsrContext();
+      TickType_t ticks = (inIsr || timeoutMs == 0) ? 0 : (timeoutMs == WaitForever ? portMAX_DELAY : pdMS_TO_TICKS(timeoutMs));
+      const bool nonBlocking = (ticks == 0);
+      size_t written = 0;
+
+      if (inIsr)
+      {
+        BaseType_t taskWoken = pdFALSE;
+        written = xStreamBufferSendFromISR(handle_, data, len, &taskWoken);
+        if (taskWoken == pdTRUE)
+        {
+          portYIELD_FROM_ISR();
+        }
+      }
+      else
+      {
+        const int64_t blockStart = this->blockBegin(ticks);
+        written = xStreamBufferSend(handle_, data, len, ticks);
+        this->blockEnd(blockStart);
+      }
+
+      if (written == 0)
+      {
+        this->countFailure(!nonBlocking);
+        if (inIsr)
+        {
+          this->logWarn("[StreamBuffer] send ISR failed: full");
+        }
+        else if (!nonBlocking)
+        {
+          this->logTimeout("[StreamBuffer] send timeout/full");
+        }
+        return 0;
+      }
+      this->countSend();
+      return written;
+    }
+
+    size_t tryReceive(void *out, size_t maxLen) { return receive(out, maxLen, 0); }
+    size_t receive(void *out, size_t maxLen, const Deadline &deadline) { return detail::untilDeadline(deadline, [&](uint32_t ms) { return receive(out, maxLen, ms); }); }
+
+    // en: Read up to maxLen bytes into out. Blocks until triggerLevel bytes (or fewer at timeout) are available;
+    // en: returns the number of bytes read (0 on timeout/empty).
+    // ja: 最大 maxLen バイトを out へ読み出す。triggerLevel バイト溜まるまで（タイムアウト時はそれ未満でも）
+    // ja: ブロックし、読み出したバイト数を返す（タイムアウト/空なら 0）
+    size_t receive(void *out, size_t maxLen, uint32_t timeoutMs = WaitForever)
+    {
+      if (!handle_)
+      {
+        this->logError("[StreamBuffer] receive failed: handle null");
+        return 0;
+      }
+      if (!out || maxLen == 0)
+      {
+        return 0;
+      }
+
+      const bool inIsr = xPortInIsrContext();
+      TickType_t ticks = (inIsr || timeoutMs == 0) ? 0 : (timeoutMs == WaitForever ? portMAX_DELAY : pdMS_TO_TICKS(timeoutMs));
+      const bool nonBlocking = (ticks == 0);
+      size_t received = 0;
+
+      if (inIsr)
+      {
+        BaseType_t taskWoken = pdFALSE;
+        received = xStreamBufferReceiveFromISR(handle_, out, maxLen, &taskWoken);
+        if (taskWoken == pdTRUE)
+        {
+          portYIELD_FROM_ISR();
+        }
+      }
+      else
+      {
+        const int64_t blockStart = this->blockBegin(ticks);
+        received = xStreamBufferReceive(handle_, out, maxLen, ticks);
+        this->blockEnd(blockStart);
+      }
+
+      if (received == 0)
+      {
+        this->countFailure(!nonBlocking);
+        if (!nonBlocking)
+        {
+          this->logTimeout("[StreamBuffer] receive timeout");
+        }
+        return 0;
+      }
+      this->countReceive();
+      return received;
+    }
+
+    // en: Bytes that must be available before a blocked reader wakes (1..capacity)
+    // ja: ブロック中の読み手が起きるまでに必要なバイト数（1..capacity）
+    bool setTriggerLevel(size_t triggerLevel)
+    {
+      if (!handle_)
+      {
+        this->logError("[StreamBuffer] setTriggerLevel failed: handle null");
+        return false;
+      }
+      if (triggerLevel == 0 || xStreamBufferSetTriggerLevel(handle_, triggerLevel) != pdPASS)
+      {
+        this->logWarn("[StreamBuffer] setTriggerLevel failed: must be 1..capacity");
+        return false;
+      }
+      return true;
+    }
+
+    size_t available() const
+    {
+      if (!handle_)
+      {
+        this->logError("[StreamBuffer] available failed: handle null");
+        return 0;
+      }
+      return xStreamBufferBytesAvailable(handle_);
+    }
+
+    size_t spaces() const
+    {
+      if (!handle_)
+      {
+        this->logError("[StreamBuffer] spaces failed: handle null");
+        return 0;
+      }
+      return xStreamBufferSpacesAvailable(handle_);
+    }
+
+    // en: Discard all bytes (task only; fails while a task is blocked on the buffer)
+    // ja: すべてのバイトを破棄（タスクのみ。バッファでブロック中のタスクがいると失敗）
+    bool clear()
+    {
+      if (!handle_)
+      {
+        this->logError("[StreamBuffer] clear failed: handle null");
+        return false;
+      }
+      if (xPortInIsrContext())
+      {
+        this->logWarn("[StreamBuffer] clear not allowed in ISR");
+        return false;
+      }
+      if (xStreamBufferReset(handle_) != pdPASS)
+      {
+        this->logWarn("[StreamBuffer] clear failed: a task is blocked on it");
+        return false;
+      }
+      return true;
+    }
+
+  protected:
+    // en: Adopt a handle created by a Static* variant
+    // ja: Static* 版で生成したハンドルを引き取る
+    BasicStreamBuffer(detail::AdoptHandle, StreamBufferHandle_t handle)
+        : handle_(handle)
+    {
+      if (!handle_)
+      {
+        this->logError("[StreamBuffer] create failed: xStreamBufferCreateStatic");
+      }
+    }
+
+  private:
+    StreamBufferHandle_t handle_;
+  };
+
+  using StreamBuffer = BasicStreamBuffer<>;
+
+  // en: Variable-length messages between one writer and one reader (FreeRTOS message buffer).
+  // en: Each message is delivered whole and costs its length plus sizeof(size_t) bytes of capacity.
+  // ja: 1 書き手・1 読み手の可変長メッセージ（FreeRTOS メッセージバッファ）。
+  // ja: メッセージは丸ごと届き、容量を「長さ + sizeof(size_t)」バイト消費する
+  template <class StatsPolicy = NoStats, class LogPolicy = LogAll>
+  class BasicMessageBuffer : public detail::StatsRecorder<StatsPolicy>, protected detail::Diagnostics<LogPolicy>
+  {
+    static_assert(!std::is_same<StatsPolicy, WithProfile>::value, "MessageBuffer: WithProfile is Mutex-only, use WithStats");
+
+  public:
+    explicit BasicMessageBuffer(size_t capacityBytes)
+        : handle_(nullptr)
+    {
+      if (capacityBytes <= sizeof(size_t))
+      {
+        this->logError("[MessageBuffer] create failed: capacity must exceed sizeof(size_t)");
+        return;
+      }
+      handle_ = xMessageBufferCreate(capacityBytes);
+      if (!handle_)
+      {
+        this->logError("[MessageBuffer] create failed: xMessageBufferCreate");
+      }
+    }
+
+    ~BasicMessageBuffer()
+    {
+      if (handle_)
+      {
+        vMessageBufferDelete(handle_);
+        handle_ = nullptr;
+      }
+    }
+
+    BasicMessageBuffer(const BasicMessageBuffer &) = delete;
+    BasicMessageBuffer &operator=(const BasicMessageBuffer &) = delete;
+
+    BasicMessageBuffer(BasicMessageBuffer &&other) noexcept : handle_(other.handle_)
+    {
+      other.handle_ = nullptr;
+    }
+    BasicMessageBuffer &operator=(BasicMessageBuffer &&other) noexcept
+    {
+      if (this != &other)
+      {
+        if (handle_)
+        {
+          vMessageBufferDelete(handle_);
+        }
+        handle_ = other.handle_;
+        other.handle_ = nullptr;
+      }
+      return *this;
+    }
+
+    // en: A Static* variant cannot be moved out through this class: its handle points into the derived object
+    // ja: Static* 版はこのクラス経由でもムーブできない: ハンドルが派生オブジェクトの領域を指すため
+    template <class Derived, detail::EnableIfDerived<BasicMessageBuffer, Derived> = 0>
+    BasicMessageBuffer(Derived &&) = delete;
+    template <class Derived, detail::EnableIfDerived<BasicMessageBuffer, Derived> = 0>
+    BasicMessageBuffer &operator=(Derived &&) = delete;
+
+    bool trySend(const void *msg, size_t len) { return send(msg, len, 0); }
+    bool send(const void *msg, size_t len, const Deadline &deadline) { return detail::untilDeadline(deadline, [&](uint32_t ms) { return send(msg, len, ms); }); }
+
+    // en: Write one whole message (all or nothing)
+    // ja: メッセージを1件丸ごと書き込む（全部か無し）
+    bool send(const void *msg, size_t len, uint32_t timeoutMs = WaitForever)
+    {
+      if (!handle_)
+      {
+        this->logError("[MessageBuffer] send failed: handle null");
+        return false;
+      }
+      if (!msg || len == 0)
+      {
+        this->logWarn("[MessageBuffer] send failed: empty message");
+        return false;
+      }
+
+      const bool inIsr = xPortInIsrContext();
+      TickType_t ticks = (inIsr || timeoutMs == 0) ? 0 : (timeoutMs == WaitForever ? portMAX_DELAY : pdMS_TO_TICKS(timeoutMs));
+      const bool nonBlocking = (ticks == 0);
+      size_t written = 0;
+
+      if (inIsr)
+      {
+        BaseType_t taskWoken = pdFALSE;
+        written = xMessageBufferSendFromISR(handle_, msg, len, &taskWoken);
+        if (taskWoken == pdTRUE)
+        {
+          portYIELD_FROM_ISR();
+        }
+      }
+      else
+      {
+        const int64_t blockStart = this->blockBegin(ticks);
+        written = xMessageBufferSend(handle_, msg, len, ticks);
+        this->blockEnd(blockStart);
+      }
+
+      if (written != len)
+      {
+        this->countFailure(!nonBlocking);
+        if (inIsr)
+        {
+          this->logWarn("[MessageBuffer] send ISR failed: full");
+        }
+        else if (!nonBlocking)
+        {
+          this->logTimeout("[MessageBuffer] send timeout/full");
+        }
+        return false;
+      }
+      this->countSend();
+      return true;
+    }
+
+    size_t tryReceive(void *out, size_t maxLen) { return receive(out, maxLen, 0); }
+    size_t receive(void *out, size_t maxLen, const Deadline &deadline) { return detail::untilDeadline(deadline, [&](uint32_t ms) { return receive(out, maxLen, ms); }); }
+
+    // en: Read the next message into out and return its length; 0 on timeout/empty, or when maxLen is too
+    // en: small (the message stays queued, see nextLength()).
+    // ja: 次のメッセージを out へ読み出し長さを返す。タイムアウト/空、または maxLen が足りない場合は 0
+    // ja: （メッセージは残る。nextLength() 参照）
+    size_t receive(void *out, size_t maxLen, uint32_t timeoutMs = WaitForever)
+    {
+      if (!handle_)
+      {
+        this->logError("[MessageBuffer] receive failed: handle null");
+        return 0;
+      }
+      if (!out)
+      {
+        return 0;
+      }
+
+      const bool inIsr = xPortInIsrContext();
+      TickType_t ticks = (inIsr || timeoutMs == 0) ? 0 : (timeoutMs == WaitForever ? portMAX_DELAY : pdMS_TO_TICKS(timeoutMs));
+      const bool nonBlocking = (ticks == 0);
+      size_t received = 0;
+
+      if (inIsr)
+      {
+        BaseType_t taskWoken = pdFALSE;
+        received = xMessageBufferReceiveFromISR(handle_, out, maxLen, &taskWoken);
+        if (taskWoken == pdTRUE)
+        {
+          portYIELD_FROM_ISR();
+        }
+      }
+      else
+      {
+        const int64_t blockStart = this->blockBegin(ticks);
+        received = xMessageBufferReceive(handle_, out, maxLen, ticks);
+        this->blockEnd(blockStart);
+      }
+
+      if (received == 0)
+      {
+        this->countFailure(!nonBlocking);
+        if (xMessageBufferNextLengthBytes(handle_) > maxLen)
+        {
+          this->logWarn("[MessageBuffer] receive failed: buffer too small (%ld bytes needed)", static_cast<long>(xMessageBufferNextLengthBytes(handle_)));
+        }
+        else if (!nonBlocking)
+        {
+          this->logTimeout("[MessageBuffer] receive timeout");
+        }
+        return 0;
+      }
+      this->countReceive();
+      return received;
+    }
+
+    // en: Length of the next message, 0 if empty
+    // ja: 次のメッセージの長さ（空なら 0）
+    size_t nextLength() const
+    {
+      if (!handle_)
+      {
+        this->logError("[MessageBuffer] nextLength failed: handle null");
+        return 0;
+      }
+      return xMessageBufferNextLengthBytes(handle_);
+    }
+
+    size_t spaces() const
+    {
+      if (!handle_)
+      {
+        this->logError("[MessageBuffer] spaces failed: handle null");
+        return 0;
+      }
+      return xMessageBufferSpacesAvailable(handle_);
+    }
+
+    bool clear()
+    {
+      if (!handle_)
+      {
+        this->logError("[MessageBuffer] clear failed: handle null");
+        return false;
+      }
+      if (xPortInIsrContext())
+      {
+        this->logWarn("[MessageBuffer] clear not allowed in ISR");
+        return false;
+      }
+      if (xMessageBufferReset(handle_) != pdPASS)
+      {
+        this->logWarn("[MessageBuffer] clear failed: a task is blocked on it");
+        return false;
+      }
+      return true;
+    }
+
+  protected:
+    // en: Adopt a handle created by a Static* variant
+    // ja: Static* 版で生成したハンドルを引き取る
+    BasicMessageBuffer(detail::AdoptHandle, MessageBufferHandle_t handle)
+        : handle_(handle)
+    {
+      if (!handle_)
+      {
+        this->logError("[MessageBuffer] create failed: xMessageBufferCreateStatic");
+      }
+    }
+
+  private:
+    MessageBufferHandle_t handle_;
+  };
+
+  using MessageBuffer = BasicMessageBuffer<>;
+
+  namespace detail
+  {
+    // en: FreeRTOS keeps one byte free to tell full from empty, so Size usable bytes need Size + 1
+    // ja: FreeRTOS は満杯と空を区別するため1バイト空けるので、Size バイト使うには Size + 1 必要
+    template <size_t Size>
+    struct StaticStreamBufferStorage
+    {
+      StaticStreamBuffer_t streamBuffer_;
+      uint8_t bytes_[Size + 1];
+    };
+  } // namespace detail
+
+  // en: StreamBuffer with compile-time capacity; storage lives inside the object (no heap)
+  // ja: 容量をコンパイル時に決める StreamBuffer。格納領域をオブジェクト内に持つ（ヒープ不使用）
+  template <size_t Size, class StatsPolicy = NoStats, class LogPolicy = LogAll>
+  class StaticStreamBuffer : private detail::StaticStreamBufferStorage<Size>,
+                             public BasicStreamBuffer<StatsPolicy, LogPolicy>
+  {
+    static_assert(Size > 0, "StaticStreamBuffer: Size must be > 0");
+
+  public:
+    explicit StaticStreamBuffer(size_t triggerLevel = 1)
+        : BasicStreamBuffer<StatsPolicy, LogPolicy>(
+              detail::AdoptHandle{},
+              (triggerLevel >= 1 && triggerLevel <= Size)
+                  ? xStreamBufferCreateStatic(Size + 1, triggerLevel, this->bytes_, &this->streamBuffer_)
+                  : nullptr)
+    {
+    }
+
+    StaticStreamBuffer(StaticStreamBuffer &&) = delete;
+    StaticStreamBuffer &operator=(StaticStreamBuffer &&) = delete;
+
+    static constexpr size_t capacity() { return Size; }
+  };
+
+  // en: MessageBuffer with compile-time capacity (Size includes the sizeof(size_t) length prefix per message)
+  // ja: 容量をコンパイル時に決める MessageBuffer（Size にはメッセージごとの sizeof(size_t) の長さ情報を含む）
+  template <size_t Size, class StatsPolicy = NoStats, class LogPolicy = LogAll>
+  class StaticMessageBuffer : private detail::StaticStreamBufferStorage<Size>,
+                              public BasicMessageBuffer<StatsPolicy, LogPolicy>
+  {
+    static_assert(Size > sizeof(size_t), "StaticMessageBuffer: Size must exceed sizeof(size_t)");
+
+  public:
+    StaticMessageBuffer()
+        : BasicMessageBuffer<StatsPolicy, LogPolicy>(
+              detail::AdoptHandle{}, xMessageBufferCreateStatic(Size + 1, this->bytes_, &this->streamBuffer_))
+    {
+    }
+
+    StaticMessageBuffer(StaticMessageBuffer &&) = delete;
+    StaticMessageBuffer &operator=(StaticMessageBuffer &&) = delete;
+
+    static constexpr size_t capacity() { return Size; }
+  };
+
+} // namespace ESP32SyncKit
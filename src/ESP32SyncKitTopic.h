@@ -0,0 +1,405 @@
+#pragma once
+
+#include "ESP32SyncKit.h"
+
+#include <type_traits>
+
+namespace ESP32SyncKit
+{
+
+  // en: What a Topic subscriber does when it falls a full ring behind the publisher
+  // ja: Topic の購読者が発行側から1周分遅れたときの動作
+  enum class TopicPolicy : uint8_t
+  {
+    Drop,  // en: the publisher overwrites; the subscriber skips ahead and counts missed() / ja: 発行側が上書きし、購読者は先へ飛んで missed() に数える
+    Block, // en: the publisher waits for this subscriber (ISR publish fails instead) / ja: 発行側がこの購読者を待つ（ISR からの発行は失敗する）
+  };
+
+  // en: Single-copy publish/subscribe: every message is written once into a shared ring and each subscriber
+  // en: reads it through its own cursor, so publish cost does not grow with the number of subscribers
+  // en: (only subscribers asleep in receive() are notified, on their notification slot NotifyIndex, which is
+  // en: reserved). Any task or ISR on either core may publish.
+  // ja: 1回のコピーで配信する publish/subscribe: 各メッセージは共有リングに1回だけ書かれ、各購読者は
+  // ja: 自身のカーソルで読む。そのため発行コストは購読者数に比例しない（通知するのは receive() で眠っている
+  // ja: 購読者だけで、使うのはその NotifyIndex 番の通知スロット。専有となる）。両コアの任意のタスク・ISR から発行できる
+  template <class T, size_t Capacity, size_t MaxSubscribers = 4, class LogPolicy = LogAll, UBaseType_t NotifyIndex = kSyncKitNotifyIndex>
+  class Topic : protected detail::Diagnostics<LogPolicy>
+  {
+    static_assert(Capacity >= 1 && (Capacity & (Capacity - 1)) == 0, "Topic: Capacity must be a power of two (sequence numbers wrap)");
+    static_assert(MaxSubscribers >= 1 && MaxSubscribers <= 32, "Topic: MaxSubscribers must be 1..32");
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "Topic: T must be trivially copyable; messages are copied inside a critical section");
+
+  public:
+    // en: One reader of the topic. Starts at the next message published after it attaches. One task at a time.
+    // ja: トピックの読み手1つ。登録後に発行された次のメッセージから読む。同時に使うのは1タスクまで
+    class Subscriber
+    {
+    public:
+      explicit Subscriber(Topic &topic, TopicPolicy policy = TopicPolicy::Drop) : topic_(&topic), index_(topic.attach(policy)) {}
+
+      ~Subscriber()
+      {
+        if (attached())
+        {
+          topic_->detach(index_);
+        }
+      }
+
+      // en: The ring keeps this subscriber's cursor by index, so it cannot be copied or moved
+      // ja: リングがこの購読者のカーソルを番号で保持するため、コピー・ムーブ不可
+      Subscriber(const Subscriber &) = delete;
+      Subscriber &operator=(const Subscriber &) = delete;
+      Subscriber(Subscriber &&) = delete;
+      Subscriber &operator=(Subscriber &&) = delete;
+
+      // en: False when the topic already had MaxSubscribers
+      // ja: トピックの購読者がすでに MaxSubscribers に達していたら false
+      bool attached() const { return index_ >= 0; }
+
+      bool tryReceive(T &out) { return receive(out, 0); }
+      bool receive(T &out, const Deadline &deadline) { return detail::untilDeadline(deadline, [&](uint32_t ms) { return receive(out, ms); }); }
+
+      bool receive(T &out, uint32_t timeoutMs = WaitForever)
+      {
+        if (!attached())
+        {
+          topic_->logError("[Topic] receive failed: not attached");
+          return false;
+        }
+        return topic_->receive(index_, out, timeoutMs);
+      }
+
+      // en: Messages waiting for this subscriber (snapshot; at most Capacity)
+      // ja: この購読者が未読のメッセージ数（スナップショット。最大 Capacity）
+      uint32_t available() const { return attached() ? topic_->available(index_) : 0; }
+
+      // en: Messages overwritten before this subscriber read them (Drop policy; never reset)
+      // ja: この購読者が読む前に上書きされたメッセージ数（Drop ポリシー。リセットしない）
+      uint32_t missed() const { return attached() ? topic_->missed(index_) : 0; }
+
+    private:
+      Topic *topic_;
+      int index_; // en: -1 when not attached / ja: 未登録なら -1
+    };
+
+    // en: The publisher-wait semaphore is created from a static buffer in the constructor (no heap, cannot fail)
+    // ja: 発行側の待機用セマフォはコンストラクタで静的バッファから生成する（ヒープ不使用、失敗しない）
+    Topic() : space_(xSemaphoreCreateBinaryStatic(&spaceBuffer_)) {}
+
+    ~Topic()
+    {
+      if (subscriberCount_ != 0)
+      {
+        this->logError("[Topic] destroyed with %ld subscribers attached", static_cast<long>(subscriberCount_));
+      }
+      vSemaphoreDelete(space_);
+    }
+
+    Topic(const Topic &) = delete;
+    Topic &operator=(const Topic &) = delete;
+    Topic(Topic &&) = delete;
+    Topic &operator=(Topic &&) = delete;
+
+    bool tryPublish(const T &value) { return publish(value, 0); }
+    bool publish(const T &value, const Deadline &deadline) { return detail::untilDeadline(deadline, [&](uint32_t ms) { return publish(value, ms); }); }
+
+    // en: Write value once for every subscriber. Waits only while a Block subscriber is a full ring behind
+    // en: (never in an ISR); Drop subscribers never hold the publisher back.
+    // ja: value を全購読者のために1回だけ書く。Block の購読者が1周分遅れている間だけ待つ（ISR では待たない）。
+    // ja: Drop の購読者が発行側を止めることはない
+    bool publish(const T &value, uint32_t timeoutMs = WaitForever)
+    {
+      const bool inIsr = xPortInIsrContext();
+      TickType_t ticks = (inIsr || timeoutMs == 0) ? 0 : (timeoutMs == WaitForever ? portMAX_DELAY : pdMS_TO_TICKS(timeoutMs));
+      const bool infinite = (ticks == portMAX_DELAY);
+      const TickType_t start = inIsr ? 0 : xTaskGetTickCount();
+      TickType_t remaining = ticks;
+
+      TaskHandle_t wake[MaxSubscribers];
+      uint32_t wakeCount = 0;
+      while (true)
+      {
+        portENTER_CRITICAL_SAFE(&mux_);
+        if (hasRoom())
+        {
+          slots_[head_ % Capacity] = value;
+          ++head_;
+          for (uint32_t mask = waitingMask_; mask != 0; mask &= mask - 1)
+          {
+            SubscriberState &sub = subs_[__builtin_ctz(mask)];
+            wake[wakeCount++] = sub.waiter;
+            sub.waiter = nullptr;
+          }
+          waitingMask_ = 0;
+          portEXIT_CRITICAL_SAFE(&mux_);
+          break;
+        }
+        if (remaining == 0)
+        {
+          portEXIT_CRITICAL_SAFE(&mux_);
+          rejected_.fetch_add(1, std::memory_order_relaxed);
+          if (inIsr)
+          {
+            this->logWarn("[Topic] publish ISR failed: Block subscriber full");
+          }
+          else if (ticks != 0)
+          {
+            this->logTimeout("[Topic] publish timeout: Block subscriber full");
+          }
+          return false;
+        }
+        ++publishersWaiting_;
+        portEXIT_CRITICAL_SAFE(&mux_);
+
+        (void)xSemaphoreTake(space_, remaining);
+
+        portENTER_CRITICAL_SAFE(&mux_);
+        --publishersWaiting_;
+        portEXIT_CRITICAL_SAFE(&mux_);
+
+        if (!infinite)
+        {
+          TickType_t elapsed = xTaskGetTickCount() - start;
+          remaining = (elapsed >= ticks) ? 0 : ticks - elapsed;
+        }
+      }
+
+      // en: Only subscribers asleep in receive() cost a notification; with none asleep the mask is 0
+      // ja: 通知のコストがかかるのは receive() で眠っている購読者だけ。誰も眠っていなければマスクは 0
+      BaseType_t taskWoken = pdFALSE;
+      for (uint32_t i = 0; i < wakeCount; ++i)
+      {
+        if (inIsr)
+        {
+          vTaskNotifyGiveIndexedFromISR(wake[i], NotifyIndex, &taskWoken);
+        }
+        else
+        {
+          (void)xTaskNotifyGiveIndexed(wake[i], NotifyIndex);
+        }
+      }
+      if (taskWoken == pdTRUE)
+      {
+        portYIELD_FROM_ISR();
+      }
+      return true;
+    }
+
+    uint32_t subscribers() const
+    {
+      portENTER_CRITICAL_SAFE(&mux_);
+      const uint32_t n = subscriberCount_;
+      portEXIT_CRITICAL_SAFE(&mux_);
+      return n;
+    }
+
+    // en: Publishes refused because a Block subscriber was full (never reset)
+    // ja: Block の購読者が満杯だったため拒否した発行の数（リセットしない）
+    uint32_t rejected() const { return rejected_.load(std::memory_order_relaxed); }
+
+    static constexpr uint32_t capacity() { return Capacity; }
+
+  private:
+    using Channel = detail::NotifyChannel<NotifyIndex>;
+
+    struct SubscriberState
+    {
+      bool used;
+      TopicPolicy policy;
+      uint32_t cursor; // en: sequence number of the next message to read / ja: 次に読むメッセージの通し番号
+      uint32_t missed;
+      TaskHandle_t waiter; // en: set while asleep in receive() / ja: receive() で眠っている間だけ設定
+    };
+
+    // en: Called inside mux_. floor_ caches the slowest Block cursor; cursors only move forward,
+    // en: so the subscribers are scanned only when the cached value says the ring may be full.
+    // ja: mux_ 内で呼ぶ。floor_ は最も遅い Block カーソルのキャッシュ。カーソルは前にしか進まないため、
+    // ja: キャッシュ上でリングが満杯に見えるときだけ購読者を走査する
+    bool hasRoom()
+    {
+      if (blockCount_ == 0 || head_ - floor_ < Capacity)
+      {
+        return true;
+      }
+      uint32_t slowest = head_;
+      for (size_t i = 0; i < MaxSubscribers; ++i)
+      {
+        const SubscriberState &s = subs_[i];
+        if (s.used && s.policy == TopicPolicy::Block && head_ - s.cursor > head_ - slowest)
+        {
+          slowest = s.cursor;
+        }
+      }
+      floor_ = slowest;
+      return head_ - floor_ < Capacity;
+    }
+
+    int attach(TopicPolicy policy)
+    {
+      portENTER_CRITICAL_SAFE(&mux_);
+      for (size_t i = 0; i < MaxSubscribers; ++i)
+      {
+        SubscriberState &s = subs_[i];
+        if (!s.used)
+        {
+          s = SubscriberState{true, policy, head_, 0, nullptr};
+          ++subscriberCount_;
+          if (policy == TopicPolicy::Block)
+          {
+            if (blockCount_++ == 0)
+            {
+              floor_ = head_;
+            }
+          }
+          portEXIT_CRITICAL_SAFE(&mux_);
+          return static_cast<int>(i);
+        }
+      }
+      portEXIT_CRITICAL_SAFE(&mux_);
+      this->logError("[Topic] subscribe failed: MaxSubscribers=%ld reached", static_cast<long>(MaxSubscribers));
+      return -1;
+    }
+
+    void detach(int index)
+    {
+      portENTER_CRITICAL_SAFE(&mux_);
+      SubscriberState &s = subs_[index];
+      const bool wasBlock = (s.policy == TopicPolicy::Block);
+      s.used = false;
+      s.waiter = nullptr;
+      waitingMask_ &= ~(1u << index);
+      --subscriberCount_;
+      if (wasBlock)
+      {
+        --blockCount_;
+      }
+      const bool wakePublisher = wasBlock && publishersWaiting_ != 0;
+      portEXIT_CRITICAL_SAFE(&mux_);
+      if (wakePublisher)
+      {
+        (void)xSemaphoreGive(space_);
+      }
+    }
+
+    bool receive(int index, T &out, uint32_t timeoutMs)
+    {
+      const bool inIsr = xPortInIsrContext();
+      TickType_t ticks = (inIsr || timeoutMs == 0) ? 0 : (timeoutMs == WaitForever ? portMAX_DELAY : pdMS_TO_TICKS(timeoutMs));
+      const bool infinite = (ticks == portMAX_DELAY);
+      const TickType_t start = inIsr ? 0 : xTaskGetTickCount();
+      TickType_t remaining = ticks;
+      SubscriberState &s = subs_[index];
+      const uint32_t bit = 1u << index;
+
+      while (true)
+      {
+        portENTER_CRITICAL_SAFE(&mux_);
+        s.waiter = nullptr;
+        waitingMask_ &= ~bit;
+        if (s.cursor != head_)
+        {
+          // en: Drop: skip what the publisher has already overwritten
+          // ja: Drop: 発行側が上書き済みの分を飛ばす
+          if (head_ - s.cursor > Capacity)
+          {
+            s.missed += head_ - s.cursor - Capacity;
+            s.cursor = head_ - Capacity;
+          }
+          out = slots_[s.cursor % Capacity];
+          ++s.cursor;
+          const bool wakePublisher = (s.policy == TopicPolicy::Block) && publishersWaiting_ != 0;
+          portEXIT_CRITICAL_SAFE(&mux_);
+          if (wakePublisher)
+          {
+            give(space_, inIsr);
+          }
+          return true;
+        }
+        if (remaining == 0)
+        {
+          portEXIT_CRITICAL_SAFE(&mux_);
+          if (ticks != 0)
+          {
+            this->logTimeout("[Topic] receive timeout");
+          }
+          return false;
+        }
+        // en: Registered under the same lock publish() takes, so a wakeup cannot slip between check and sleep
+        // ja: publish() と同じロックの中で登録するため、確認と眠りの間に通知を取りこぼさない
+        s.waiter = xTaskGetCurrentTaskHandle();
+        waitingMask_ |= bit;
+        portEXIT_CRITICAL_SAFE(&mux_);
+
+        // en: A publisher that cleared s.waiter has a give on the way; take it unless it already woke us
+        // ja: s.waiter を消した発行側は give を送りつつある。それで起きたのでなければ受け取っておく
+        const uint32_t taken = Channel::wait(remaining);
+        portENTER_CRITICAL_SAFE(&mux_);
+        const bool claimed = (s.waiter == nullptr);
+        s.waiter = nullptr;
+        waitingMask_ &= ~bit;
+        portEXIT_CRITICAL_SAFE(&mux_);
+        if (claimed && taken == 0)
+        {
+          Channel::absorb();
+        }
+
+        if (!infinite)
+        {
+          TickType_t elapsed = xTaskGetTickCount() - start;
+          remaining = (elapsed >= ticks) ? 0 : ticks - elapsed;
+        }
+      }
+    }
+
+    uint32_t available(int index) const
+    {
+      portENTER_CRITICAL_SAFE(&mux_);
+      const uint32_t behind = head_ - subs_[index].cursor;
+      portEXIT_CRITICAL_SAFE(&mux_);
+      return behind > Capacity ? Capacity : behind;
+    }
+
+    uint32_t missed(int index) const
+    {
+      portENTER_CRITICAL_SAFE(&mux_);
+      const SubscriberState &s = subs_[index];
+      const uint32_t behind = head_ - s.cursor;
+      const uint32_t n = s.missed + (behind > Capacity ? behind - Capacity : 0);
+      portEXIT_CRITICAL_SAFE(&mux_);
+      return n;
+    }
+
+    static void give(SemaphoreHandle_t sem, bool inIsr)
+    {
+      if (inIsr)
+      {
+        BaseType_t taskWoken = pdFALSE;
+        (void)xSemaphoreGiveFromISR(sem, &taskWoken);
+        if (taskWoken == pdTRUE)
+        {
+          portYIELD_FROM_ISR();
+        }
+      }
+      else
+      {
+        (void)xSemaphoreGive(sem);
+      }
+    }
+
+    mutable portMUX_TYPE mux_ = portMUX_INITIALIZER_UNLOCKED;
+    uint32_t head_ = 0;  // en: sequence number of the next message / ja: 次のメッセージの通し番号
+    uint32_t floor_ = 0; // en: cached slowest Block cursor / ja: 最も遅い Block カーソルのキャッシュ
+    uint8_t subscriberCount_ = 0;
+    uint8_t blockCount_ = 0;
+    uint8_t publishersWaiting_ = 0;
+    uint32_t waitingMask_ = 0; // en: subscribers asleep in receive() / ja: receive() で眠っている購読者
+    std::atomic<uint32_t> rejected_{0};
+    SubscriberState subs_[MaxSubscribers] = {};
+    T slots_[Capacity];
+
+    StaticSemaphore_t spaceBuffer_;
+    SemaphoreHandle_t space_;
+  };
+
+} // namespace ESP32SyncKit
@@ -0,0 +1,830 @@
+#pragma once
+
+#include "ESP32SyncKit.h"
+
+#include <cstddef>
+#include <new>
+#include <stdio.h>
+#include <type_traits>
+#include <utility>
+
+namespace ESP32SyncKit
+{
+
+  // en: Worker tasks started by WorkPool::begin() (one per core, always pinned)
+  // ja: WorkPool::begin() が起動するワーカタスクの設定（コアごとに1つ、常に固定）
+  struct WorkPoolConfig
+  {
+    const char *name = "pool"; // en: task name prefix, core number appended / ja: タスク名の接頭辞（コア番号を付加）
+    uint32_t stackSize = 4096; // en: per worker / ja: ワーカごと
+    UBaseType_t priority = 1;  // en: same as loop() by default / ja: 既定は loop() と同じ
+  };
+
+  // en: Per-worker counters returned by WorkPool::workerStats()
+  // ja: WorkPool::workerStats() が返すワーカごとのカウンタ
+  struct WorkerStats
+  {
+    uint32_t jobs = 0;   // en: jobs run, including range chunks / ja: 実行したジョブ数（範囲の分割も含む）
+    uint32_t steals = 0; // en: jobs taken from the other worker's deque / ja: 他ワーカの deque から奪ったジョブ数
+    uint64_t busyUs = 0; // en: time spent running jobs / ja: ジョブの実行に費やした時間
+  };
+
+  template <size_t DequeSize, size_t InlineSize, class LogPolicy, UBaseType_t NotifyIndex>
+  class WorkPool;
+
+  namespace detail
+  {
+    // en: Job counter shared by every BasicCompletion instantiation; jobs only ever see this part.
+    // en: The top bit of pending says the owner is asleep in wait(), so the last finish() decides whether to
+    // en: notify from its own read-modify-write and never touches the object after it.
+    // ja: すべての BasicCompletion で共通のジョブカウンタ。ジョブが触れるのはこの部分だけ。
+    // ja: pending の最上位ビットは所有者が wait() で眠っていることを示す。最後の finish() は自身の
+    // ja: 読み出し・更新の結果だけで通知するかを決め、その後はオブジェクトに触れない
+    struct CompletionState
+    {
+      static constexpr uint32_t kSleeping = 0x80000000u;
+      static constexpr uint32_t kCountMask = ~kSleeping;
+
+      constexpr explicit CompletionState(UBaseType_t index) : notifyIndex(index) {}
+
+      uint32_t count() const { return pending.load(std::memory_order_acquire) & kCountMask; }
+
+      // en: Called by the submitting task before the job is queued
+      // ja: ジョブを積む前に、投入するタスクが呼ぶ
+      void arm()
+      {
+        owner.store(xTaskGetCurrentTaskHandle(), std::memory_order_relaxed);
+        pending.fetch_add(1, std::memory_order_relaxed);
+      }
+
+      // en: A running job splits off another; pending cannot reach 0 meanwhile because the caller still counts
+      // ja: 実行中のジョブが別のジョブを分割する。呼び出し側がまだ数に含まれるため、その間に 0 にはならない
+      void add() { pending.fetch_add(1, std::memory_order_relaxed); }
+
+      // en: The owner and slot are read before the decrement: once pending hits 0 the waiter may return and
+      // en: destroy this object, so nothing here may be touched afterwards
+      // ja: 所有者とスロットは減算の前に読む: pending が 0 になると待機側が戻ってこのオブジェクトを破棄し得るため、
+      // ja: その後はここに触れてはならない
+      void finish()
+      {
+        const TaskHandle_t waiter = owner.load(std::memory_order_relaxed);
+        const UBaseType_t index = notifyIndex;
+        if (pending.fetch_sub(1, std::memory_order_acq_rel) == (kSleeping | 1) && waiter)
+        {
+          (void)xTaskNotifyGiveIndexed(waiter, index);
+        }
+      }
+
+      // en: Undo arm() when the job could not be queued (nobody can be waiting yet)
+      // ja: ジョブを積めなかったときに arm() を取り消す（まだ誰も待っていない）
+      void cancel() { pending.fetch_sub(1, std::memory_order_acq_rel); }
+
+      // en: Owner side: announce the sleep; false when every job already finished (no notification will come)
+      // ja: 所有者側: 眠ることを知らせる。すべてのジョブが終わっていれば false（通知は来ない）
+      bool prepareSleep()
+      {
+        if ((pending.fetch_or(kSleeping, std::memory_order_acq_rel) & kCountMask) == 0)
+        {
+          pending.fetch_and(kCountMask, std::memory_order_relaxed);
+          return false;
+        }
+        return true;
+      }
+
+      // en: Owner side, after the sleep: true when the last job finished meanwhile, i.e. a notification was sent
+      // ja: 所有者側、眠った後: その間に最後のジョブが終わった、つまり通知が送られたら true
+      bool endSleep() { return (pending.fetch_and(kCountMask, std::memory_order_acq_rel) & kCountMask) == 0; }
+
+      std::atomic<uint32_t> pending{0};
+      std::atomic<TaskHandle_t> owner{nullptr};
+      const UBaseType_t notifyIndex;
+    };
+  } // namespace detail
+
+  // en: Tracks jobs submitted to a WorkPool. wait() sleeps on notification slot NotifyIndex of the submitting task
+  // en: (reserved: do not use it with Notify) until every job, including range chunks split off later, has finished.
+  // ja: WorkPool に投入したジョブを追跡する。wait() は投入したタスクの NotifyIndex 番の通知スロット（専有:
+  // ja: Notify とは併用しない）で眠り、後から分割された範囲の断片も含め、すべてのジョブが終わるまで待つ
+  template <class LogPolicy = LogAll, UBaseType_t NotifyIndex = kSyncKitNotifyIndex>
+  class BasicCompletion : protected detail::Diagnostics<LogPolicy>
+  {
+    using Channel = detail::NotifyChannel<NotifyIndex>;
+
+  public:
+    BasicCompletion() = default;
+
+    ~BasicCompletion()
+    {
+      if (!done())
+      {
+        this->logError("[Completion] destroyed with jobs pending");
+      }
+    }
+
+    // en: Jobs hold a pointer to it, so it cannot be copied or moved
+    // ja: ジョブがポインタを保持するため、コピー・ムーブ不可
+    BasicCompletion(const BasicCompletion &) = delete;
+    BasicCompletion &operator=(const BasicCompletion &) = delete;
+    BasicCompletion(BasicCompletion &&) = delete;
+    BasicCompletion &operator=(BasicCompletion &&) = delete;
+
+    // en: Task that submitted the jobs only; never from a pool worker
+    // ja: ジョブを投入したタスク専用。プールのワーカからは呼ばない
+    bool wait(uint32_t timeoutMs = WaitForever)
+    {
+      if (xPortInIsrContext())
+      {
+        this->logError("[Completion] wait called in ISR");
+        return false;
+      }
+      if (done())
+      {
+        return true;
+      }
+      if (state_.owner.load(std::memory_order_relaxed) != xTaskGetCurrentTaskHandle())
+      {
+        this->logError("[Completion] wait failed: not the submitting task");
+        return false;
+      }
+
+      TickType_t ticks = (timeoutMs == 0) ? 0 : (timeoutMs == WaitForever ? portMAX_DELAY : pdMS_TO_TICKS(timeoutMs));
+      const bool infinite = (ticks == portMAX_DELAY);
+      const TickType_t start = xTaskGetTickCount();
+      TickType_t remaining = ticks;
+
+      while (!done())
+      {
+        if (remaining == 0)
+        {
+          if (ticks != 0)
+          {
+            this->logTimeout("[Completion] wait timeout");
+          }
+          return false;
+        }
+        if (state_.prepareSleep())
+        {
+          const uint32_t taken = Channel::wait(remaining);
+          if (state_.endSleep() && taken == 0)
+          {
+            Channel::absorb();
+          }
+        }
+
+        if (!infinite)
+        {
+          TickType_t elapsed = xTaskGetTickCount() - start;
+          remaining = (elapsed >= ticks) ? 0 : ticks - elapsed;
+        }
+      }
+      return true;
+    }
+
+    bool wait(const Deadline &deadline) { return detail::untilDeadline(deadline, [&](uint32_t ms) { return wait(ms); }); }
+
+    bool done() const { return state_.count() == 0; }
+    uint32_t pending() const { return state_.count(); }
+
+  private:
+    template <size_t, size_t, class, UBaseType_t>
+    friend class WorkPool;
+
+    detail::CompletionState state_{NotifyIndex};
+  };
+
+  using Completion = BasicCompletion<>;
+
+  // en: Work-stealing pool with one worker per core for CPU-bound batch work (FFT blocks, image tiles, chunks).
+  // en: Each worker owns a lock-free deque: it pushes and pops at the bottom, the other worker steals from the top,
+  // en: so uneven chunk costs even out without a shared lock. Submissions from ordinary tasks arrive through
+  // en: an inbox Queue; parallelFor() splits a range in halves down to the grain, pushing one half each time.
+  // en: Idle workers sleep on their notification slot NotifyIndex; the blocking parallelFor() waits on that slot too.
+  // en: Nested in a job, it first helps with pool jobs, then sleeps there until its range is done or a deque gets work.
+  // ja: CPU 負荷の高いバッチ処理（FFT ブロック、画像タイル、圧縮チャンク）向けの、コアごとに1ワーカの
+  // ja: ワークスティーリングプール。各ワーカはロックフリーの deque を持ち、自身は底で push/pop し、
+  // ja: 他方のワーカは先頭から奪う。共有ロックなしでチャンクのコストの偏りがならされる。通常のタスクからの
+  // ja: 投入は受付用の Queue を通る。parallelFor() は範囲を grain まで半分ずつ分割し、そのたびに片方を push する
+  // ja: アイドルのワーカは NotifyIndex 番の通知スロットで眠る。ブロッキング版 parallelFor() もそのスロットで待つ。
+  // ja: ジョブ内で入れ子に呼ぶとまずプールのジョブを手伝い、その後は範囲が終わるか deque に仕事が来るまでそこで眠る
+  template <size_t DequeSize = 32, size_t InlineSize = 16, class LogPolicy = LogAll, UBaseType_t NotifyIndex = kSyncKitNotifyIndex>
+  class WorkPool : protected detail::Diagnostics<LogPolicy>
+  {
+    static_assert(DequeSize >= 2 && (DequeSize & (DequeSize - 1)) == 0, "WorkPool: DequeSize must be a power of two >= 2");
+    static_assert(InlineSize >= sizeof(void *), "WorkPool: InlineSize must hold at least a pointer");
+
+  public:
+    static constexpr uint8_t kWorkers = portNUM_PROCESSORS;
+
+    // en: inboxDepth = jobs from non-worker tasks that can wait. Constant-initialized like Queue<T>.
+    // ja: inboxDepth = ワーカ以外のタスクから投入され待機できるジョブ数。Queue<T> と同様に定数初期化される
+    constexpr explicit WorkPool(uint32_t inboxDepth = 16) : inbox_(inboxDepth) {}
+
+    ~WorkPool()
+    {
+      if (workerCount_ != 0)
+      {
+        (void)end();
+      }
+      if (exited_)
+      {
+        vSemaphoreDelete(exited_);
+      }
+    }
+
+    // en: Workers and deques point back at this object, so it cannot be copied or moved
+    // ja: ワーカと deque がこのオブジェクトを参照するため、コピー・ムーブ不可
+    WorkPool(const WorkPool &) = delete;
+    WorkPool &operator=(const WorkPool &) = delete;
+    WorkPool(WorkPool &&) = delete;
+    WorkPool &operator=(WorkPool &&) = delete;
+
+    // en: Start one worker pinned to each core (task context)
+    // ja: 各コアに固定したワーカを1つずつ起動する（タスク文脈）
+    bool begin(const WorkPoolConfig &config = WorkPoolConfig())
+    {
+      if (xPortInIsrContext())
+      {
+        this->logError("[WorkPool] begin called in ISR");
+        return false;
+      }
+      if (workerCount_ != 0)
+      {
+        this->logWarn("[WorkPool] begin failed: already started");
+        return false;
+      }
+      if (!inbox_.begin())
+      {
+        this->logError("[WorkPool] begin failed: inbox create");
+        return false;
+      }
+      if (!exited_)
+      {
+        exited_ = xSemaphoreCreateCountingStatic(kWorkers, 0, &exitedBuffer_);
+      }
+
+      for (uint8_t i = 0; i < kWorkers; ++i)
+      {
+        char name[configMAX_TASK_NAME_LEN];
+        snprintf(name, sizeof(name), "%s%u", config.name ? config.name : "pool", i);
+        startArgs_[i] = StartArgs{this, i};
+        if (xTaskCreatePinnedToCore(&WorkPool::workerMain, name, config.stackSize, &startArgs_[i], config.priority, &workers_[i], i) != pdPASS)
+        {
+          workers_[i] = nullptr;
+          this->logError("[WorkPool] begin failed: worker %ld create", static_cast<long>(i));
+          (void)end();
+          return false;
+        }
+        ++workerCount_;
+      }
+      return true;
+    }
+
+    // en: Stop the workers once every submitted job has run. Task only, not from a job.
+    // ja: 投入済みのジョブをすべて実行してからワーカを止める。タスク専用、ジョブからは不可
+    bool end(uint32_t timeoutMs = WaitForever)
+    {
+      if (xPortInIsrContext())
+      {
+        this->logError("[WorkPool] end called in ISR");
+        return false;
+      }
+      if (currentWorker() >= 0)
+      {
+        this->logError("[WorkPool] end called from a worker");
+        return false;
+      }
+
+      const Deadline deadline = Deadline::after(timeoutMs);
+      const Job stop{};
+      while (stopsSent_ < workerCount_)
+      {
+        if (!inbox_.send(stop, deadline))
+        {
+          this->logTimeout("[WorkPool] end timeout");
+          return false;
+        }
+        ++stopsSent_;
+        wakeIdle(false);
+      }
+      while (workerCount_ != 0)
+      {
+        const uint32_t ms = deadline.timeoutMs();
+        TickType_t ticks = (ms == WaitForever) ? portMAX_DELAY : pdMS_TO_TICKS(ms);
+        if (xSemaphoreTake(exited_, ticks) != pdPASS)
+        {
+          this->logTimeout("[WorkPool] end timeout");
+          return false;
+        }
+        --workerCount_;
+        --stopsSent_;
+      }
+      for (TaskHandle_t &worker : workers_)
+      {
+        worker = nullptr;
+      }
+      return true;
+    }
+
+    // en: Run fn() on a worker. From a task: queued in the inbox (blocks while full). From a job: pushed on
+    // en: the current worker's deque, or run inline if it is full. fn must fit in InlineSize and be trivially copyable.
+    // ja: fn() をワーカで実行する。タスクから: 受付キューに積む（満杯ならブロック）。ジョブから: 現在のワーカの
+    // ja: deque に push し、満杯ならその場で実行する。fn は InlineSize に収まりトリビアルコピー可能であること
+    template <class F>
+    bool submit(F &&fn, uint32_t timeoutMs = WaitForever)
+    {
+      return enqueue(makeJob(&WorkPool::runTask<typename std::decay<F>::type>, std::forward<F>(fn), nullptr), timeoutMs);
+    }
+
+    template <class L, UBaseType_t I, class F>
+    bool submit(BasicCompletion<L, I> &done, F &&fn, uint32_t timeoutMs = WaitForever)
+    {
+      return enqueue(makeJob(&WorkPool::runTask<typename std::decay<F>::type>, std::forward<F>(fn), &done.state_), timeoutMs);
+    }
+
+    // en: Start fn(begin, end) over [first, last) in chunks of at most grain items and return at once;
+    // en: done.wait() reports completion. Each job halves its range and pushes one half for the other core to steal.
+    // ja: [first, last) を grain 件以下の断片に分けて fn(begin, end) を実行し始め、すぐに戻る。完了は done.wait() で分かる。
+    // ja: 各ジョブは範囲を半分に分け、片方を push して他方のコアが奪えるようにする
+    template <class L, UBaseType_t I, class F>
+    bool parallelFor(BasicCompletion<L, I> &done, uint32_t first, uint32_t last, uint32_t grain, F &&fn)
+    {
+      if (first >= last)
+      {
+        return true;
+      }
+      Job job = makeJob(&WorkPool::runRange<typename std::decay<F>::type>, std::forward<F>(fn), &done.state_);
+      job.lo = first;
+      job.hi = last;
+      job.grain = grain ? grain : 1;
+      return enqueue(job, WaitForever);
+    }
+
+    // en: Blocking form. Called from a job (nested), the worker keeps running pool jobs while it waits and sleeps
+    // en: once there is nothing left to steal, so the lower-priority idle task still runs.
+    // ja: ブロッキング版。ジョブから（入れ子で）呼ぶと、ワーカは待つ間もプールのジョブを実行し、奪える仕事が
+    // ja: なくなれば眠るため、優先度の低いアイドルタスクも動ける
+    template <class F>
+    bool parallelFor(uint32_t first, uint32_t last, uint32_t grain, F &&fn)
+    {
+      BasicCompletion<LogPolicy, NotifyIndex> done;
+      const int self = currentWorker();
+      if (self >= 0)
+      {
+        // en: The worker is the one to notify when the last chunk finishes
+        // ja: 最後の断片が終わったときに通知する相手はこのワーカ
+        done.state_.owner.store(xTaskGetCurrentTaskHandle(), std::memory_order_relaxed);
+      }
+      if (!parallelFor(done, first, last, grain, std::forward<F>(fn)))
+      {
+        return false;
+      }
+      if (self < 0)
+      {
+        return done.wait();
+      }
+      helpUntilDone(done.state_, static_cast<uint8_t>(self));
+      return true;
+    }
+
+    uint8_t workers() const { return workerCount_; }
+
+    // en: Jobs queued in the inbox and in every deque (snapshot)
+    // ja: 受付キューとすべての deque に積まれたジョブ数（スナップショット）
+    uint32_t pending() const
+    {
+      uint32_t n = inbox_.count();
+      for (const Deque &deque : deques_)
+      {
+        n += deque.size();
+      }
+      return n;
+    }
+
+    WorkerStats workerStats(uint8_t worker) const
+    {
+      WorkerStats snap;
+      if (worker >= kWorkers)
+      {
+        return snap;
+      }
+      const Counters &c = counters_[worker];
+      snap.jobs = c.jobs.load(std::memory_order_relaxed);
+      snap.steals = c.steals.load(std::memory_order_relaxed);
+      snap.busyUs = c.busyUs.load(std::memory_order_relaxed);
+      return snap;
+    }
+
+    void resetStats()
+    {
+      for (Counters &c : counters_)
+      {
+        c.jobs.store(0, std::memory_order_relaxed);
+        c.steals.store(0, std::memory_order_relaxed);
+        c.busyUs.store(0, std::memory_order_relaxed);
+      }
+    }
+
+  private:
+    using Channel = detail::NotifyChannel<NotifyIndex>;
+
+    // en: invoke == nullptr is the stop request sent by end(). lo/hi/grain are used by range jobs only.
+    // ja: invoke == nullptr は end() が送る停止要求。lo/hi/grain は範囲ジョブだけが使う
+    struct Job
+    {
+      void (*invoke)(WorkPool &pool, Job &job);
+      detail::CompletionState *done;
+      uint32_t lo;
+      uint32_t hi;
+      uint32_t grain;
+      alignas(std::max_align_t) unsigned char storage[InlineSize];
+    };
+
+    // en: Bounded Chase-Lev deque. The owner pushes/takes at bottom; thieves CAS top. A thief copies the slot
+    // en: before its CAS; if the owner has since reused the slot, top has moved and the CAS discards the copy.
+    // ja: 有界の Chase-Lev deque。所有者は bottom で push/take し、盗む側は top を CAS する。盗む側は CAS の前に
+    // ja: スロットをコピーする。所有者がそのスロットを再利用していれば top が進んでいるため、CAS がコピーを捨てる
+    struct alignas(kCacheLineSize) Deque
+    {
+      static constexpr int32_t kMask = static_cast<int32_t>(DequeSize) - 1;
+
+      std::atomic<int32_t> top{0};
+      std::atomic<int32_t> bottom{0};
+      Job slots[DequeSize] = {};
+
+      bool push(const Job &job)
+      {
+        const int32_t b = bottom.load(std::memory_order_relaxed);
+        const int32_t t = top.load(std::memory_order_acquire);
+        if (b - t >= static_cast<int32_t>(DequeSize))
+        {
+          return false;
+        }
+        slots[b & kMask] = job;
+        bottom.store(b + 1, std::memory_order_release);
+        return true;
+      }
+
+      bool take(Job &out)
+      {
+        const int32_t b = bottom.load(std::memory_order_relaxed) - 1;
+        bottom.store(b, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int32_t t = top.load(std::memory_order_relaxed);
+        if (t > b)
+        {
+          bottom.store(b + 1, std::memory_order_relaxed); // en: empty / ja: 空
+          return false;
+        }
+        out = slots[b & kMask];
+        if (t == b)
+        {
+          // en: Last item: race the thieves for it
+          // ja: 最後の1件: 盗む側と取り合う
+          const bool won = top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+          bottom.store(b + 1, std::memory_order_relaxed);
+          return won;
+        }
+        return true;
+      }
+
+      bool steal(Job &out)
+      {
+        int32_t t = top.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        const int32_t b = bottom.load(std::memory_order_acquire);
+        if (t >= b)
+        {
+          return false;
+        }
+        out = slots[t & kMask];
+        return top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+      }
+
+      uint32_t size() const
+      {
+        const int32_t n = bottom.load(std::memory_order_acquire) - top.load(std::memory_order_acquire);
+        return n > 0 ? static_cast<uint32_t>(n) : 0;
+      }
+    };
+
+    struct Counters
+    {
+      std::atomic<uint32_t> jobs{0};
+      std::atomic<uint32_t> steals{0};
+      std::atomic<uint64_t> busyUs{0};
+    };
+
+    struct StartArgs
+    {
+      WorkPool *pool;
+      uint8_t index;
+    };
+
+    template <class F>
+    static Job makeJob(void (*invoke)(WorkPool &, Job &), F &&fn, detail::CompletionState *done)
+    {
+      using Fn = typename std::decay<F>::type;
+      static_assert(sizeof(Fn) <= InlineSize, "WorkPool: callable does not fit in InlineSize; capture less or raise InlineSize");
+      static_assert(alignof(Fn) <= alignof(std::max_align_t), "WorkPool: callable is over-aligned");
+      static_assert(std::is_trivially_copyable<Fn>::value && std::is_trivially_destructible<Fn>::value,
+                    "WorkPool: callable must be trivially copyable (capture values or pointers)");
+
+      Job job{};
+      job.invoke = invoke;
+      job.done = done;
+      ::new (static_cast<void *>(job.storage)) Fn(std::forward<F>(fn));
+      return job;
+    }
+
+    template <class Fn>
+    static void runTask(WorkPool &, Job &job)
+    {
+      (*reinterpret_cast<Fn *>(job.storage))();
+    }
+
+    template <class Fn>
+    static void runRange(WorkPool &pool, Job &job)
+    {
+      while (job.hi - job.lo > job.grain)
+      {
+        const uint32_t mid = job.lo + (job.hi - job.lo) / 2;
+        Job right = job;
+        right.lo = mid;
+        job.hi = mid;
+        if (right.done)
+        {
+          right.done->add();
+        }
+        pool.spawn(right);
+      }
+      (*reinterpret_cast<Fn *>(job.storage))(job.lo, job.hi);
+    }
+
+    bool enqueue(const Job &job, uint32_t timeoutMs)
+    {
+      const int self = currentWorker();
+      if (self >= 0)
+      {
+        // en: From a job: count it without taking ownership, so the task waiting on done is still the one notified
+        // ja: ジョブから: 所有者は変えずに数だけ加える。done を待つタスクが引き続き通知を受ける
+        if (job.done)
+        {
+          job.done->add();
+        }
+        spawnOn(static_cast<uint8_t>(self), job);
+        return true;
+      }
+      if (xPortInIsrContext())
+      {
+        this->logError("[WorkPool] submit called in ISR");
+        return false;
+      }
+
+      if (job.done)
+      {
+        job.done->arm();
+      }
+      if (inbox_.send(job, timeoutMs))
+      {
+        wakeIdle(false);
+        return true;
+      }
+      if (timeoutMs != 0)
+      {
+        this->logTimeout("[WorkPool] submit timeout/full");
+      }
+      if (job.done)
+      {
+        job.done->cancel();
+      }
+      return false;
+    }
+
+    // en: A split-off chunk (already counted in its Completion). On a worker it goes on that worker's deque;
+    // en: anywhere else it goes through the inbox like submit(), since only the owner may push on a deque.
+    // ja: 分割された断片（Completion には計上済み）。ワーカ上ならそのワーカの deque に積む。それ以外では
+    // ja: deque に push できるのは所有者だけなので、submit() と同じく受付キューを通す
+    void spawn(const Job &job)
+    {
+      const int self = currentWorker();
+      if (self >= 0)
+      {
+        spawnOn(static_cast<uint8_t>(self), job);
+        return;
+      }
+      if (inbox_.send(job, WaitForever))
+      {
+        wakeIdle(false);
+        return;
+      }
+      this->logError("[WorkPool] spawn failed: inbox");
+      if (job.done)
+      {
+        job.done->finish();
+      }
+    }
+
+    void spawnOn(uint8_t self, const Job &job)
+    {
+      if (deques_[self].push(job))
+      {
+        wakeIdle(true);
+        return;
+      }
+      Job local = job; // en: deque full: run it here / ja: deque が満杯: ここで実行する
+      execute(local, self);
+    }
+
+    void execute(Job &job, uint8_t self)
+    {
+      detail::CompletionState *done = job.done;
+      const int64_t start = esp_timer_get_time();
+      job.invoke(*this, job);
+      Counters &c = counters_[self];
+      c.busyUs.fetch_add(static_cast<uint64_t>(esp_timer_get_time() - start), std::memory_order_relaxed);
+      c.jobs.fetch_add(1, std::memory_order_relaxed);
+      if (done)
+      {
+        done->finish();
+      }
+    }
+
+    bool findWork(uint8_t self, Job &job)
+    {
+      if (deques_[self].take(job))
+      {
+        return true;
+      }
+      for (uint8_t k = 1; k < kWorkers; ++k)
+      {
+        const uint8_t victim = static_cast<uint8_t>((self + k) % kWorkers);
+        if (deques_[victim].steal(job))
+        {
+          counters_[self].steals.fetch_add(1, std::memory_order_relaxed);
+          return true;
+        }
+      }
+      return false;
+    }
+
+    bool hasStealable() const
+    {
+      for (const Deque &deque : deques_)
+      {
+        if (deque.size() != 0)
+        {
+          return true;
+        }
+      }
+      return false;
+    }
+
+    bool hasWork() const { return hasStealable() || inbox_.count() != 0; }
+
+    // en: Nested blocking parallelFor(): run deque jobs until the range is done; after kHelpSpins fruitless yields,
+    // en: sleep on the worker's slot. Two wakers share that slot: the last finish() of the range (when the sleeping
+    // en: bit was set) and wakeIdle() for new deque work (when it claimed our helper bit). Each give that was claimed
+    // en: is consumed before going on, so the slot stays clean for the idle loop. The inbox is left to the idle
+    // en: workers: inbox wake-ups never pick a helper, so none is lost on a worker that cannot take it.
+    // ja: 入れ子のブロッキング版 parallelFor(): 範囲が終わるまで deque のジョブを実行し、kHelpSpins 回譲っても
+    // ja: 仕事がなければワーカのスロットで眠る。そのスロットを起こすのは2者: 範囲の最後の finish()（睡眠ビットが
+    // ja: 立っていたとき）と、deque の新しい仕事に対する wakeIdle()（ヘルパービットを確保したとき）。確保された
+    // ja: give は先へ進む前にすべて受け取るため、アイドルループのスロットには何も残らない。受付キューはアイドルの
+    // ja: ワーカに任せる: 受付キューによる起床はヘルパーを選ばないため、受け取れないワーカで失われることはない
+    void helpUntilDone(detail::CompletionState &state, uint8_t self)
+    {
+      const uint32_t bit = 1u << self;
+      uint32_t spins = 0;
+      Job job;
+      while (state.count() != 0)
+      {
+        if (findWork(self, job))
+        {
+          execute(job, self);
+          spins = 0;
+          continue;
+        }
+        if (++spins < kHelpSpins)
+        {
+          taskYIELD();
+          continue;
+        }
+        spins = 0;
+
+        helperMask_.fetch_or(bit, std::memory_order_relaxed);
+        const bool sleeping = state.prepareSleep();
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        uint32_t taken = (sleeping && !hasStealable()) ? Channel::wait(portMAX_DELAY) : 0;
+        uint32_t owed = 0;
+        if ((helperMask_.fetch_and(~bit, std::memory_order_acq_rel) & bit) == 0)
+        {
+          ++owed; // en: wakeIdle() claimed us / ja: wakeIdle() が確保した
+        }
+        if (sleeping && state.endSleep())
+        {
+          ++owed; // en: the last finish() notified us / ja: 最後の finish() が通知した
+        }
+        while (taken < owed)
+        {
+          taken += Channel::wait(portMAX_DELAY); // en: a claimed give still on its way / ja: 確保済みの give が届くのを待つ
+        }
+      }
+    }
+
+    int currentWorker() const
+    {
+      const TaskHandle_t self = xTaskGetCurrentTaskHandle();
+      for (uint8_t i = 0; i < kWorkers; ++i)
+      {
+        if (workers_[i] == self)
+        {
+          return i;
+        }
+      }
+      return -1;
+    }
+
+    static void workerMain(void *pv)
+    {
+      StartArgs *args = static_cast<StartArgs *>(pv);
+      args->pool->run(args->index);
+      vTaskDelete(nullptr);
+    }
+
+    void run(uint8_t self)
+    {
+      const uint32_t bit = 1u << self;
+      Job job;
+      while (true)
+      {
+        if (findWork(self, job) || inbox_.tryReceive(job))
+        {
+          if (!job.invoke)
+          {
+            break;
+          }
+          execute(job, self);
+          continue;
+        }
+
+        // en: Same waiter protocol as MpscQueue: publish idle, re-check, sleep on the task notification
+        // ja: MpscQueue と同じ待機手順: アイドルを公開し、再確認してからタスク通知で眠る
+        idleMask_.fetch_or(bit, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        const uint32_t taken = hasWork() ? 0 : Channel::wait(portMAX_DELAY);
+        if ((idleMask_.fetch_and(~bit, std::memory_order_acq_rel) & bit) == 0 && taken == 0)
+        {
+          Channel::absorb(); // en: wakeIdle() claimed us after the re-check / ja: 再確認の後に wakeIdle() が確保した
+        }
+      }
+      (void)xSemaphoreGive(exited_);
+    }
+
+    // en: After new work is visible: wake one idle worker, if any, or for stealable deque work also a helper
+    // en: sleeping in a nested parallelFor(). With everyone busy this is a fence and one or two loads.
+    // ja: 新しい仕事が見えるようになった後: アイドルのワーカがいれば1つ起こす。奪える deque の仕事なら、入れ子の
+    // ja: parallelFor() で眠っているヘルパーも対象にする。全員が動いていればフェンスと読み出し1〜2回
+    void wakeIdle(bool stealable)
+    {
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      if (!wakeOne(idleMask_) && stealable)
+      {
+        (void)wakeOne(helperMask_);
+      }
+    }
+
+    bool wakeOne(std::atomic<uint32_t> &waiting)
+    {
+      uint32_t mask = waiting.load(std::memory_order_relaxed);
+      while (mask != 0)
+      {
+        const uint32_t bit = mask & (~mask + 1);
+        if (waiting.fetch_and(~bit, std::memory_order_acq_rel) & bit)
+        {
+          const uint8_t index = static_cast<uint8_t>(__builtin_ctz(bit));
+          Channel::give(workers_[index], false);
+          return true;
+        }
+        mask = waiting.load(std::memory_order_relaxed);
+      }
+      return false;
+    }
+
+    // en: Yields a nested parallelFor() spends looking for work before it sleeps
+    // ja: 入れ子の parallelFor() が眠る前に仕事を探して譲る回数
+    static constexpr uint32_t kHelpSpins = 16;
+
+    Deque deques_[kWorkers];
+    Counters counters_[kWorkers];
+    Queue<Job, NoStats, LogNone> inbox_;
+    std::atomic<uint32_t> idleMask_{0};   // en: workers asleep in their idle loop / ja: アイドルループで眠っているワーカ
+    std::atomic<uint32_t> helperMask_{0}; // en: workers asleep in a nested parallelFor() / ja: 入れ子の parallelFor() で眠っているワーカ
+    TaskHandle_t workers_[kWorkers] = {};
+    StartArgs startArgs_[kWorkers] = {};
+    uint8_t workerCount_ = 0;
+    uint8_t stopsSent_ = 0;
+    SemaphoreHandle_t exited_ = nullptr;
+    StaticSemaphore_t exitedBuffer_ = {};
+  };
+
+} // namespace ESP32SyncKit